@@ -29,14 +29,19 @@ namespace {
 
             const std::string texture_path =
                     std::string(PROJECT_ROOT_DIR) + "/engine/assets/textures/";
-            const auto texture0 = resource_manager.load_texture(texture_path + "awesomeface.png");
-            const auto texture1 = resource_manager.load_texture(texture_path + "R-C.jpeg");
+            const auto texture0 = resource_manager.load_texture_async(texture_path + "awesomeface.png");
+            const auto texture1 = resource_manager.load_texture_async(texture_path + "R-C.jpeg");
 
             const Comet::MaterialConfig material_config;
             auto material = resource_manager.get_material_manager().create_material(
                 "demo_material", material_config);
-            material->set_property_texture("u_Texture0", texture0);
-            material->set_property_texture("u_Texture1", texture1);
+            // 先绑定占位纹理，解码上传完成后再替换
+            for(const auto& [name, texture]: {std::pair{"u_Texture0", texture0}, std::pair{"u_Texture1", texture1}}) {
+                material->set_property_texture(name, texture->get());
+                texture->on_ready([material, name](const std::shared_ptr<Comet::Texture>& resident) {
+                    material->set_property_texture(name, resident);
+                });
+            }
 
             const bool mesh_registered = asset_registry.register_asset(
                 DEMO_CUBE_MESH_HANDLE, std::move(cube_mesh));
@@ -46,22 +51,29 @@ namespace {
                 LOG_FATAL("Failed to register demo render assets");
             }
 
+            engine.get_renderer().precompile_pipelines();
+
             auto scene = std::make_unique<Comet::Scene>();
             Comet::Entity main_camera = scene->create_entity("Main Camera");
-            main_camera.get_component<Comet::TransformComponent>().translation.z = 3.0f;
+            main_camera.patch_component<Comet::TransformComponent>(
+                [](Comet::TransformComponent& transform) { transform.translation.z = 3.0f; });
             main_camera.add_component<Comet::CameraComponent>().primary = true;
 
             Comet::Entity first_cube = scene->create_entity("Demo Cube A");
-            auto& first_transform = first_cube.get_component<Comet::TransformComponent>();
-            first_transform.translation.x = -0.5f;
-            first_transform.rotation.x = -17.0f;
+            first_cube.patch_component<Comet::TransformComponent>(
+                [](Comet::TransformComponent& transform) {
+                    transform.translation.x = -0.5f;
+                    transform.rotation.x = -17.0f;
+                });
             first_cube.add_component<Comet::MeshRendererComponent>(
                 DEMO_CUBE_MESH_HANDLE, DEMO_CUBE_MATERIAL_HANDLE);
 
             Comet::Entity second_cube = scene->create_entity("Demo Cube B");
-            auto& second_transform = second_cube.get_component<Comet::TransformComponent>();
-            second_transform.translation.x = 0.5f;
-            second_transform.rotation.x = -17.0f;
+            second_cube.patch_component<Comet::TransformComponent>(
+                [](Comet::TransformComponent& transform) {
+                    transform.translation.x = 0.5f;
+                    transform.rotation.x = -17.0f;
+                });
             second_cube.add_component<Comet::MeshRendererComponent>(
                 DEMO_CUBE_MESH_HANDLE, DEMO_CUBE_MATERIAL_HANDLE);
 
@@ -78,11 +90,13 @@ namespace {
             for(std::size_t index = 0; index < m_cube_entity_ids.size(); ++index) {
                 if(Comet::Entity cube = scene->find_entity(m_cube_entity_ids[index])) {
                     const float direction = index == 0 ? 1.0f : -1.0f;
-                    auto& transform = cube.get_component<Comet::TransformComponent>();
-                    transform.rotate(Comet::Math::Vec3(
-                        0.0f,
-                        context.deltaTime * 100.0f * direction,
-                        0.0f));
+                    cube.patch_component<Comet::TransformComponent>(
+                        [&](Comet::TransformComponent& transform) {
+                            transform.rotate(Comet::Math::Vec3(
+                                0.0f,
+                                context.deltaTime * 100.0f * direction,
+                                0.0f));
+                        });
                 }
             }
         }
@@ -52,16 +52,21 @@ namespace {
 
         const std::string texture_path =
                 std::string(PROJECT_ROOT_DIR) + "/engine/assets/textures/";
-        const auto texture0 = resource_manager.load_texture(
+        const auto texture0 = resource_manager.load_texture_async(
             texture_path + "awesomeface.png");
-        const auto texture1 = resource_manager.load_texture(
+        const auto texture1 = resource_manager.load_texture_async(
             texture_path + "R-C.jpeg");
 
         const Comet::MaterialConfig material_config;
         auto material = resource_manager.get_material_manager().create_material(
             "editor_demo_material", material_config);
-        material->set_property_texture("u_Texture0", texture0);
-        material->set_property_texture("u_Texture1", texture1);
+        // 先绑定占位纹理，解码上传完成后再替换
+        for(const auto& [name, texture]: {std::pair{"u_Texture0", texture0}, std::pair{"u_Texture1", texture1}}) {
+            material->set_property_texture(name, texture->get());
+            texture->on_ready([material, name](const std::shared_ptr<Comet::Texture>& resident) {
+                material->set_property_texture(name, resident);
+            });
+        }
 
         const bool mesh_registered = asset_registry.register_asset(
             EDITOR_CUBE_MESH_HANDLE, std::move(cube_mesh));
@@ -70,17 +75,22 @@ namespace {
         if(!mesh_registered || !material_registered) {
             LOG_FATAL("Failed to register editor demo render assets");
         }
+
+        engine.get_renderer().precompile_pipelines();
     }
 
     std::unique_ptr<Comet::Scene> create_editor_scene() {
         auto scene = std::make_unique<Comet::Scene>();
         Comet::Entity main_camera = scene->create_entity("Main Camera");
-        main_camera.get_component<Comet::TransformComponent>().translation.z = 3.0f;
+        main_camera.patch_component<Comet::TransformComponent>(
+            [](Comet::TransformComponent& transform) { transform.translation.z = 3.0f; });
         main_camera.add_component<Comet::CameraComponent>().primary = true;
 
         Comet::Entity cube = scene->create_entity("Editor Cube");
-        auto& transform = cube.get_component<Comet::TransformComponent>();
-        transform.rotation = Comet::Math::Vec3(-20.0f, 30.0f, 0.0f);
+        cube.patch_component<Comet::TransformComponent>(
+            [](Comet::TransformComponent& transform) {
+                transform.rotation = Comet::Math::Vec3(-20.0f, 30.0f, 0.0f);
+            });
         cube.add_component<Comet::MeshRendererComponent>(
             EDITOR_CUBE_MESH_HANDLE, EDITOR_CUBE_MATERIAL_HANDLE);
 
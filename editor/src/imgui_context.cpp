@@ -262,7 +262,14 @@ namespace CometEditor {
             return;
         }
 
-        unregister_viewport_textures();
+        // 旧描述符集可能仍被在途帧使用，交给删除队列在帧完成后释放
+        auto& deletion_queue = m_render_context.get_device().get_deletion_queue();
+        for(VkDescriptorSet texture_id: m_viewport_texture_ids) {
+            if(texture_id != VK_NULL_HANDLE) {
+                deletion_queue.push([texture_id] { ImGui_ImplVulkan_RemoveTexture(texture_id); });
+            }
+        }
+        m_viewport_texture_ids.clear();
         m_viewport_image_views = std::move(image_views);
         m_viewport_sampler = std::move(sampler);
         register_viewport_textures();
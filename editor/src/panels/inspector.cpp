@@ -37,13 +37,14 @@ namespace CometEditor {
             return;
         }
 
-        auto& name = entity.get_component<Comet::NameComponent>().name;
+        const std::string& name = entity.get_component<Comet::NameComponent>().name;
         std::array<char, ENTITY_NAME_CAPACITY> name_buffer{};
         std::copy_n(name.data(), std::min(name.size(), name_buffer.size() - 1), name_buffer.data());
 
         ImGui::Text("Entity ID: %llu", static_cast<unsigned long long>(entity.get_id()));
         if(ImGui::InputText("Name", name_buffer.data(), name_buffer.size())) {
-            name = name_buffer.data();
+            entity.patch_component<Comet::NameComponent>(
+                [&](Comet::NameComponent& component) { component.name = name_buffer.data(); });
         }
 
         ImGui::Separator();
@@ -59,13 +60,17 @@ namespace CometEditor {
                    component_descriptor.display_name.c_str(),
                    ImGuiTreeNodeFlags_DefaultOpen)) {
                 void* component = component_descriptor.get_component(entity);
+                bool changed = false;
                 for(const Comet::PropertyDescriptor& property:
                     component_descriptor.properties) {
                     ImGui::PushID(property.id.c_str());
-                    static_cast<void>(m_property_editor_registry.edit_property(
-                        property, property.get_value(component)));
+                    changed |= m_property_editor_registry.edit_property(
+                        property, property.get_value(component));
                     ImGui::PopID();
                 }
+                if(changed) {
+                    component_descriptor.notify_changed(entity);
+                }
             }
             ImGui::PopID();
         }
@@ -30,6 +30,8 @@ namespace Comet {
             PresentMode present_mode = PresentMode::Immediate;
             std::uint32_t swapchain_image_count = 3;
             SampleCount msaa_samples = SampleCount::Count4;
+            // Directory holding the persistent pipeline cache; empty disables it.
+            std::string pipeline_cache_dir = "cache";
 #ifdef BUILD_TYPE_DEBUG
             bool enable_validation = true;
 #else
@@ -42,11 +44,23 @@ namespace Comet {
             std::array<float, 4> clear_color = {0.2f, 0.4f, 0.1f, 1.0f};
             bool enable_vsync = false;
             float max_anisotropy = 1.0f;
+            // Per frame slot budget for transient uniform and storage blocks.
+            std::uint32_t frame_uniform_buffer_kb = 1024;
+        };
+
+        struct Threading {
+            // Threads used for world-transform updates; 0 uses every hardware thread.
+            std::uint32_t transform_threads = 0;
+            // Background threads decoding textures; 0 leaves one hardware thread for the main loop.
+            std::uint32_t texture_decode_threads = 0;
+            // Background threads compiling pipelines; 0 leaves one hardware thread for the main loop.
+            std::uint32_t pipeline_compile_threads = 1;
         };
 
         Log log;
         Window window;
         Vulkan vulkan;
         Render render;
+        Threading threading;
     };
 }
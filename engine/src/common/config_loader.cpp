@@ -200,6 +200,9 @@ namespace Comet {
                 throw config_error(
                     config_path, "render.max_anisotropy", "must be a finite number of at least 1.0");
             }
+            if(config.render.frame_uniform_buffer_kb == 0) {
+                throw config_error(config_path, "render.frame_uniform_buffer_kb", "must be greater than zero");
+            }
         }
     }
 
@@ -254,6 +257,8 @@ namespace Comet {
             resolved_path);
         config.vulkan.msaa_samples = read_sample_count(
             root, "vulkan.msaa_samples", config.vulkan.msaa_samples, resolved_path);
+        config.vulkan.pipeline_cache_dir = read_value<std::string>(
+            root, "vulkan.pipeline_cache_dir", config.vulkan.pipeline_cache_dir, "a string", resolved_path);
         config.vulkan.enable_validation = read_value<bool>(
             root, "debug.enable_validation", config.vulkan.enable_validation, "a boolean", resolved_path);
 
@@ -268,6 +273,31 @@ namespace Comet {
             root, "render.enable_vsync", config.render.enable_vsync, "a boolean", resolved_path);
         config.render.max_anisotropy = read_value<float>(
             root, "render.max_anisotropy", config.render.max_anisotropy, "a number", resolved_path);
+        config.render.frame_uniform_buffer_kb = read_value<std::uint32_t>(
+            root,
+            "render.frame_uniform_buffer_kb",
+            config.render.frame_uniform_buffer_kb,
+            "a non-negative integer",
+            resolved_path);
+
+        config.threading.transform_threads = read_value<std::uint32_t>(
+            root,
+            "threading.transform_threads",
+            config.threading.transform_threads,
+            "a non-negative integer",
+            resolved_path);
+        config.threading.texture_decode_threads = read_value<std::uint32_t>(
+            root,
+            "threading.texture_decode_threads",
+            config.threading.texture_decode_threads,
+            "a non-negative integer",
+            resolved_path);
+        config.threading.pipeline_compile_threads = read_value<std::uint32_t>(
+            root,
+            "threading.pipeline_compile_threads",
+            config.threading.pipeline_compile_threads,
+            "a non-negative integer",
+            resolved_path);
 
         validate_config(config, resolved_path);
         return config;
@@ -18,6 +18,7 @@ namespace Comet {
     thread_local std::vector<Profiler::ActiveBlock> Profiler::s_thread_stack;
     std::mutex Profiler::s_mtx;
     std::unordered_map<std::string, ProfileRecord> Profiler::s_records;
+    std::unordered_map<std::string, ProfileCounter> Profiler::s_counters;
 
     void Profiler::begin_sample(const char* label) {
         auto& stack = get_thread_stack();
@@ -41,14 +42,24 @@ namespace Comet {
         call_count++;
     }
 
+    void Profiler::record_counter(const char* label, const std::int64_t value) {
+        std::lock_guard<std::mutex> lock(s_mtx);
+        auto& [total, last, sample_count] = s_counters[label];
+        total += value;
+        last = value;
+        sample_count++;
+    }
+
     void Profiler::dump_results() {
 #ifdef BUILD_TYPE_DEBUG
         const auto logger = Logger::get_profiler_logger();
         if(!logger) return;
 
-        decltype(s_records) records; {
+        decltype(s_records) records;
+        decltype(s_counters) counters; {
             std::lock_guard<std::mutex> lock(s_mtx);
             records = s_records;
+            counters = s_counters;
         }
 
         for(const auto& [label, record]: records) {
@@ -67,12 +78,26 @@ namespace Comet {
                 average
             );
         }
+
+        for(const auto& [label, counter]: counters) {
+            const auto& [total, last, sample_count] = counter;
+            if(sample_count <= 0) continue;
+
+            logger->info(
+                "{:<30}  samples={:<6}  last={:>10}       avg={:>10.1f}",
+                label,
+                sample_count,
+                last,
+                static_cast<double>(total) / sample_count
+            );
+        }
 #endif
     }
 
     void Profiler::reset() {
         std::lock_guard<std::mutex> lock(s_mtx);
         s_records.clear();
+        s_counters.clear();
     }
 
     std::vector<Profiler::ActiveBlock>& Profiler::get_thread_stack() {
@@ -3,6 +3,7 @@
 #include "export.h"
 
 #include <chrono>
+#include <cstdint>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -14,12 +15,21 @@ namespace Comet {
         int call_count = 0;
     };
 
+    struct ProfileCounter {
+        std::int64_t total = 0;
+        std::int64_t last = 0;
+        int sample_count = 0;
+    };
+
     class COMET_API Profiler {
     public:
         static void begin_sample(const char* label);
 
         static void end_sample();
 
+        // Records one sample of a per-frame quantity such as a draw count.
+        static void record_counter(const char* label, std::int64_t value);
+
         static void dump_results();
 
         static void reset();
@@ -35,6 +45,7 @@ namespace Comet {
         static thread_local std::vector<ActiveBlock> s_thread_stack;
         static std::mutex s_mtx;
         static std::unordered_map<std::string, ProfileRecord> s_records;
+        static std::unordered_map<std::string, ProfileCounter> s_counters;
 
         static std::vector<ActiveBlock>& get_thread_stack();
     };
@@ -49,8 +60,10 @@ namespace Comet {
 
 #ifdef ENABLE_PROFILER
 #define PROFILE_SCOPE(name) Comet::ScopedSample __scope_##__LINE__(name)
+#define PROFILE_COUNTER(name, value) Comet::Profiler::record_counter(name, value)
 #define PROFILE_RESULTS() Comet::Profiler::dump_results()
 #else
 #define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_COUNTER(name, value) ((void)0)
 #define PROFILE_RESULTS() ((void)0)
 #endif
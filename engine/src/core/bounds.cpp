@@ -0,0 +1,94 @@
+#include "core/bounds.h"
+
+#include <algorithm>
+
+namespace Comet::Math {
+    namespace {
+        float plane_distance(const Vec4& plane, const Vec3& point) {
+            return plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w;
+        }
+    }
+
+    BoundingVolume compute_bounds(const std::vector<Vertex>& vertices) {
+        if(vertices.empty()) {
+            return {};
+        }
+
+        BoundingVolume bounds;
+        bounds.aabb.min = vertices.front().position;
+        bounds.aabb.max = vertices.front().position;
+        for(const Vertex& vertex: vertices) {
+            bounds.aabb.min = glm::min(bounds.aabb.min, vertex.position);
+            bounds.aabb.max = glm::max(bounds.aabb.max, vertex.position);
+        }
+
+        bounds.sphere.center = (bounds.aabb.min + bounds.aabb.max) * 0.5f;
+        for(const Vertex& vertex: vertices) {
+            bounds.sphere.radius = std::max(
+                bounds.sphere.radius, length(vertex.position - bounds.sphere.center));
+        }
+        return bounds;
+    }
+
+    Frustum make_frustum(const Mat4& view_projection) {
+        const auto row = [&](const int index) {
+            return Vec4(view_projection[0][index], view_projection[1][index],
+                        view_projection[2][index], view_projection[3][index]);
+        };
+        const Vec4 x = row(0);
+        const Vec4 y = row(1);
+        const Vec4 z = row(2);
+        const Vec4 w = row(3);
+
+        // Left, right, bottom, top, near, far. Clip-space depth runs from 0
+        // to w, so the near plane is z itself.
+        Frustum frustum{{w + x, w - x, w + y, w - y, z, w - z}};
+        for(Vec4& plane: frustum.planes) {
+            const float normal_length = length(Vec3(plane.x, plane.y, plane.z));
+            if(normal_length > 0.0f) {
+                plane /= normal_length;
+            }
+        }
+        return frustum;
+    }
+
+    bool intersects(const Frustum& frustum, const BoundingVolume& bounds, const Mat4& model) {
+        // The sphere settles most items with one dot product per plane.
+        const Vec3 sphere_center = Vec3(model * Vec4(bounds.sphere.center, 1.0f));
+        const float max_scale = std::max({
+            length(Vec3(model[0])), length(Vec3(model[1])), length(Vec3(model[2]))
+        });
+        const float radius = bounds.sphere.radius * max_scale;
+
+        bool inside_all = true;
+        for(const Vec4& plane: frustum.planes) {
+            const float distance = plane_distance(plane, sphere_center);
+            if(distance < -radius) {
+                return false;
+            }
+            inside_all = inside_all && distance >= radius;
+        }
+        if(inside_all) {
+            return true;
+        }
+
+        // Straddling spheres fall back to the tighter world-space box.
+        const Vec3 local_center = (bounds.aabb.min + bounds.aabb.max) * 0.5f;
+        const Vec3 local_extent = (bounds.aabb.max - bounds.aabb.min) * 0.5f;
+        const Vec3 box_center = Vec3(model * Vec4(local_center, 1.0f));
+        const Vec3 box_extent =
+            glm::abs(Vec3(model[0])) * local_extent.x
+            + glm::abs(Vec3(model[1])) * local_extent.y
+            + glm::abs(Vec3(model[2])) * local_extent.z;
+
+        for(const Vec4& plane: frustum.planes) {
+            const float projected_extent = std::abs(plane.x) * box_extent.x
+                                           + std::abs(plane.y) * box_extent.y
+                                           + std::abs(plane.z) * box_extent.z;
+            if(plane_distance(plane, box_center) < -projected_extent) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
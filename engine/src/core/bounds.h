@@ -0,0 +1,44 @@
+#pragma once
+
+#include "common/export.h"
+#include "core/math_utils.h"
+
+#include <array>
+#include <vector>
+
+namespace Comet::Math {
+    struct Aabb {
+        Vec3 min = Vec3(0.0f);
+        Vec3 max = Vec3(0.0f);
+    };
+
+    struct BoundingSphere {
+        Vec3 center = Vec3(0.0f);
+        float radius = 0.0f;
+    };
+
+    // Local-space bounds of a mesh. The sphere is centred on the box so a
+    // transformed sphere can be tested first and the box only when needed.
+    struct BoundingVolume {
+        Aabb aabb;
+        BoundingSphere sphere;
+    };
+
+    // Planes are stored as (normal, distance) with normals pointing inside,
+    // so a point p is inside a plane when dot(normal, p) + distance >= 0.
+    struct Frustum {
+        std::array<Vec4, 6> planes{};
+    };
+
+    [[nodiscard]] COMET_API BoundingVolume compute_bounds(const std::vector<Vertex>& vertices);
+
+    // Extracts the planes of a projection * view matrix built for a [0, 1]
+    // depth range.
+    [[nodiscard]] COMET_API Frustum make_frustum(const Mat4& view_projection);
+
+    // Conservative test of local bounds placed in the world by `model`.
+    // Returns false only when the bounds are entirely outside one plane.
+    [[nodiscard]] COMET_API bool intersects(const Frustum& frustum,
+                                            const BoundingVolume& bounds,
+                                            const Mat4& model);
+}
@@ -32,13 +32,19 @@ namespace Comet {
         m_asset_registry->clear();
         m_renderer.reset();
         m_asset_registry.reset();
+        m_scene_extractor.reset();
         m_scene.reset();
         m_window.reset();
         PROFILE_RESULTS();
     }
 
     void Engine::set_scene(std::unique_ptr<Scene> scene) {
+        m_scene_extractor.reset();
         m_scene = std::move(scene);
+        if(m_scene) {
+            m_scene->set_transform_thread_count(m_config.threading.transform_threads);
+            m_scene_extractor = std::make_unique<SceneExtractor>(*m_scene);
+        }
     }
 
     void Engine::on_update() const {
@@ -65,13 +71,13 @@ namespace Comet {
                 callback(update_context);
             }
 
-            RenderScene render_scene;
-            if(m_scene) {
-                render_scene = SceneExtractor::extract(*m_scene);
+            if(m_scene_extractor) {
+                static_cast<void>(m_scene_extractor->update());
+                m_renderer->on_render(m_scene_extractor->get_render_scene());
+            } else {
+                m_renderer->on_render(RenderScene{});
             }
 
-            m_renderer->on_render(render_scene);
-
             m_window->swap_buffers();
         }
     }
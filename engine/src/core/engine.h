@@ -13,6 +13,7 @@
 namespace Comet {
     class AssetRegistry;
     class Scene;
+    class SceneExtractor;
 
     class COMET_API Engine {
     public:
@@ -58,6 +59,7 @@ namespace Comet {
         std::unique_ptr<Window> m_window;
         std::unique_ptr<AssetRegistry> m_asset_registry;
         std::unique_ptr<Scene> m_scene;
+        std::unique_ptr<SceneExtractor> m_scene_extractor;
         std::unique_ptr<Renderer> m_renderer;
         std::vector<std::function<void(UpdateContext)>> m_update_callbacks;
     };
@@ -0,0 +1,94 @@
+#include "free_list_allocator.h"
+
+#include "common/logger.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace Comet {
+    FreeListAllocator::FreeListAllocator(const std::size_t capacity) {
+        reset(capacity);
+    }
+
+    std::optional<std::size_t> FreeListAllocator::allocate(const std::size_t size) {
+        if(size == 0) {
+            return std::nullopt;
+        }
+
+        auto best = m_free_ranges.end();
+        for(auto it = m_free_ranges.begin(); it != m_free_ranges.end(); ++it) {
+            if(it->second >= size && (best == m_free_ranges.end() || it->second < best->second)) {
+                best = it;
+                if(it->second == size) {
+                    break;
+                }
+            }
+        }
+        if(best == m_free_ranges.end()) {
+            return std::nullopt;
+        }
+
+        const std::size_t offset = best->first;
+        const std::size_t remaining = best->second - size;
+        m_free_ranges.erase(best);
+        if(remaining > 0) {
+            m_free_ranges.emplace(offset + size, remaining);
+        }
+        m_used += size;
+        return offset;
+    }
+
+    void FreeListAllocator::free(const std::size_t offset, const std::size_t size) {
+        if(size == 0 || offset > m_capacity || size > m_capacity - offset || size > m_used) {
+            LOG_ERROR("FreeListAllocator cannot free range [{}..{}) of capacity {}",
+                offset, offset + size, m_capacity);
+            return;
+        }
+
+        std::size_t begin = offset;
+        std::size_t end = offset + size;
+        auto next = m_free_ranges.lower_bound(offset);
+        if(next != m_free_ranges.end() && next->first < end) {
+            LOG_ERROR("FreeListAllocator range [{}..{}) is already free", offset, end);
+            return;
+        }
+        if(next != m_free_ranges.begin()) {
+            const auto previous = std::prev(next);
+            if(previous->first + previous->second > begin) {
+                LOG_ERROR("FreeListAllocator range [{}..{}) is already free", offset, end);
+                return;
+            }
+            if(previous->first + previous->second == begin) {
+                begin = previous->first;
+                m_free_ranges.erase(previous);
+            }
+        }
+        if(next != m_free_ranges.end() && next->first == end) {
+            end += next->second;
+            m_free_ranges.erase(next);
+        }
+        m_free_ranges.emplace(begin, end - begin);
+        m_used -= size;
+    }
+
+    void FreeListAllocator::reset(const std::size_t capacity) {
+        reset_packed(capacity, 0);
+    }
+
+    void FreeListAllocator::reset_packed(const std::size_t capacity, const std::size_t size) {
+        m_free_ranges.clear();
+        m_capacity = capacity;
+        m_used = std::min(size, capacity);
+        if(m_used < capacity) {
+            m_free_ranges.emplace(m_used, capacity - m_used);
+        }
+    }
+
+    std::size_t FreeListAllocator::get_largest_free_range() const {
+        std::size_t largest = 0;
+        for(const auto& [offset, size]: m_free_ranges) {
+            largest = std::max(largest, size);
+        }
+        return largest;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "common/export.h"
+
+#include <cstddef>
+#include <map>
+#include <optional>
+
+namespace Comet {
+    // Best-fit sub-allocator over [0, capacity) of some external storage.
+    // Free ranges are kept sorted by offset and coalesced with their
+    // neighbours on free(), so callers only track (offset, size) pairs.
+    class COMET_API FreeListAllocator {
+    public:
+        FreeListAllocator() = default;
+
+        explicit FreeListAllocator(std::size_t capacity);
+
+        // Returns the offset of the smallest free range that holds `size`,
+        // or nullopt when none does.
+        [[nodiscard]] std::optional<std::size_t> allocate(std::size_t size);
+
+        // `offset` and `size` must describe a block returned by allocate().
+        void free(std::size_t offset, std::size_t size);
+
+        // Drops every allocation and makes the whole range free again.
+        void reset(std::size_t capacity);
+
+        // Marks [0, size) allocated and the rest free, for callers that have
+        // packed their live blocks to the front.
+        void reset_packed(std::size_t capacity, std::size_t size);
+
+        [[nodiscard]] std::size_t get_capacity() const { return m_capacity; }
+        [[nodiscard]] std::size_t get_used() const { return m_used; }
+        [[nodiscard]] std::size_t get_free_range_count() const { return m_free_ranges.size(); }
+        [[nodiscard]] std::size_t get_largest_free_range() const;
+
+    private:
+        // offset -> size
+        std::map<std::size_t, std::size_t> m_free_ranges;
+        std::size_t m_capacity = 0;
+        std::size_t m_used = 0;
+    };
+}
@@ -0,0 +1,123 @@
+#include "geometry_range_allocator.h"
+
+#include "common/logger.h"
+
+namespace Comet {
+    namespace {
+        std::size_t grown(const FreeListAllocator& allocator, const std::size_t required) {
+            const std::size_t needed = allocator.get_used() + required;
+            std::size_t capacity = allocator.get_capacity();
+            while(needed > capacity - capacity / 4) {
+                capacity *= 2;
+            }
+            return capacity;
+        }
+    }
+
+    GeometryRangeAllocator::GeometryRangeAllocator(const std::size_t vertex_capacity,
+                                                   const std::size_t index_capacity)
+        : m_vertex_allocator(vertex_capacity), m_index_allocator(index_capacity) {}
+
+    std::optional<GeometryHandle> GeometryRangeAllocator::allocate(const uint32_t vertex_count,
+                                                                   const uint32_t index_count) {
+        const auto vertex_offset = m_vertex_allocator.allocate(vertex_count);
+        if(!vertex_offset) {
+            return std::nullopt;
+        }
+        const auto first_index = index_count == 0
+            ? std::optional<std::size_t>(0)
+            : m_index_allocator.allocate(index_count);
+        if(!first_index) {
+            m_vertex_allocator.free(*vertex_offset, vertex_count);
+            return std::nullopt;
+        }
+
+        uint32_t slot_index;
+        if(!m_free_slots.empty()) {
+            slot_index = m_free_slots.back();
+            m_free_slots.pop_back();
+        } else {
+            slot_index = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+        m_slots[slot_index] = Slot{
+            .range = {
+                .vertex_offset = static_cast<uint32_t>(*vertex_offset),
+                .vertex_count = vertex_count,
+                .first_index = static_cast<uint32_t>(*first_index),
+                .index_count = index_count
+            },
+            .live = true
+        };
+        ++m_allocation_count;
+        return GeometryHandle{slot_index};
+    }
+
+    void GeometryRangeAllocator::free(const GeometryHandle handle) {
+        if(!is_live(handle)) {
+            LOG_ERROR("GeometryArena cannot free invalid handle {}", handle.index);
+            return;
+        }
+
+        Slot& slot = m_slots[handle.index];
+        m_vertex_allocator.free(slot.range.vertex_offset, slot.range.vertex_count);
+        if(slot.range.index_count > 0) {
+            m_index_allocator.free(slot.range.first_index, slot.range.index_count);
+        }
+        slot = {};
+        m_free_slots.push_back(handle.index);
+        --m_allocation_count;
+    }
+
+    bool GeometryRangeAllocator::is_live(const GeometryHandle handle) const {
+        return handle.is_valid() && handle.index < m_slots.size() && m_slots[handle.index].live;
+    }
+
+    const GeometryRange& GeometryRangeAllocator::get_range(const GeometryHandle handle) const {
+        return m_slots.at(handle.index).range;
+    }
+
+    GeometryCapacity GeometryRangeAllocator::grown_capacity(const uint32_t vertex_count,
+                                                            const uint32_t index_count) const {
+        return {
+            .vertex = grown(m_vertex_allocator, vertex_count),
+            .index = grown(m_index_allocator, index_count)
+        };
+    }
+
+    void GeometryRangeAllocator::repack(const std::size_t vertex_capacity,
+                                        const std::size_t index_capacity,
+                                        const MoveCallback& move) {
+        uint32_t vertex_cursor = 0;
+        uint32_t index_cursor = 0;
+        for(auto& slot: m_slots) {
+            if(!slot.live) {
+                continue;
+            }
+            const GeometryRange from = slot.range;
+            slot.range.vertex_offset = vertex_cursor;
+            vertex_cursor += from.vertex_count;
+            if(from.index_count > 0) {
+                slot.range.first_index = index_cursor;
+                index_cursor += from.index_count;
+            }
+            if(move) {
+                move(from, slot.range);
+            }
+        }
+        m_vertex_allocator.reset_packed(vertex_capacity, vertex_cursor);
+        m_index_allocator.reset_packed(index_capacity, index_cursor);
+    }
+
+    GeometryArenaStats GeometryRangeAllocator::get_stats() const {
+        return {
+            .vertex_capacity = static_cast<uint32_t>(m_vertex_allocator.get_capacity()),
+            .vertex_used = static_cast<uint32_t>(m_vertex_allocator.get_used()),
+            .index_capacity = static_cast<uint32_t>(m_index_allocator.get_capacity()),
+            .index_used = static_cast<uint32_t>(m_index_allocator.get_used()),
+            .allocation_count = m_allocation_count,
+            .vertex_free_ranges = static_cast<uint32_t>(m_vertex_allocator.get_free_range_count()),
+            .index_free_ranges = static_cast<uint32_t>(m_index_allocator.get_free_range_count())
+        };
+    }
+}
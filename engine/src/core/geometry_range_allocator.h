@@ -0,0 +1,89 @@
+#pragma once
+
+#include "common/export.h"
+#include "core/free_list_allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace Comet {
+    // Where one mesh lives inside the arena's buffers, in elements. Indices
+    // are relative to `vertex_offset`.
+    struct GeometryRange {
+        uint32_t vertex_offset = 0;
+        uint32_t vertex_count = 0;
+        uint32_t first_index = 0;
+        uint32_t index_count = 0;
+    };
+
+    // Stable reference to an arena allocation; survives compaction.
+    struct GeometryHandle {
+        uint32_t index = std::numeric_limits<uint32_t>::max();
+
+        [[nodiscard]] bool is_valid() const { return index != std::numeric_limits<uint32_t>::max(); }
+    };
+
+    struct GeometryArenaStats {
+        uint32_t vertex_capacity = 0;
+        uint32_t vertex_used = 0;
+        uint32_t index_capacity = 0;
+        uint32_t index_used = 0;
+        uint32_t allocation_count = 0;
+        // Free-list fragments per buffer; 1 means no fragmentation.
+        uint32_t vertex_free_ranges = 0;
+        uint32_t index_free_ranges = 0;
+    };
+
+    struct GeometryCapacity {
+        std::size_t vertex = 0;
+        std::size_t index = 0;
+    };
+
+    // Range bookkeeping behind GeometryArena: a best-fit free list per buffer
+    // and a slot table mapping stable handles to their current ranges. It
+    // never touches the buffers; repack() reports every move so the owner can
+    // copy the contents.
+    class COMET_API GeometryRangeAllocator {
+    public:
+        using MoveCallback = std::function<void(const GeometryRange& from, const GeometryRange& to)>;
+
+        GeometryRangeAllocator(std::size_t vertex_capacity, std::size_t index_capacity);
+
+        // Returns nullopt when either free list cannot fit the request, or
+        // when `vertex_count` is zero.
+        [[nodiscard]] std::optional<GeometryHandle> allocate(uint32_t vertex_count, uint32_t index_count);
+
+        void free(GeometryHandle handle);
+
+        [[nodiscard]] bool is_live(GeometryHandle handle) const;
+
+        [[nodiscard]] const GeometryRange& get_range(GeometryHandle handle) const;
+
+        // Capacities that fit the live ranges plus the request while leaving
+        // a quarter of each buffer free, doubling the current ones as needed.
+        [[nodiscard]] GeometryCapacity grown_capacity(uint32_t vertex_count, uint32_t index_count) const;
+
+        // Packs the live ranges, in slot order, to the front of buffers of
+        // the given capacities, which must hold them. `move` runs once per
+        // live range before the next one is placed.
+        void repack(std::size_t vertex_capacity, std::size_t index_capacity, const MoveCallback& move);
+
+        [[nodiscard]] GeometryArenaStats get_stats() const;
+
+    private:
+        struct Slot {
+            GeometryRange range;
+            bool live = false;
+        };
+
+        FreeListAllocator m_vertex_allocator;
+        FreeListAllocator m_index_allocator;
+        std::vector<Slot> m_slots;
+        std::vector<uint32_t> m_free_slots;
+        uint32_t m_allocation_count = 0;
+    };
+}
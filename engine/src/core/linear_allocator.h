@@ -0,0 +1,56 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <optional>
+
+namespace Comet {
+    // Bump-pointer sub-allocator over the byte range [begin, end) of some
+    // external storage. Only offsets are handed out; the caller owns the
+    // memory and releases everything at once with reset().
+    class LinearAllocator {
+    public:
+        LinearAllocator() = default;
+
+        LinearAllocator(const std::size_t begin, const std::size_t end)
+            : m_begin(begin), m_end(end), m_head(begin) {}
+
+        // `alignment` must be a power of two. Returns nullopt when the
+        // aligned block does not fit in the remaining range.
+        [[nodiscard]] std::optional<std::size_t> allocate(const std::size_t size,
+                                                          const std::size_t alignment = 1) {
+            if(!std::has_single_bit(alignment)) {
+                return std::nullopt;
+            }
+            const std::size_t offset = align_up(m_head, alignment);
+            if(offset > m_end || size > m_end - offset) {
+                return std::nullopt;
+            }
+            m_head = offset + size;
+            return offset;
+        }
+
+        void reset() { m_head = m_begin; }
+
+        void reset(const std::size_t begin, const std::size_t end) {
+            m_begin = begin;
+            m_end = end;
+            m_head = begin;
+        }
+
+        [[nodiscard]] std::size_t get_begin() const { return m_begin; }
+        [[nodiscard]] std::size_t get_end() const { return m_end; }
+        [[nodiscard]] std::size_t get_used() const { return m_head - m_begin; }
+        [[nodiscard]] std::size_t get_capacity() const { return m_end - m_begin; }
+
+        [[nodiscard]] static constexpr std::size_t align_up(const std::size_t value,
+                                                            const std::size_t alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+    private:
+        std::size_t m_begin = 0;
+        std::size_t m_end = 0;
+        std::size_t m_head = 0;
+    };
+}
@@ -0,0 +1,262 @@
+#include "core/math_simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#define COMET_MATH_SIMD_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COMET_MATH_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(COMET_MATH_SIMD_AVX2) || defined(COMET_MATH_SIMD_SSE2)
+#define COMET_MATH_SIMD 1
+#endif
+
+namespace Comet::Math {
+    namespace {
+        // Rotation columns of T * Rz * Ry * Rx for one transform, from the
+        // sines and cosines of the X (a), Y (b) and Z (g) angles.
+        template<typename T, typename Ops>
+        void rotation_columns(const T sa, const T ca, const T sb, const T cb,
+                              const T sg, const T cg, T (&columns)[9]) {
+            const T sb_sa = Ops::mul(sb, sa);
+            const T sb_ca = Ops::mul(sb, ca);
+            columns[0] = Ops::mul(cg, cb);
+            columns[1] = Ops::mul(sg, cb);
+            columns[2] = Ops::neg(sb);
+            columns[3] = Ops::sub(Ops::mul(cg, sb_sa), Ops::mul(sg, ca));
+            columns[4] = Ops::add(Ops::mul(sg, sb_sa), Ops::mul(cg, ca));
+            columns[5] = Ops::mul(cb, sa);
+            columns[6] = Ops::add(Ops::mul(cg, sb_ca), Ops::mul(sg, sa));
+            columns[7] = Ops::sub(Ops::mul(sg, sb_ca), Ops::mul(cg, sa));
+            columns[8] = Ops::mul(cb, ca);
+        }
+
+#if !defined(COMET_MATH_SIMD)
+        struct ScalarOps {
+            static float add(const float a, const float b) { return a + b; }
+            static float sub(const float a, const float b) { return a - b; }
+            static float mul(const float a, const float b) { return a * b; }
+            static float neg(const float a) { return -a; }
+        };
+
+        void compose_scalar(const Vec3* translations, const Vec3* rotations_degrees,
+                            const Vec3* scales, Mat4* matrices, const std::size_t count) {
+            for(std::size_t index = 0; index < count; ++index) {
+                const Vec3 radians = rotations_degrees[index] * DEG_TO_RAD;
+                float columns[9];
+                rotation_columns<float, ScalarOps>(
+                    std::sin(radians.x), std::cos(radians.x),
+                    std::sin(radians.y), std::cos(radians.y),
+                    std::sin(radians.z), std::cos(radians.z),
+                    columns);
+
+                const Vec3 scale = scales ? scales[index] : Vec3(1.0f);
+                Mat4& matrix = matrices[index];
+                matrix[0] = Vec4(columns[0] * scale.x, columns[1] * scale.x, columns[2] * scale.x, 0.0f);
+                matrix[1] = Vec4(columns[3] * scale.y, columns[4] * scale.y, columns[5] * scale.y, 0.0f);
+                matrix[2] = Vec4(columns[6] * scale.z, columns[7] * scale.z, columns[8] * scale.z, 0.0f);
+                matrix[3] = Vec4(translations[index], 1.0f);
+            }
+        }
+
+#else
+        // Cephes-style sincos constants, valid for the angle ranges found in
+        // scene transforms.
+        constexpr float FOUR_OVER_PI = 1.27323954473516f;
+        constexpr float MINUS_DP1 = -0.78515625f;
+        constexpr float MINUS_DP2 = -2.4187564849853515625e-4f;
+        constexpr float MINUS_DP3 = -3.77489497744594108e-8f;
+        constexpr float SIN_P0 = -1.9515295891e-4f;
+        constexpr float SIN_P1 = 8.3321608736e-3f;
+        constexpr float SIN_P2 = -1.6666654611e-1f;
+        constexpr float COS_P0 = 2.443315711809948e-5f;
+        constexpr float COS_P1 = -1.388731625493765e-3f;
+        constexpr float COS_P2 = 4.166664568298827e-2f;
+
+        template<typename Ops>
+        void sincos(typename Ops::Float x, typename Ops::Float& sine, typename Ops::Float& cosine) {
+            using F = typename Ops::Float;
+            using I = typename Ops::Int;
+
+            const F sign_mask = Ops::cast_float(Ops::set1_int(static_cast<std::int32_t>(0x80000000u)));
+            F sign_sin = Ops::bit_and(x, sign_mask);
+            x = Ops::bit_andnot(sign_mask, x);
+
+            // Reduce to [-pi/4, pi/4] by the octant j, rounded up to even.
+            I octant = Ops::truncate(Ops::mul(x, Ops::set1(FOUR_OVER_PI)));
+            octant = Ops::add_int(octant, Ops::set1_int(1));
+            octant = Ops::and_int(octant, Ops::set1_int(~1));
+            const F y = Ops::to_float(octant);
+
+            const F swap_sign_sin = Ops::cast_float(
+                Ops::shift_left_29(Ops::and_int(octant, Ops::set1_int(4))));
+            const F use_sin_poly = Ops::cast_float(
+                Ops::equal_zero(Ops::and_int(octant, Ops::set1_int(2))));
+            const F sign_cos = Ops::cast_float(Ops::shift_left_29(
+                Ops::andnot_int(Ops::sub_int(octant, Ops::set1_int(2)), Ops::set1_int(4))));
+            sign_sin = Ops::bit_xor(sign_sin, swap_sign_sin);
+
+            x = Ops::add(x, Ops::mul(y, Ops::set1(MINUS_DP1)));
+            x = Ops::add(x, Ops::mul(y, Ops::set1(MINUS_DP2)));
+            x = Ops::add(x, Ops::mul(y, Ops::set1(MINUS_DP3)));
+            const F z = Ops::mul(x, x);
+
+            F cos_poly = Ops::set1(COS_P0);
+            cos_poly = Ops::add(Ops::mul(cos_poly, z), Ops::set1(COS_P1));
+            cos_poly = Ops::add(Ops::mul(cos_poly, z), Ops::set1(COS_P2));
+            cos_poly = Ops::mul(Ops::mul(cos_poly, z), z);
+            cos_poly = Ops::sub(cos_poly, Ops::mul(z, Ops::set1(0.5f)));
+            cos_poly = Ops::add(cos_poly, Ops::set1(1.0f));
+
+            F sin_poly = Ops::set1(SIN_P0);
+            sin_poly = Ops::add(Ops::mul(sin_poly, z), Ops::set1(SIN_P1));
+            sin_poly = Ops::add(Ops::mul(sin_poly, z), Ops::set1(SIN_P2));
+            sin_poly = Ops::add(Ops::mul(Ops::mul(sin_poly, z), x), x);
+
+            sine = Ops::bit_xor(Ops::select(use_sin_poly, sin_poly, cos_poly), sign_sin);
+            cosine = Ops::bit_xor(Ops::select(use_sin_poly, cos_poly, sin_poly), sign_cos);
+        }
+
+        // Composes up to Ops::WIDTH transforms. Short batches are padded by
+        // repeating the last transform so every lane runs the same code.
+        template<typename Ops>
+        void compose_lanes(const Vec3* translations, const Vec3* rotations_degrees,
+                           const Vec3* scales, Mat4* matrices, const std::size_t count) {
+            using F = typename Ops::Float;
+            constexpr std::size_t WIDTH = Ops::WIDTH;
+
+            alignas(32) float rotation[3][WIDTH];
+            alignas(32) float scale[3][WIDTH];
+            for(std::size_t lane = 0; lane < WIDTH; ++lane) {
+                const std::size_t index = std::min(lane, count - 1);
+                const Vec3 lane_scale = scales ? scales[index] : Vec3(1.0f);
+                for(int axis = 0; axis < 3; ++axis) {
+                    rotation[axis][lane] = rotations_degrees[index][axis];
+                    scale[axis][lane] = lane_scale[axis];
+                }
+            }
+
+            const F to_radians = Ops::set1(DEG_TO_RAD);
+            F sines[3];
+            F cosines[3];
+            for(int axis = 0; axis < 3; ++axis) {
+                sincos<Ops>(Ops::mul(Ops::load(rotation[axis]), to_radians),
+                            sines[axis], cosines[axis]);
+            }
+
+            F columns[9];
+            rotation_columns<F, Ops>(sines[0], cosines[0], sines[1], cosines[1],
+                                     sines[2], cosines[2], columns);
+
+            alignas(32) float output[9][WIDTH];
+            for(int element = 0; element < 9; ++element) {
+                Ops::store(output[element],
+                           Ops::mul(columns[element], Ops::load(scale[element / 3])));
+            }
+
+            for(std::size_t lane = 0; lane < count; ++lane) {
+                Mat4& matrix = matrices[lane];
+                matrix[0] = Vec4(output[0][lane], output[1][lane], output[2][lane], 0.0f);
+                matrix[1] = Vec4(output[3][lane], output[4][lane], output[5][lane], 0.0f);
+                matrix[2] = Vec4(output[6][lane], output[7][lane], output[8][lane], 0.0f);
+                matrix[3] = Vec4(translations[lane], 1.0f);
+            }
+        }
+#endif
+
+#if defined(COMET_MATH_SIMD_AVX2)
+        struct Avx2Ops {
+            using Float = __m256;
+            using Int = __m256i;
+            static constexpr std::size_t WIDTH = 8;
+
+            static Float load(const float* values) { return _mm256_load_ps(values); }
+            static void store(float* values, const Float v) { _mm256_store_ps(values, v); }
+            static Float set1(const float value) { return _mm256_set1_ps(value); }
+            static Float add(const Float a, const Float b) { return _mm256_add_ps(a, b); }
+            static Float sub(const Float a, const Float b) { return _mm256_sub_ps(a, b); }
+            static Float mul(const Float a, const Float b) { return _mm256_mul_ps(a, b); }
+            static Float neg(const Float a) { return _mm256_sub_ps(_mm256_setzero_ps(), a); }
+            static Float bit_and(const Float a, const Float b) { return _mm256_and_ps(a, b); }
+            static Float bit_andnot(const Float a, const Float b) { return _mm256_andnot_ps(a, b); }
+            static Float bit_xor(const Float a, const Float b) { return _mm256_xor_ps(a, b); }
+            static Float select(const Float mask, const Float a, const Float b) {
+                return _mm256_blendv_ps(b, a, mask);
+            }
+            static Int truncate(const Float a) { return _mm256_cvttps_epi32(a); }
+            static Float to_float(const Int a) { return _mm256_cvtepi32_ps(a); }
+            static Float cast_float(const Int a) { return _mm256_castsi256_ps(a); }
+            static Int set1_int(const std::int32_t value) { return _mm256_set1_epi32(value); }
+            static Int add_int(const Int a, const Int b) { return _mm256_add_epi32(a, b); }
+            static Int sub_int(const Int a, const Int b) { return _mm256_sub_epi32(a, b); }
+            static Int and_int(const Int a, const Int b) { return _mm256_and_si256(a, b); }
+            static Int andnot_int(const Int a, const Int b) { return _mm256_andnot_si256(a, b); }
+            static Int shift_left_29(const Int a) { return _mm256_slli_epi32(a, 29); }
+            static Int equal_zero(const Int a) {
+                return _mm256_cmpeq_epi32(a, _mm256_setzero_si256());
+            }
+        };
+        using SimdOps = Avx2Ops;
+#elif defined(COMET_MATH_SIMD_SSE2)
+        struct Sse2Ops {
+            using Float = __m128;
+            using Int = __m128i;
+            static constexpr std::size_t WIDTH = 4;
+
+            static Float load(const float* values) { return _mm_load_ps(values); }
+            static void store(float* values, const Float v) { _mm_store_ps(values, v); }
+            static Float set1(const float value) { return _mm_set1_ps(value); }
+            static Float add(const Float a, const Float b) { return _mm_add_ps(a, b); }
+            static Float sub(const Float a, const Float b) { return _mm_sub_ps(a, b); }
+            static Float mul(const Float a, const Float b) { return _mm_mul_ps(a, b); }
+            static Float neg(const Float a) { return _mm_sub_ps(_mm_setzero_ps(), a); }
+            static Float bit_and(const Float a, const Float b) { return _mm_and_ps(a, b); }
+            static Float bit_andnot(const Float a, const Float b) { return _mm_andnot_ps(a, b); }
+            static Float bit_xor(const Float a, const Float b) { return _mm_xor_ps(a, b); }
+            static Float select(const Float mask, const Float a, const Float b) {
+                return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+            }
+            static Int truncate(const Float a) { return _mm_cvttps_epi32(a); }
+            static Float to_float(const Int a) { return _mm_cvtepi32_ps(a); }
+            static Float cast_float(const Int a) { return _mm_castsi128_ps(a); }
+            static Int set1_int(const std::int32_t value) { return _mm_set1_epi32(value); }
+            static Int add_int(const Int a, const Int b) { return _mm_add_epi32(a, b); }
+            static Int sub_int(const Int a, const Int b) { return _mm_sub_epi32(a, b); }
+            static Int and_int(const Int a, const Int b) { return _mm_and_si128(a, b); }
+            static Int andnot_int(const Int a, const Int b) { return _mm_andnot_si128(a, b); }
+            static Int shift_left_29(const Int a) { return _mm_slli_epi32(a, 29); }
+            static Int equal_zero(const Int a) { return _mm_cmpeq_epi32(a, _mm_setzero_si128()); }
+        };
+        using SimdOps = Sse2Ops;
+#endif
+    }
+
+    void compose_trs_batch(const Vec3* translations, const Vec3* rotations_degrees,
+                           const Vec3* scales, Mat4* matrices, const std::size_t count) {
+#if defined(COMET_MATH_SIMD)
+        for(std::size_t first = 0; first < count; first += SimdOps::WIDTH) {
+            compose_lanes<SimdOps>(
+                translations + first,
+                rotations_degrees + first,
+                scales ? scales + first : nullptr,
+                matrices + first,
+                std::min(SimdOps::WIDTH, count - first));
+        }
+#else
+        compose_scalar(translations, rotations_degrees, scales, matrices, count);
+#endif
+    }
+
+    std::size_t compose_trs_batch_width() {
+#if defined(COMET_MATH_SIMD)
+        return SimdOps::WIDTH;
+#else
+        return 1;
+#endif
+    }
+}
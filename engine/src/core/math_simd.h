@@ -0,0 +1,25 @@
+#pragma once
+
+#include "common/export.h"
+#include "core/math_utils.h"
+
+#include <cstddef>
+
+namespace Comet::Math {
+    // Composes `count` matrices T * Rz * Ry * Rx * S from parallel arrays,
+    // matching compose_trs to within float rounding. Rotations are Euler
+    // angles in degrees; a null `scales` composes with unit scale.
+    //
+    // The rotation is built in closed form from one sine/cosine per axis and
+    // evaluated across several transforms at once with AVX2 or SSE2 when the
+    // build enables them. Every transform goes through the same lane code,
+    // so results do not depend on how a range is split into calls.
+    COMET_API void compose_trs_batch(const Vec3* translations,
+                                     const Vec3* rotations_degrees,
+                                     const Vec3* scales,
+                                     Mat4* matrices,
+                                     std::size_t count);
+
+    // Number of transforms evaluated per vector iteration; 1 for the scalar build.
+    COMET_API std::size_t compose_trs_batch_width();
+}
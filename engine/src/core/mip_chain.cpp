@@ -0,0 +1,185 @@
+#include "core/mip_chain.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COMET_MIP_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Comet {
+    namespace {
+        constexpr std::size_t RGBA8_TEXEL_SIZE = 4;
+
+        void average_texel(const uint8_t* row0, const uint8_t* row1,
+                           const uint32_t x0, const uint32_t x1, uint8_t* destination) {
+            for(std::size_t channel = 0; channel < RGBA8_TEXEL_SIZE; ++channel) {
+                const uint32_t sum = row0[x0 * RGBA8_TEXEL_SIZE + channel] + row0[x1 * RGBA8_TEXEL_SIZE + channel]
+                    + row1[x0 * RGBA8_TEXEL_SIZE + channel] + row1[x1 * RGBA8_TEXEL_SIZE + channel];
+                destination[channel] = static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+
+        float srgb_to_linear(const float value) {
+            return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+        }
+
+        // Linear value of every 8-bit sRGB code.
+        const std::array<float, 256>& srgb_decode_table() {
+            static const std::array<float, 256> table = [] {
+                std::array<float, 256> values{};
+                for(std::size_t code = 0; code < values.size(); ++code) {
+                    values[code] = srgb_to_linear(static_cast<float>(code) / 255.0f);
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        // Linear values halfway between neighbouring sRGB codes; the number
+        // of midpoints below a value is its nearest code.
+        const std::array<float, 255>& srgb_encode_thresholds() {
+            static const std::array<float, 255> table = [] {
+                std::array<float, 255> values{};
+                for(std::size_t code = 0; code < values.size(); ++code) {
+                    values[code] = srgb_to_linear((static_cast<float>(code) + 0.5f) / 255.0f);
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        uint8_t linear_to_srgb8(const float value) {
+            const auto& thresholds = srgb_encode_thresholds();
+            return static_cast<uint8_t>(
+                std::upper_bound(thresholds.begin(), thresholds.end(), value) - thresholds.begin());
+        }
+
+        void average_srgb_texel(const uint8_t* row0, const uint8_t* row1,
+                                const uint32_t x0, const uint32_t x1, uint8_t* destination) {
+            const auto& decode = srgb_decode_table();
+            for(std::size_t channel = 0; channel < 3; ++channel) {
+                const float sum = decode[row0[x0 * RGBA8_TEXEL_SIZE + channel]] + decode[row0[x1 * RGBA8_TEXEL_SIZE + channel]]
+                    + decode[row1[x0 * RGBA8_TEXEL_SIZE + channel]] + decode[row1[x1 * RGBA8_TEXEL_SIZE + channel]];
+                destination[channel] = linear_to_srgb8(sum * 0.25f);
+            }
+            const uint32_t alpha = row0[x0 * RGBA8_TEXEL_SIZE + 3] + row0[x1 * RGBA8_TEXEL_SIZE + 3]
+                + row1[x0 * RGBA8_TEXEL_SIZE + 3] + row1[x1 * RGBA8_TEXEL_SIZE + 3];
+            destination[3] = static_cast<uint8_t>((alpha + 2) / 4);
+        }
+
+#if defined(COMET_MIP_SIMD_SSE2)
+        // Four output texels from eight source texels of two rows, with the
+        // same rounding as average_texel.
+        __m128i average_four_texels(const uint8_t* row0, const uint8_t* row1) {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i rounding = _mm_set1_epi16(2);
+            __m128i halves[2];
+            for(int half = 0; half < 2; ++half) {
+                const __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + half * 16));
+                const __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + half * 16));
+                // Columns (0, 1) and (2, 3) summed vertically as 16-bit lanes.
+                const __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+                const __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+                // Even columns plus odd columns.
+                const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(low, high), _mm_unpackhi_epi64(low, high));
+                halves[half] = _mm_srli_epi16(_mm_add_epi16(sum, rounding), 2);
+            }
+            return _mm_packus_epi16(halves[0], halves[1]);
+        }
+#endif
+    }
+
+    uint32_t compute_mip_level_count(const uint32_t width, const uint32_t height) {
+        const uint32_t largest = std::max(width, height);
+        return largest == 0 ? 0 : static_cast<uint32_t>(std::bit_width(largest));
+    }
+
+    std::vector<MipLevel> describe_mip_chain(const uint32_t width, const uint32_t height,
+                                             const uint32_t level_count,
+                                             const std::size_t bytes_per_texel,
+                                             const uint32_t block_extent) {
+        std::vector<MipLevel> levels;
+        levels.reserve(level_count);
+        uint32_t level_width = width;
+        uint32_t level_height = height;
+        std::size_t offset = 0;
+        for(uint32_t level = 0; level < level_count; ++level) {
+            const std::size_t blocks_wide = (level_width + block_extent - 1) / block_extent;
+            const std::size_t blocks_high = (level_height + block_extent - 1) / block_extent;
+            const std::size_t size = blocks_wide * blocks_high * bytes_per_texel;
+            levels.push_back({level_width, level_height, offset, size});
+            offset += size;
+            level_width = std::max(1u, level_width / 2);
+            level_height = std::max(1u, level_height / 2);
+        }
+        return levels;
+    }
+
+    void downsample_rgba8_box(const uint8_t* source, const uint32_t width, const uint32_t height,
+                              uint8_t* destination) {
+        const uint32_t target_width = std::max(1u, width / 2);
+        const uint32_t target_height = std::max(1u, height / 2);
+        const std::size_t source_pitch = static_cast<std::size_t>(width) * RGBA8_TEXEL_SIZE;
+
+        for(uint32_t y = 0; y < target_height; ++y) {
+            const uint8_t* row0 = source + static_cast<std::size_t>(std::min(2 * y, height - 1)) * source_pitch;
+            const uint8_t* row1 = source + static_cast<std::size_t>(std::min(2 * y + 1, height - 1)) * source_pitch;
+            uint8_t* target = destination + static_cast<std::size_t>(y) * target_width * RGBA8_TEXEL_SIZE;
+
+            uint32_t x = 0;
+#if defined(COMET_MIP_SIMD_SSE2)
+            if(width >= 2) {
+                for(; x + 4 <= target_width; x += 4) {
+                    const std::size_t source_offset = static_cast<std::size_t>(2 * x) * RGBA8_TEXEL_SIZE;
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(target + x * RGBA8_TEXEL_SIZE),
+                        average_four_texels(row0 + source_offset, row1 + source_offset));
+                }
+            }
+#endif
+            for(; x < target_width; ++x) {
+                average_texel(row0, row1, std::min(2 * x, width - 1), std::min(2 * x + 1, width - 1),
+                    target + x * RGBA8_TEXEL_SIZE);
+            }
+        }
+    }
+
+    void downsample_srgba8_box(const uint8_t* source, const uint32_t width, const uint32_t height,
+                               uint8_t* destination) {
+        const uint32_t target_width = std::max(1u, width / 2);
+        const uint32_t target_height = std::max(1u, height / 2);
+        const std::size_t source_pitch = static_cast<std::size_t>(width) * RGBA8_TEXEL_SIZE;
+
+        for(uint32_t y = 0; y < target_height; ++y) {
+            const uint8_t* row0 = source + static_cast<std::size_t>(std::min(2 * y, height - 1)) * source_pitch;
+            const uint8_t* row1 = source + static_cast<std::size_t>(std::min(2 * y + 1, height - 1)) * source_pitch;
+            uint8_t* target = destination + static_cast<std::size_t>(y) * target_width * RGBA8_TEXEL_SIZE;
+            for(uint32_t x = 0; x < target_width; ++x) {
+                average_srgb_texel(row0, row1, std::min(2 * x, width - 1), std::min(2 * x + 1, width - 1),
+                    target + x * RGBA8_TEXEL_SIZE);
+            }
+        }
+    }
+
+    std::vector<uint8_t> build_rgba8_mip_chain(const uint8_t* pixels, const uint32_t width,
+                                               const uint32_t height, const uint32_t level_count,
+                                               const bool srgb) {
+        const auto levels = describe_mip_chain(width, height, level_count, RGBA8_TEXEL_SIZE);
+        if(levels.empty()) {
+            return {};
+        }
+        std::vector<uint8_t> chain(levels.back().offset + levels.back().size);
+        std::memcpy(chain.data(), pixels, levels.front().size);
+        for(std::size_t level = 1; level < levels.size(); ++level) {
+            const MipLevel& previous = levels[level - 1];
+            const auto downsample = srgb ? downsample_srgba8_box : downsample_rgba8_box;
+            downsample(chain.data() + previous.offset, previous.width, previous.height,
+                chain.data() + levels[level].offset);
+        }
+        return chain;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "common/export.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Comet {
+    // Size and position of one level in a tightly packed mip chain.
+    struct MipLevel {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::size_t offset = 0;
+        std::size_t size = 0;
+    };
+
+    // Levels in a full chain down to 1x1, as Vulkan sizes them
+    // (each level is max(1, previous / 2)).
+    COMET_API uint32_t compute_mip_level_count(uint32_t width, uint32_t height);
+
+    // Layout of `level_count` levels stored back to back, largest first.
+    // For block-compressed formats `bytes_per_texel` is the size of one
+    // `block_extent` x `block_extent` block and partial blocks round up.
+    COMET_API std::vector<MipLevel> describe_mip_chain(uint32_t width, uint32_t height,
+                                                       uint32_t level_count,
+                                                       std::size_t bytes_per_texel,
+                                                       uint32_t block_extent = 1);
+
+    // 2x2 box filter of an 8-bit, four-channel image into a level of
+    // max(1, width / 2) x max(1, height / 2); the last row or column of an
+    // odd-sized image is dropped, a size-1 axis is repeated. Uses SSE2 when
+    // the build enables it.
+    COMET_API void downsample_rgba8_box(const uint8_t* source, uint32_t width, uint32_t height,
+                                        uint8_t* destination);
+
+    // downsample_rgba8_box for sRGB-encoded images: the colour channels are
+    // averaged in linear space and re-encoded, alpha is averaged as stored.
+    COMET_API void downsample_srgba8_box(const uint8_t* source, uint32_t width, uint32_t height,
+                                         uint8_t* destination);
+
+    // Builds `level_count` levels from `pixels` with downsample_rgba8_box, or
+    // downsample_srgba8_box when `srgb` is set, laid out as
+    // describe_mip_chain(width, height, level_count, 4).
+    COMET_API std::vector<uint8_t> build_rgba8_mip_chain(const uint8_t* pixels, uint32_t width,
+                                                         uint32_t height, uint32_t level_count,
+                                                         bool srgb = false);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace Comet {
+    // 64-bit FNV-1a over explicitly added fields. Values depend only on what
+    // is added, never on addresses or padding, so they are stable across
+    // runs and usable as persistent cache keys.
+    class StableHasher {
+    public:
+        StableHasher() = default;
+
+        explicit StableHasher(const std::uint64_t seed) {
+            add(seed);
+        }
+
+        StableHasher& add_bytes(const void* data, const std::size_t size) {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for(std::size_t index = 0; index < size; ++index) {
+                m_hash = (m_hash ^ bytes[index]) * PRIME;
+            }
+            return *this;
+        }
+
+        template<typename T>
+            requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+        StableHasher& add(const T value) {
+            return add_bytes(&value, sizeof(value));
+        }
+
+        // Length-prefixed so that consecutive strings cannot alias.
+        StableHasher& add(const std::string_view text) {
+            add(static_cast<std::uint64_t>(text.size()));
+            return add_bytes(text.data(), text.size());
+        }
+
+        [[nodiscard]] std::uint64_t get() const { return m_hash; }
+
+    private:
+        static constexpr std::uint64_t OFFSET_BASIS = 14695981039346656037ull;
+        static constexpr std::uint64_t PRIME = 1099511628211ull;
+
+        std::uint64_t m_hash = OFFSET_BASIS;
+    };
+}
@@ -0,0 +1,85 @@
+#include "staging_block_allocator.h"
+
+#include <algorithm>
+
+namespace Comet {
+    StagingBlockAllocator::StagingBlockAllocator(const size_t block_size,
+                                                 const uint32_t max_block_count,
+                                                 const size_t alignment)
+        : m_block_size(block_size), m_max_block_count(max_block_count), m_alignment(alignment) {
+        m_blocks.reserve(max_block_count);
+    }
+
+    std::optional<StagingBlockAllocator::Placement> StagingBlockAllocator::allocate(
+        const size_t size, const uint64_t batch_value) {
+        if(size > m_block_size) {
+            return std::nullopt;
+        }
+
+        if(!m_blocks.empty()) {
+            if(auto placement = try_block(m_current_block, size, batch_value)) {
+                ++m_stats.avoided_allocations;
+                return placement;
+            }
+        }
+
+        // recycle() rewinds blocks whose batches have completed.
+        for(size_t i = 0; i < m_blocks.size(); ++i) {
+            if(i != m_current_block && m_blocks[i].allocator.get_used() == 0) {
+                ++m_stats.avoided_allocations;
+                return try_block(i, size, batch_value);
+            }
+        }
+
+        if(m_blocks.size() >= m_max_block_count) {
+            return std::nullopt;
+        }
+        m_blocks.push_back({
+            .allocator = LinearAllocator(0, m_block_size),
+            .last_batch_value = 0
+        });
+        m_stats.block_count = m_blocks.size();
+        return try_block(m_blocks.size() - 1, size, batch_value);
+    }
+
+    void StagingBlockAllocator::add_dedicated(const size_t size, const uint64_t batch_value) {
+        ++m_stats.dedicated_allocations;
+        track_in_flight(size);
+        m_dedicated.push_back({size, batch_value});
+    }
+
+    size_t StagingBlockAllocator::recycle(const uint64_t completed_value) {
+        for(auto& block: m_blocks) {
+            if(block.last_batch_value <= completed_value && block.allocator.get_used() > 0) {
+                m_stats.in_flight_bytes -= block.allocator.get_used();
+                block.allocator.reset();
+            }
+        }
+        size_t released = 0;
+        while(!m_dedicated.empty() && m_dedicated.front().batch_value <= completed_value) {
+            m_stats.in_flight_bytes -= m_dedicated.front().size;
+            m_dedicated.pop_front();
+            ++released;
+        }
+        return released;
+    }
+
+    std::optional<StagingBlockAllocator::Placement> StagingBlockAllocator::try_block(
+        const size_t index, const size_t size, const uint64_t batch_value) {
+        Block& block = m_blocks[index];
+        const size_t used_before = block.allocator.get_used();
+        const auto offset = block.allocator.allocate(size, m_alignment);
+        if(!offset) {
+            return std::nullopt;
+        }
+        track_in_flight(block.allocator.get_used() - used_before);
+        block.last_batch_value = batch_value;
+        m_current_block = index;
+        return Placement{index, *offset};
+    }
+
+    void StagingBlockAllocator::track_in_flight(const size_t bytes) {
+        m_stats.in_flight_bytes += bytes;
+        m_stats.peak_in_flight_bytes = std::max(m_stats.peak_in_flight_bytes, m_stats.in_flight_bytes);
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "common/export.h"
+#include "core/linear_allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace Comet {
+    struct StagingPoolStats {
+        size_t block_count = 0;
+        size_t in_flight_bytes = 0;
+        size_t peak_in_flight_bytes = 0;
+        uint64_t avoided_allocations = 0;
+        uint64_t dedicated_allocations = 0;
+    };
+
+    // Bookkeeping behind StagingPool: which block a request lands in, when
+    // blocks rewind and when dedicated buffers may be released. Only offsets
+    // and timeline values are tracked; the pool owns the buffers.
+    class COMET_API StagingBlockAllocator {
+    public:
+        struct Placement {
+            size_t block = 0;
+            size_t offset = 0;
+        };
+
+        StagingBlockAllocator(size_t block_size, uint32_t max_block_count, size_t alignment);
+
+        // Places `size` bytes for the batch that will signal `batch_value`.
+        // A block index equal to the previous get_block_count() opens a new
+        // block. Returns nullopt when the request exceeds a block, or every
+        // block is in flight and no more may be opened; the caller then
+        // stages it separately and reports it through add_dedicated().
+        [[nodiscard]] std::optional<Placement> allocate(size_t size, uint64_t batch_value);
+
+        void add_dedicated(size_t size, uint64_t batch_value);
+
+        // Rewinds blocks used only by batches up to `completed_value`.
+        // Returns how many dedicated buffers, oldest first, may be released.
+        [[nodiscard]] size_t recycle(uint64_t completed_value);
+
+        [[nodiscard]] size_t get_block_size() const { return m_block_size; }
+        [[nodiscard]] size_t get_block_count() const { return m_blocks.size(); }
+        [[nodiscard]] const StagingPoolStats& get_stats() const { return m_stats; }
+
+    private:
+        struct Block {
+            LinearAllocator allocator;
+            uint64_t last_batch_value = 0;
+        };
+
+        struct Dedicated {
+            size_t size = 0;
+            uint64_t batch_value = 0;
+        };
+
+        [[nodiscard]] std::optional<Placement> try_block(size_t index, size_t size, uint64_t batch_value);
+
+        void track_in_flight(size_t bytes);
+
+        size_t m_block_size;
+        uint32_t m_max_block_count;
+        size_t m_alignment;
+        std::vector<Block> m_blocks;
+        size_t m_current_block = 0;
+        std::deque<Dedicated> m_dedicated;
+        StagingPoolStats m_stats;
+    };
+}
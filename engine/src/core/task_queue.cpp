@@ -0,0 +1,69 @@
+#include "core/task_queue.h"
+
+#include <algorithm>
+
+namespace Comet {
+    TaskQueue::TaskQueue(std::uint32_t thread_count) {
+        if(thread_count == 0) {
+            thread_count = std::max(2u, std::thread::hardware_concurrency()) - 1;
+        }
+
+        m_workers.reserve(thread_count);
+        for(std::uint32_t index = 0; index < thread_count; ++index) {
+            m_workers.emplace_back(&TaskQueue::worker_loop, this);
+        }
+    }
+
+    TaskQueue::~TaskQueue() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+            m_tasks.clear();
+        }
+        m_task_ready.notify_all();
+        for(std::thread& worker: m_workers) {
+            worker.join();
+        }
+    }
+
+    void TaskQueue::submit(Task task) {
+        {
+            std::lock_guard lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_task_ready.notify_one();
+    }
+
+    void TaskQueue::wait_idle() {
+        std::unique_lock lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_tasks.empty() && m_running == 0; });
+    }
+
+    std::size_t TaskQueue::get_pending_count() {
+        std::lock_guard lock(m_mutex);
+        return m_tasks.size() + m_running;
+    }
+
+    void TaskQueue::worker_loop() {
+        while(true) {
+            Task task;
+            {
+                std::unique_lock lock(m_mutex);
+                m_task_ready.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+                if(m_stopping) {
+                    return;
+                }
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+                ++m_running;
+            }
+
+            task();
+
+            std::lock_guard lock(m_mutex);
+            if(--m_running == 0 && m_tasks.empty()) {
+                m_idle.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "common/export.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Comet {
+    // Background worker threads running independent tasks in submission
+    // order. Unlike ThreadPool the caller does not wait: tasks report their
+    // results through whatever they capture.
+    class COMET_API TaskQueue {
+    public:
+        using Task = std::function<void()>;
+
+        // A count of zero leaves one hardware thread for the caller.
+        explicit TaskQueue(std::uint32_t thread_count);
+
+        // Finishes the running tasks and drops the ones not yet started.
+        ~TaskQueue();
+
+        TaskQueue(const TaskQueue&) = delete;
+
+        TaskQueue& operator=(const TaskQueue&) = delete;
+
+        TaskQueue(TaskQueue&&) noexcept = delete;
+
+        TaskQueue& operator=(TaskQueue&&) noexcept = delete;
+
+        [[nodiscard]] std::uint32_t thread_count() const {
+            return static_cast<std::uint32_t>(m_workers.size());
+        }
+
+        void submit(Task task);
+
+        // Blocks until every submitted task has finished.
+        void wait_idle();
+
+        // Tasks submitted but not yet finished.
+        [[nodiscard]] std::size_t get_pending_count();
+
+    private:
+        void worker_loop();
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_task_ready;
+        std::condition_variable m_idle;
+        std::deque<Task> m_tasks;
+        std::size_t m_running = 0;
+        bool m_stopping = false;
+    };
+}
@@ -0,0 +1,34 @@
+#include "core/texel_swizzle.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COMET_SWIZZLE_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Comet {
+    void swizzle_rgba8_to_bgra8(const uint8_t* source, uint8_t* destination, const std::size_t texel_count) {
+        std::size_t texel = 0;
+#if defined(COMET_SWIZZLE_SIMD_SSE2)
+        // Per 32-bit lane: keep G and A, rotate the R/B pair by 16 bits.
+        const __m128i green_alpha = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+        const __m128i red_blue = _mm_set1_epi32(0x00FF00FF);
+        for(; texel + 4 <= texel_count; texel += 4) {
+            const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + texel * 4));
+            const __m128i kept = _mm_and_si128(texels, green_alpha);
+            const __m128i swapped = _mm_and_si128(texels, red_blue);
+            const __m128i rotated = _mm_or_si128(_mm_slli_epi32(swapped, 16), _mm_srli_epi32(swapped, 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + texel * 4), _mm_or_si128(kept, rotated));
+        }
+#endif
+        for(; texel < texel_count; ++texel) {
+            uint8_t value[4];
+            std::memcpy(value, source + texel * 4, sizeof(value));
+            destination[texel * 4 + 0] = value[2];
+            destination[texel * 4 + 1] = value[1];
+            destination[texel * 4 + 2] = value[0];
+            destination[texel * 4 + 3] = value[3];
+        }
+    }
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "common/export.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Comet {
+    // Swaps the first and third channel of `texel_count` four-byte texels,
+    // turning RGBA8 into BGRA8 and back. `source` and `destination` may be
+    // the same buffer. Uses SSE2 when the build enables it.
+    COMET_API void swizzle_rgba8_to_bgra8(const uint8_t* source, uint8_t* destination,
+                                          std::size_t texel_count);
+}
@@ -0,0 +1,93 @@
+#include "core/thread_pool.h"
+
+#include <algorithm>
+
+namespace Comet {
+    ThreadPool::ThreadPool(std::uint32_t thread_count) {
+        if(thread_count == 0) {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        m_workers.reserve(thread_count - 1);
+        for(std::uint32_t index = 1; index < thread_count; ++index) {
+            m_workers.emplace_back(&ThreadPool::worker_loop, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_work_ready.notify_all();
+        for(std::thread& worker: m_workers) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::parallel_for(const std::size_t count, const std::size_t min_chunk,
+                                  const RangeTask& task) {
+        if(count == 0) {
+            return;
+        }
+        if(m_workers.empty() || count <= min_chunk) {
+            task(0, count);
+            return;
+        }
+
+        // A few chunks per thread evens out ranges that finish early.
+        const std::size_t target_chunks = static_cast<std::size_t>(thread_count()) * 4;
+        const std::size_t chunk_size = std::max(
+            std::max<std::size_t>(min_chunk, 1), (count + target_chunks - 1) / target_chunks);
+        {
+            std::lock_guard lock(m_mutex);
+            m_task = &task;
+            m_count = count;
+            m_chunk_size = chunk_size;
+            m_next_chunk.store(0, std::memory_order_relaxed);
+            m_busy_workers = static_cast<std::uint32_t>(m_workers.size());
+            ++m_generation;
+        }
+        m_work_ready.notify_all();
+
+        run_chunks();
+
+        std::unique_lock lock(m_mutex);
+        m_work_done.wait(lock, [this] { return m_busy_workers == 0; });
+        m_task = nullptr;
+    }
+
+    void ThreadPool::worker_loop() {
+        std::uint64_t seen_generation = 0;
+        while(true) {
+            {
+                std::unique_lock lock(m_mutex);
+                m_work_ready.wait(lock, [&] {
+                    return m_stopping || m_generation != seen_generation;
+                });
+                if(m_stopping) {
+                    return;
+                }
+                seen_generation = m_generation;
+            }
+
+            run_chunks();
+
+            std::lock_guard lock(m_mutex);
+            if(--m_busy_workers == 0) {
+                m_work_done.notify_one();
+            }
+        }
+    }
+
+    void ThreadPool::run_chunks() {
+        while(true) {
+            const std::size_t begin =
+                m_next_chunk.fetch_add(1, std::memory_order_relaxed) * m_chunk_size;
+            if(begin >= m_count) {
+                return;
+            }
+            (*m_task)(begin, std::min(begin + m_chunk_size, m_count));
+        }
+    }
+}
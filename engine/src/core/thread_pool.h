@@ -0,0 +1,61 @@
+#pragma once
+
+#include "common/export.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Comet {
+    // Fixed set of worker threads for fork/join loops. The calling thread
+    // takes part in every loop, so a pool of N threads spawns N - 1 workers.
+    class COMET_API ThreadPool {
+    public:
+        using RangeTask = std::function<void(std::size_t begin, std::size_t end)>;
+
+        // A count of zero uses every hardware thread.
+        explicit ThreadPool(std::uint32_t thread_count);
+
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ThreadPool(ThreadPool&&) noexcept = delete;
+
+        ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+
+        [[nodiscard]] std::uint32_t thread_count() const {
+            return static_cast<std::uint32_t>(m_workers.size()) + 1;
+        }
+
+        // Splits [0, count) into contiguous ranges of at least `min_chunk`
+        // items and returns once every range has run. Not re-entrant.
+        void parallel_for(std::size_t count, std::size_t min_chunk, const RangeTask& task);
+
+    private:
+        void worker_loop();
+
+        void run_chunks();
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_work_ready;
+        std::condition_variable m_work_done;
+        std::uint64_t m_generation = 0;
+        std::uint32_t m_busy_workers = 0;
+        bool m_stopping = false;
+
+        // Current loop, published under m_mutex before m_generation changes.
+        const RangeTask* m_task = nullptr;
+        std::size_t m_count = 0;
+        std::size_t m_chunk_size = 0;
+        std::atomic<std::size_t> m_next_chunk = 0;
+    };
+}
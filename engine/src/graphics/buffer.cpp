@@ -1,12 +1,11 @@
 #include "buffer.h"
 
-#include "command_context.h"
 #include "common/logger.h"
 #include "common/profiler.h"
 #include "device.h"
+#include "upload_service.h"
 
 #include <cstring>
-#include <string>
 
 namespace Comet {
     Buffer::Buffer(Device& device, const size_t size)
@@ -44,24 +43,7 @@ namespace Comet {
                          const std::string_view debug_name)
         : Buffer(device, size) {
         PROFILE_SCOPE("Buffer::Constructor");
-        if(!data) {
-            LOG_FATAL("GPUBuffer requires initial data");
-        }
-
         const std::string_view resolved_name = debug_name.empty() ? "GPU buffer" : debug_name;
-        std::string upload_name(resolved_name);
-        upload_name += " upload";
-
-        auto [buffer, allocation, mapped_data] = create_buffer(
-            Flags<BufferUsage>(BufferUsage::CopySrc),
-            {
-                .usage = AllocationUsage::Upload,
-                .persistent_mapping = true,
-                .debug_name = upload_name
-            });
-        std::memcpy(mapped_data, data, m_size);
-        get_allocator().flush_memory(allocation, 0, m_size);
-
         auto device_buffer = create_buffer(
             usage | BufferUsage::CopyDst,
             {
@@ -71,11 +53,10 @@ namespace Comet {
         m_buffer = device_buffer.buffer;
         m_allocation = std::move(device_buffer.allocation);
 
-        const auto context = m_device.create_command_context();
-        context->copy_buffer(buffer, m_buffer, m_size);
-        context->submit_and_wait();
-
-        get_allocator().destroy_buffer(buffer, allocation);
+        // 异步上传：数据先拷入暂存池，渲染提交时等待 timeline 信号
+        if(data) {
+            m_upload_ticket = m_device.get_upload_service().upload_buffer(data, m_size, *this);
+        }
     }
 
     CPUBuffer::CPUBuffer(Device& device,
@@ -172,4 +153,16 @@ namespace Comet {
         std::memcpy(destination, data, size);
         get_allocator().flush_memory(m_allocation, offset, size);
     }
+
+    void CPUBuffer::flush(const size_t offset, const size_t size) const {
+        if(size == 0) {
+            return;
+        }
+        if(offset > m_size || size > m_size - offset) {
+            LOG_ERROR("CPUBuffer flush range [{}..{}) exceeds buffer size {}",
+                offset, offset + size, m_size);
+            return;
+        }
+        get_allocator().flush_memory(m_allocation, offset, size);
+    }
 }
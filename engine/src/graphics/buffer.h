@@ -2,6 +2,7 @@
 
 #include "allocator.h"
 #include "common/export.h"
+#include "upload_ticket.h"
 #include "vk_common.h"
 
 #include <string_view>
@@ -60,6 +61,8 @@ namespace Comet {
         size_t m_size;
     };
 
+    // Device-local buffer. `data`, when given, is uploaded through the
+    // device's UploadService; otherwise the contents start undefined.
     class COMET_API GPUBuffer final: public Buffer {
     public:
         GPUBuffer(Device& device,
@@ -67,6 +70,12 @@ namespace Comet {
                   size_t size,
                   const void* data,
                   std::string_view debug_name);
+
+        // Completes once the initial contents have reached device memory.
+        [[nodiscard]] UploadTicket get_upload_ticket() const { return m_upload_ticket; }
+
+    private:
+        UploadTicket m_upload_ticket;
     };
 
     class COMET_API CPUBuffer final: public Buffer {
@@ -84,6 +93,11 @@ namespace Comet {
 
         void write(const void* data, size_t size, size_t offset = 0) const;
 
+        // For callers that fill the mapping in place and flush once.
+        [[nodiscard]] void* get_mapped_data() const { return m_mapped_data; }
+
+        void flush(size_t offset, size_t size) const;
+
     private:
         void* m_mapped_data = nullptr;
     };
@@ -51,6 +51,15 @@ namespace Comet {
         m_command_buffer.endRenderPass();
     }
 
+    void CommandBuffer::begin_rendering(const vk::RenderingInfo& rendering_info) const {
+        PROFILE_SCOPE("CommandBuffer::BeginRendering");
+        m_command_buffer.beginRendering(rendering_info);
+    }
+
+    void CommandBuffer::end_rendering() const {
+        m_command_buffer.endRendering();
+    }
+
     void CommandBuffer::bind_pipeline(const Pipeline& pipeline) const {
         m_command_buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline.get());
         LOG_TRACE("CommandBuffer: bind pipeline {}", pipeline.get_name());
@@ -140,7 +149,7 @@ namespace Comet {
 
     void CommandBuffer::transition_image_layout(const vk::Image image, const vk::ImageLayout old_layout,
         const vk::ImageLayout new_layout, const uint32_t base_array_layer, const uint32_t layer_count,
-        const uint32_t mip_level) const {
+        const uint32_t mip_level, const uint32_t level_count) const {
         vk::ImageMemoryBarrier barrier{};
         barrier.oldLayout = old_layout;
         barrier.newLayout = new_layout;
@@ -149,7 +158,7 @@ namespace Comet {
         barrier.image = image;
         barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
         barrier.subresourceRange.baseMipLevel = mip_level;
-        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.levelCount = level_count;
         barrier.subresourceRange.baseArrayLayer = base_array_layer;
         barrier.subresourceRange.layerCount = layer_count;
 
@@ -35,6 +35,11 @@ namespace Comet {
 
         void end_render_pass() const;
 
+        // dynamic rendering
+        void begin_rendering(const vk::RenderingInfo& rendering_info) const;
+
+        void end_rendering() const;
+
         // bind
         void bind_pipeline(const Pipeline& pipeline) const;
 
@@ -64,7 +69,8 @@ namespace Comet {
 
         // image layout transition
         void transition_image_layout(vk::Image image, vk::ImageLayout old_layout, vk::ImageLayout new_layout,
-                                     uint32_t base_array_layer = 0, uint32_t layer_count = 1, uint32_t mip_level = 0) const;
+                                     uint32_t base_array_layer = 0, uint32_t layer_count = 1, uint32_t mip_level = 0,
+                                     uint32_t level_count = 1) const;
 
         [[nodiscard]] vk::CommandBuffer get() const { return m_command_buffer; }
 
@@ -53,19 +53,22 @@ namespace Comet {
     }
 
     void CommandContext::transition_image_layout(const Image& image, const vk::ImageLayout old_layout, const vk::ImageLayout new_layout,
-                                                 const uint32_t base_array_layer, const uint32_t layer_count, const uint32_t mip_level) {
-        transition_image_layout(image.get(), old_layout, new_layout, base_array_layer, layer_count, mip_level);
+                                                 const uint32_t base_array_layer, const uint32_t layer_count, const uint32_t mip_level,
+                                                 const uint32_t level_count) {
+        transition_image_layout(image.get(), old_layout, new_layout, base_array_layer, layer_count, mip_level, level_count);
     }
 
     void CommandContext::transition_image_layout(const vk::Image image, const vk::ImageLayout old_layout, const vk::ImageLayout new_layout,
-                                                 const uint32_t base_array_layer, const uint32_t layer_count, const uint32_t mip_level) {
+                                                 const uint32_t base_array_layer, const uint32_t layer_count, const uint32_t mip_level,
+                                                 const uint32_t level_count) {
         if(!m_is_recording) {
             m_command_buffer.reset();
             m_command_buffer.begin(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
             m_is_recording = true;
         }
 
-        m_command_buffer.transition_image_layout(image, old_layout, new_layout, base_array_layer, layer_count, mip_level);
+        m_command_buffer.transition_image_layout(image, old_layout, new_layout, base_array_layer, layer_count, mip_level,
+            level_count);
     }
 
     void CommandContext::submit_and_wait() {
@@ -32,10 +32,12 @@ namespace Comet {
                                   uint32_t layer_count = 1, uint32_t mip_level = 0);
 
         void transition_image_layout(const Image& image, vk::ImageLayout old_layout, vk::ImageLayout new_layout,
-                                     uint32_t base_array_layer = 0, uint32_t layer_count = 1, uint32_t mip_level = 0);
+                                     uint32_t base_array_layer = 0, uint32_t layer_count = 1, uint32_t mip_level = 0,
+                                     uint32_t level_count = 1);
 
         void transition_image_layout(vk::Image image, vk::ImageLayout old_layout, vk::ImageLayout new_layout,
-                                     uint32_t base_array_layer = 0, uint32_t layer_count = 1, uint32_t mip_level = 0);
+                                     uint32_t base_array_layer = 0, uint32_t layer_count = 1, uint32_t mip_level = 0,
+                                     uint32_t level_count = 1);
 
         // 提交和同步
         void submit_and_wait(); // 立即提交并等待完成（用于资源上传）
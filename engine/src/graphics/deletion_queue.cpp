@@ -0,0 +1,56 @@
+#include "deletion_queue.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace Comet {
+    DeletionQueue::~DeletionQueue() {
+        static_cast<void>(flush());
+    }
+
+    void DeletionQueue::set_current_frame(const uint64_t frame) {
+        std::lock_guard lock(m_mutex);
+        m_current_frame = std::max(m_current_frame, frame);
+    }
+
+    void DeletionQueue::push(Deleter deleter) {
+        std::lock_guard lock(m_mutex);
+        m_entries.push_back({m_current_frame, std::move(deleter)});
+    }
+
+    std::size_t DeletionQueue::collect(const uint64_t completed_frame) {
+        // Deleters run outside the lock: destroying a resource may release others.
+        std::vector<Deleter> ready;
+        {
+            std::lock_guard lock(m_mutex);
+            while(!m_entries.empty() && m_entries.front().frame <= completed_frame) {
+                ready.push_back(std::move(m_entries.front().deleter));
+                m_entries.pop_front();
+            }
+        }
+        for(Deleter& deleter: ready) {
+            deleter();
+        }
+        return ready.size();
+    }
+
+    std::size_t DeletionQueue::flush() {
+        std::size_t count = 0;
+        // Loop in case a deleter released further resources.
+        while(const std::size_t collected = collect(std::numeric_limits<uint64_t>::max())) {
+            count += collected;
+        }
+        return count;
+    }
+
+    uint64_t DeletionQueue::get_current_frame() const {
+        std::lock_guard lock(m_mutex);
+        return m_current_frame;
+    }
+
+    std::size_t DeletionQueue::get_pending_count() const {
+        std::lock_guard lock(m_mutex);
+        return m_entries.size();
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "common/export.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace Comet {
+    // Defers destroying GPU resources until no frame in flight can still use
+    // them. FrameManager numbers frames from 1 and advances the current
+    // frame; whatever is released while frame N is recorded, or before it
+    // begins, is destroyed once frame N has completed on the GPU.
+    class COMET_API DeletionQueue {
+    public:
+        using Deleter = std::function<void()>;
+
+        DeletionQueue() = default;
+
+        // Runs the remaining deleters; the owner must have waited for the device.
+        ~DeletionQueue();
+
+        DeletionQueue(const DeletionQueue&) = delete;
+
+        DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+        DeletionQueue(DeletionQueue&&) noexcept = delete;
+
+        DeletionQueue& operator=(DeletionQueue&&) noexcept = delete;
+
+        // Frame that resources released from now on may still be used by.
+        void set_current_frame(uint64_t frame);
+
+        void push(Deleter deleter);
+
+        // Keeps `resource` alive until the current frame has completed.
+        template<typename T>
+        void retire(std::shared_ptr<T> resource) {
+            if(resource) {
+                push([resource = std::move(resource)]() mutable { resource.reset(); });
+            }
+        }
+
+        // Runs, in release order, the deleters of every frame up to and
+        // including `completed_frame`. Returns how many ran.
+        std::size_t collect(uint64_t completed_frame);
+
+        // Runs every deleter. Only safe once the device is idle.
+        std::size_t flush();
+
+        [[nodiscard]] uint64_t get_current_frame() const;
+        [[nodiscard]] std::size_t get_pending_count() const;
+
+    private:
+        struct Entry {
+            uint64_t frame;
+            Deleter deleter;
+        };
+
+        mutable std::mutex m_mutex;
+        // Ordered by frame, since the current frame only grows.
+        std::deque<Entry> m_entries;
+        uint64_t m_current_frame = 0;
+    };
+}
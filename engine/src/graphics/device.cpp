@@ -7,13 +7,17 @@
 #include "command_context.h"
 #include "common/profiler.h"
 #include "allocator.h"
+#include "upload_service.h"
+#include "core/task_queue.h"
+
+#include <algorithm>
 
 namespace Comet {
     Device::Device(Context& context)
         : Device(context, CreateInfo{}) {}
 
     Device::Device(Context& context, const CreateInfo create_info)
-        : m_context(context) {
+        : m_context(context), m_creation_time(std::chrono::steady_clock::now()) {
         PROFILE_SCOPE("Device::Constructor");
         auto [graphics_queue_family_index, graphics_queue_counts] = context.get_graphics_queue_family();
         auto [present_queue_family_index, present_queue_counts] = context.get_present_queue_family();
@@ -57,6 +61,18 @@ namespace Comet {
         const auto physical_device = context.get_physical_device();
         m_capability = context.get_device_capability();
 
+        // 独立传输队列用于资源上传；没有时上传回退到图形队列
+        const std::vector<float> transfer_queue_priorities = {0.5f};
+        const auto transfer_queue_family_index =
+                m_capability.transfer_queue_family.queue_family_index;
+        if(transfer_queue_family_index) {
+            vk::DeviceQueueCreateInfo transfer_queue_create_info = {};
+            transfer_queue_create_info.queueFamilyIndex = transfer_queue_family_index.value();
+            transfer_queue_create_info.queueCount = 1;
+            transfer_queue_create_info.pQueuePriorities = transfer_queue_priorities.data();
+            queue_create_infos.push_back(transfer_queue_create_info);
+        }
+
         vk::DeviceCreateInfo device_create_info = {};
         device_create_info.queueCreateInfoCount = queue_create_infos.size();
         device_create_info.pQueueCreateInfos = queue_create_infos.data();
@@ -64,7 +80,8 @@ namespace Comet {
         device_create_info.enabledExtensionCount = m_capability.enabled_extensions.size();
         vk::PhysicalDeviceFeatures2 enabled_features{};
         enabled_features.features = m_capability.enabled_features;
-        enabled_features.pNext = &m_capability.enabled_vulkan13_features;
+        m_capability.enabled_vulkan12_features.pNext = &m_capability.enabled_vulkan13_features;
+        enabled_features.pNext = &m_capability.enabled_vulkan12_features;
         device_create_info.pNext = &enabled_features;
         device_create_info.pEnabledFeatures = nullptr;
         m_device = physical_device.createDevice(device_create_info);
@@ -83,17 +100,31 @@ namespace Comet {
                 present_queue_family_index.value(), i, vk_queue,
                 Queue::Type::Present);
         }
+        if(transfer_queue_family_index) {
+            m_transfer_queue.emplace(
+                transfer_queue_family_index.value(), 0,
+                m_device.getQueue(transfer_queue_family_index.value(), 0),
+                Queue::Type::Transfer);
+            LOG_INFO("Using dedicated transfer queue family {}", transfer_queue_family_index.value());
+        }
 
-        create_pipeline_cache();
+        create_pipeline_cache(create_info.pipeline_cache_path);
         create_default_command_pool();
+        m_upload_service = std::make_unique<UploadService>(*this);
+        m_deletion_queue = std::make_unique<DeletionQueue>();
     }
 
     Device::~Device() {
         if(m_device) {
             m_device.waitIdle();
         }
+        m_deletion_queue.reset();
+        m_upload_service.reset();
         m_default_command_pool.reset();
+        // Lets a running background save finish before the final one.
+        m_pipeline_cache_saver.reset();
         if(m_pipeline_cache) {
+            save_pipeline_cache();
             m_device.destroyPipelineCache(m_pipeline_cache);
         }
         m_allocator.reset();
@@ -140,6 +171,13 @@ namespace Comet {
 
     void Device::wait_idle() const {
         m_device.waitIdle();
+        if(m_deletion_queue) {
+            static_cast<void>(m_deletion_queue->flush());
+        }
+    }
+
+    vk::FormatProperties Device::get_format_properties(const Format format) const {
+        return m_context.get_physical_device().getFormatProperties(Graphics::format_to_vk(format));
     }
 
     std::unique_ptr<CommandContext> Device::create_command_context() {
@@ -154,9 +192,69 @@ namespace Comet {
         return *m_allocator;
     }
 
-    void Device::create_pipeline_cache() {
-        constexpr vk::PipelineCacheCreateInfo pcache_create_info = {};
+    void Device::create_pipeline_cache(const std::string& path) {
+        const auto properties = m_context.get_physical_device().getProperties();
+        m_pipeline_cache_identity.vendor_id = properties.vendorID;
+        m_pipeline_cache_identity.device_id = properties.deviceID;
+        m_pipeline_cache_identity.driver_version = properties.driverVersion;
+        std::copy_n(properties.pipelineCacheUUID.begin(), VK_UUID_SIZE,
+            m_pipeline_cache_identity.cache_uuid.begin());
+        m_pipeline_cache_path = path;
+
+        // 从磁盘恢复上次运行的管线缓存；设备、驱动版本或 UUID 不一致时冷启动
+        std::vector<uint8_t> initial_data;
+        if(!m_pipeline_cache_path.empty()) {
+            if(const auto file = read_pipeline_cache_file(m_pipeline_cache_path)) {
+                std::string rejection;
+                if(auto blob = unpack_pipeline_cache(m_pipeline_cache_identity, *file, rejection)) {
+                    initial_data = std::move(*blob);
+                } else {
+                    LOG_WARN("Ignoring pipeline cache '{}': {}", m_pipeline_cache_path, rejection);
+                }
+            }
+        }
+
+        vk::PipelineCacheCreateInfo pcache_create_info = {};
+        pcache_create_info.initialDataSize = initial_data.size();
+        pcache_create_info.pInitialData = initial_data.empty() ? nullptr : initial_data.data();
         m_pipeline_cache = m_device.createPipelineCache(pcache_create_info);
-        LOG_INFO("Vulkan pipeline cache created successfully");
+        m_pipeline_cache_warm = !initial_data.empty();
+        m_saved_pipeline_cache_size = initial_data.size();
+        if(m_pipeline_cache_warm) {
+            LOG_INFO("Vulkan pipeline cache loaded from '{}' ({} bytes)",
+                m_pipeline_cache_path, initial_data.size());
+        } else {
+            LOG_INFO("Vulkan pipeline cache created empty");
+        }
+    }
+
+    bool Device::save_pipeline_cache() {
+        if(m_pipeline_cache_path.empty() || !m_pipeline_cache) {
+            return false;
+        }
+        const std::lock_guard lock(m_pipeline_cache_save_mutex);
+        const std::vector<uint8_t> blob = m_device.getPipelineCacheData(m_pipeline_cache);
+        // Caches only grow, so an unchanged size means nothing new to save.
+        if(blob.size() == m_saved_pipeline_cache_size) {
+            return true;
+        }
+        if(!write_pipeline_cache_file(m_pipeline_cache_path, pack_pipeline_cache(m_pipeline_cache_identity, blob))) {
+            return false;
+        }
+        m_saved_pipeline_cache_size = blob.size();
+        LOG_INFO("Saved pipeline cache to '{}' ({} bytes)", m_pipeline_cache_path, blob.size());
+        return true;
+    }
+
+    void Device::save_pipeline_cache_async() {
+        if(m_pipeline_cache_path.empty() || !m_pipeline_cache) {
+            return;
+        }
+        if(!m_pipeline_cache_saver) {
+            m_pipeline_cache_saver = std::make_unique<TaskQueue>(1);
+        }
+        if(m_pipeline_cache_saver->get_pending_count() == 0) {
+            m_pipeline_cache_saver->submit([this] { static_cast<void>(save_pipeline_cache()); });
+        }
     }
 }
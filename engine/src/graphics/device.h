@@ -3,8 +3,16 @@
 #include "common/export.h"
 #include "queue.h"
 #include "command_buffer.h"
+#include "deletion_queue.h"
+#include "pipeline_cache_file.h"
 #include "vk_capability.h"
 
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
 namespace Comet {
     class Context;
     class Queue;
@@ -13,14 +21,19 @@ namespace Comet {
     class CommandBuffer;
     class CommandContext;
     class Buffer;
+    class TaskQueue;
     class OwnedImage;
     class Allocator;
+    class UploadService;
 
     class COMET_API Device {
     public:
         struct CreateInfo {
             uint32_t graphics_queue_count = 1;
             uint32_t present_queue_count = 1;
+            // File the pipeline cache is loaded from and saved to; empty keeps
+            // it in memory only.
+            std::string pipeline_cache_path;
         };
 
         explicit Device(Context& context);
@@ -42,6 +55,7 @@ namespace Comet {
 
         void reset_fences(std::span<const Fence> fences) const;
 
+        // Also destroys everything waiting in the deletion queue.
         void wait_idle() const;
 
         [[nodiscard]] vk::Device get() const { return m_device; }
@@ -62,8 +76,41 @@ namespace Comet {
             return m_present_queues.at(index);
         }
 
+        // Queue used for resource uploads: the dedicated transfer queue when
+        // the device has one, graphics queue 0 otherwise.
+        [[nodiscard]] Queue& get_transfer_queue() {
+            return m_transfer_queue ? *m_transfer_queue : get_graphics_queue(0);
+        }
+
+        [[nodiscard]] const Queue& get_transfer_queue() const {
+            return m_transfer_queue ? *m_transfer_queue : get_graphics_queue(0);
+        }
+
+        [[nodiscard]] bool has_dedicated_transfer_queue() const { return m_transfer_queue.has_value(); }
+
+        [[nodiscard]] UploadService& get_upload_service() { return *m_upload_service; }
+
+        // Resources released while frames may still use them; see DeletionQueue.
+        [[nodiscard]] DeletionQueue& get_deletion_queue() const { return *m_deletion_queue; }
+
+        [[nodiscard]] vk::FormatProperties get_format_properties(Format format) const;
+
         [[nodiscard]] vk::PipelineCache get_pipeline_cache() const { return m_pipeline_cache; }
 
+        // True when the pipeline cache was seeded from a valid file.
+        [[nodiscard]] bool is_pipeline_cache_warm() const { return m_pipeline_cache_warm; }
+
+        // Writes the pipeline cache to its file if it grew since the last
+        // save. Returns false when persistence is disabled or the write failed.
+        bool save_pipeline_cache();
+
+        // save_pipeline_cache() on a background thread; does nothing while a
+        // previous save is still running.
+        void save_pipeline_cache_async();
+
+        // When the constructor started, the origin of startup timings.
+        [[nodiscard]] std::chrono::steady_clock::time_point get_creation_time() const { return m_creation_time; }
+
         [[nodiscard]] const DeviceCapability& get_capability() const {
             return m_capability;
         }
@@ -79,7 +126,7 @@ namespace Comet {
 
         [[nodiscard]] Allocator& get_allocator() const;
 
-        void create_pipeline_cache();
+        void create_pipeline_cache(const std::string& path);
 
         void create_default_command_pool();
 
@@ -91,8 +138,19 @@ namespace Comet {
 
         std::vector<Queue> m_graphics_queues;
         std::vector<Queue> m_present_queues;
+        std::optional<Queue> m_transfer_queue;
         DeviceCapability m_capability;
         vk::PipelineCache m_pipeline_cache;
+        std::string m_pipeline_cache_path;
+        PipelineCacheIdentity m_pipeline_cache_identity;
+        size_t m_saved_pipeline_cache_size = 0;
+        bool m_pipeline_cache_warm = false;
+        // Serialises saves from the render thread and the save worker.
+        std::mutex m_pipeline_cache_save_mutex;
+        std::unique_ptr<TaskQueue> m_pipeline_cache_saver;
+        std::chrono::steady_clock::time_point m_creation_time;
         std::unique_ptr<CommandPool> m_default_command_pool;
+        std::unique_ptr<UploadService> m_upload_service;
+        std::unique_ptr<DeletionQueue> m_deletion_queue;
     };
 }
@@ -27,6 +27,9 @@ namespace Comet {
         if(!info.usage) {
             LOG_FATAL("Image usage must not be empty");
         }
+        if(info.mip_levels == 0) {
+            LOG_FATAL("Image must have at least one mip level");
+        }
     }
 
     OwnedImage::OwnedImage(Device& device,
@@ -39,7 +42,7 @@ namespace Comet {
         create_info.imageType = vk::ImageType::e2D;
         create_info.format = Graphics::format_to_vk(m_info.format);
         create_info.extent = extent;
-        create_info.mipLevels = 1;
+        create_info.mipLevels = m_info.mip_levels;
         create_info.arrayLayers = 1;
         create_info.samples = Graphics::sample_count_to_vk(sample_count);
         create_info.tiling = vk::ImageTiling::eOptimal;
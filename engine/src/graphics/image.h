@@ -13,6 +13,7 @@ namespace Comet {
         Format format;
         Math::Vec3u extent;
         Flags<ImageUsage> usage;
+        uint32_t mip_levels = 1;
     };
 
     class COMET_API Image {
@@ -1,9 +1,11 @@
 #include "pipeline.h"
 
+#include <chrono>
 #include <utility>
 #include "device.h"
 #include "shader.h"
-#include "render_pass.h"
+#include "common/profiler.h"
+#include "core/task_queue.h"
 
 namespace Comet {
     PipelineLayout::PipelineLayout(Device& device, const ShaderLayout& layout) : m_device(device) {
@@ -92,12 +94,12 @@ namespace Comet {
         depth_stencil_state.depth_compare_op = CompareOp::Less;
     }
 
-    Pipeline::Pipeline(std::string name, Device& device, RenderPass& render_pass,
+    Pipeline::Pipeline(std::string name, Device& device, const RenderingFormats& formats,
                        const std::shared_ptr<PipelineLayout>& layout,
                        const std::shared_ptr<Shader>& vertex_shader,
                        const std::shared_ptr<Shader>& fragment_shader,
                        PipelineConfig config) : m_name(std::move(name)), m_device(device),
-                                                m_render_pass(render_pass), m_layout(layout),
+                                                m_formats(formats), m_layout(layout),
                                                 m_config(std::move(config)) {
         auto shader_stages = create_shader_stages(vertex_shader, fragment_shader);
         auto vertex_input_state = create_vertex_input_state();
@@ -109,7 +111,19 @@ namespace Comet {
         auto viewport_state = create_viewport_state();
         auto dynamic_state = create_dynamic_state();
 
+        std::vector<vk::Format> color_formats;
+        color_formats.reserve(m_formats.color_formats.size());
+        for(const Format format: m_formats.color_formats) {
+            color_formats.push_back(Graphics::format_to_vk(format));
+        }
+        vk::PipelineRenderingCreateInfo rendering_info = {};
+        rendering_info.colorAttachmentCount = static_cast<uint32_t>(color_formats.size());
+        rendering_info.pColorAttachmentFormats = color_formats.data();
+        rendering_info.depthAttachmentFormat = Graphics::format_to_vk(m_formats.depth_format);
+        rendering_info.stencilAttachmentFormat = Graphics::format_to_vk(m_formats.get_stencil_format());
+
         vk::GraphicsPipelineCreateInfo pipeline_create_info = {};
+        pipeline_create_info.pNext = &rendering_info;
         pipeline_create_info.stageCount = static_cast<uint32_t>(shader_stages.size());
         pipeline_create_info.pStages = shader_stages.data();
         pipeline_create_info.pVertexInputState = &vertex_input_state;
@@ -121,7 +135,7 @@ namespace Comet {
         pipeline_create_info.pColorBlendState = &color_blend_state;
         pipeline_create_info.pDynamicState = &dynamic_state;
         pipeline_create_info.layout = m_layout->get();
-        pipeline_create_info.renderPass = m_render_pass.get();
+        pipeline_create_info.renderPass = VK_NULL_HANDLE;
         pipeline_create_info.subpass = 0;
         pipeline_create_info.basePipelineHandle = VK_NULL_HANDLE;
         pipeline_create_info.basePipelineIndex = 0;
@@ -242,9 +256,14 @@ namespace Comet {
         m_device.get().destroyPipeline(m_pipeline);
     }
 
-    PipelineManager::PipelineManager(Device& device, RenderPass& render_pass)
-        : m_device(device), m_render_pass(render_pass) {
-        LOG_INFO("PipelineManager created");
+    PipelineManager::PipelineManager(Device& device, RenderingFormats formats, const uint32_t compile_threads)
+        : m_device(device), m_formats(std::move(formats)),
+          m_compile_queue(std::make_unique<TaskQueue>(compile_threads)) {
+        LOG_INFO("PipelineManager created with {} compile thread(s)", m_compile_queue->thread_count());
+    }
+
+    PipelineManager::~PipelineManager() {
+        m_compile_queue.reset();
     }
 
     std::shared_ptr<Pipeline> PipelineManager::create_pipeline(
@@ -260,19 +279,76 @@ namespace Comet {
             return it->second;
         }
 
-        auto pipeline_layout = std::make_shared<PipelineLayout>(m_device, layout);
+        auto pipeline = compile(name, PipelineDescription{
+            .layout = layout,
+            .vertex_input = vertex_input,
+            .config = config,
+            .vert_shader = vert_shader,
+            .frag_shader = frag_shader
+        });
+        m_pipelines[name] = pipeline;
+        return pipeline;
+    }
 
-        auto pipeline = std::make_shared<Pipeline>(
-            name, m_device, m_render_pass,
-            pipeline_layout,
-            vert_shader, frag_shader,
-            config
-        );
+    std::shared_ptr<Pipeline> PipelineManager::request_pipeline(const PipelineKey key,
+                                                                const PipelineDescription& description,
+                                                                ReadyCallback on_ready) {
+        if(auto pipeline = find_pipeline(key)) {
+            if(on_ready) {
+                on_ready(pipeline);
+            }
+            return pipeline;
+        }
 
-        m_pipelines[name] = pipeline;
+        auto [pending, inserted] = m_pending.try_emplace(key);
+        if(on_ready) {
+            pending->second.push_back(std::move(on_ready));
+        }
+        if(!inserted) {
+            return nullptr;
+        }
 
-        LOG_INFO("Pipeline '{}' created successfully", name);
-        return pipeline;
+        ++m_stats.requested;
+        m_stats.pending = static_cast<uint32_t>(m_pending.size());
+        m_compile_queue->submit([this, key, description] {
+            auto pipeline = compile("pipeline_" + std::to_string(key), description);
+            std::lock_guard lock(m_completed_mutex);
+            m_completed.emplace_back(key, std::move(pipeline));
+        });
+        return nullptr;
+    }
+
+    void PipelineManager::update() {
+        std::vector<std::pair<PipelineKey, std::shared_ptr<Pipeline>>> completed;
+        {
+            std::lock_guard lock(m_completed_mutex);
+            completed.swap(m_completed);
+        }
+
+        for(auto& [key, pipeline]: completed) {
+            const auto& published = m_cached_pipelines.emplace(key, std::move(pipeline)).first->second;
+            ++m_stats.compiled;
+
+            const auto pending = m_pending.find(key);
+            if(pending == m_pending.end()) {
+                continue;
+            }
+            const auto callbacks = std::move(pending->second);
+            m_pending.erase(pending);
+            for(const auto& callback: callbacks) {
+                callback(published);
+            }
+        }
+
+        m_stats.pending = static_cast<uint32_t>(m_pending.size());
+        m_stats.cached = static_cast<uint32_t>(m_cached_pipelines.size());
+        PROFILE_COUNTER("PipelineManager::pending_compiles", static_cast<int64_t>(m_stats.pending));
+        PROFILE_COUNTER("PipelineManager::cached_pipelines", static_cast<int64_t>(m_stats.cached));
+    }
+
+    void PipelineManager::wait_idle() {
+        m_compile_queue->wait_idle();
+        update();
     }
 
     std::shared_ptr<Pipeline> PipelineManager::get_pipeline(const std::string& name) const {
@@ -283,4 +359,33 @@ namespace Comet {
         LOG_WARN("Pipeline '{}' not found", name);
         return nullptr;
     }
+
+    std::shared_ptr<Pipeline> PipelineManager::find_pipeline(const PipelineKey key) const {
+        const auto it = m_cached_pipelines.find(key);
+        return it != m_cached_pipelines.end() ? it->second : nullptr;
+    }
+
+    std::shared_ptr<Pipeline> PipelineManager::compile(const std::string& name,
+                                                       const PipelineDescription& description) {
+        auto pipeline_layout = std::make_shared<PipelineLayout>(m_device, description.layout);
+        auto config = description.config;
+        config.set_vertex_input_state(description.vertex_input);
+
+        // 冷/热管线缓存下的编译耗时对比，反映启动时间的差异
+        const auto compile_start = std::chrono::steady_clock::now();
+        auto pipeline = std::make_shared<Pipeline>(
+            name, m_device, m_formats,
+            pipeline_layout,
+            description.vert_shader, description.frag_shader,
+            std::move(config)
+        );
+        const auto compile_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - compile_start).count();
+        PROFILE_COUNTER("PipelineManager::compile_us", static_cast<int64_t>(compile_us));
+
+        LOG_INFO("Pipeline '{}' created in {:.2f} ms ({} pipeline cache)",
+            name, static_cast<double>(compile_us) / 1000.0,
+            m_device.is_pipeline_cache_warm() ? "warm" : "cold");
+        return pipeline;
+    }
 }
@@ -1,12 +1,21 @@
 #pragma once
 #include "vk_common.h"
+#include "rendering_formats.h"
+#include "shader.h"
 #include "vertex_description.h"
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace Comet {
     class Device;
-    class Shader;
-    struct ShaderLayout;
-    class RenderPass;
+    class TaskQueue;
 
     class PipelineLayout {
     public:
@@ -123,7 +132,9 @@ namespace Comet {
 
     class Pipeline {
     public:
-        Pipeline(std::string name, Device& device, RenderPass& render_pass,
+        // Created for dynamic rendering: compatible with any pass whose
+        // attachments match `formats`, independent of their size.
+        Pipeline(std::string name, Device& device, const RenderingFormats& formats,
                  const std::shared_ptr<PipelineLayout>& layout,
                  const std::shared_ptr<Shader>& vertex_shader,
                  const std::shared_ptr<Shader>& fragment_shader,
@@ -165,15 +176,56 @@ namespace Comet {
 
         std::string m_name;
         Device& m_device;
-        RenderPass& m_render_pass;
+        RenderingFormats m_formats;
         vk::Pipeline m_pipeline;
         std::shared_ptr<PipelineLayout> m_layout;
         PipelineConfig m_config;
     };
 
+    // Everything a pipeline is compiled from, copied so that a worker thread
+    // can compile it after the caller's locals are gone.
+    struct PipelineDescription {
+        ShaderLayout layout;
+        VertexInputDescription vertex_input;
+        PipelineConfig config;
+        std::shared_ptr<Shader> vert_shader;
+        std::shared_ptr<Shader> frag_shader;
+    };
+
+    // Stable hash of everything a pipeline state object depends on, chosen by
+    // the caller. Descriptions with equal keys share one pipeline.
+    using PipelineKey = uint64_t;
+
+    struct PipelineCompileStats {
+        uint32_t requested = 0;
+        uint32_t compiled = 0;
+        uint32_t pending = 0;
+        // Distinct pipeline state objects in the keyed cache.
+        uint32_t cached = 0;
+    };
+
+    // Owns the pipelines of one set of attachment formats. create_pipeline() compiles named
+    // pipelines on the calling thread. request_pipeline() fills a cache keyed
+    // by PipelineKey: it compiles on background threads against the
+    // device's shared pipeline cache and publishes the result from update(),
+    // so pipelines only ever become visible on the render thread.
     class PipelineManager {
     public:
-        PipelineManager(Device& device, RenderPass& render_pass);
+        using ReadyCallback = std::function<void(const std::shared_ptr<Pipeline>&)>;
+
+        // A compile thread count of zero leaves one hardware thread for the caller.
+        PipelineManager(Device& device, RenderingFormats formats, uint32_t compile_threads = 1);
+
+        // Waits for compilations already running; queued ones are dropped.
+        ~PipelineManager();
+
+        PipelineManager(const PipelineManager&) = delete;
+
+        PipelineManager& operator=(const PipelineManager&) = delete;
+
+        PipelineManager(PipelineManager&&) noexcept = delete;
+
+        PipelineManager& operator=(PipelineManager&&) noexcept = delete;
 
         std::shared_ptr<Pipeline> create_pipeline(
             const std::string& name,
@@ -184,11 +236,43 @@ namespace Comet {
             const std::shared_ptr<Shader>& frag_shader
         );
 
+        // Returns the pipeline of `key` if it is already compiled, otherwise
+        // queues compiling `description` (once per key) and returns nullptr.
+        // `on_ready` runs from update() when the pipeline is published, or
+        // immediately if it already exists.
+        std::shared_ptr<Pipeline> request_pipeline(PipelineKey key,
+                                                   const PipelineDescription& description,
+                                                   ReadyCallback on_ready = {});
+
+        // Publishes finished background compilations and runs their callbacks.
+        // Call once per frame from the render thread.
+        void update();
+
+        // Blocks until every requested pipeline has been compiled and published.
+        void wait_idle();
+
         [[nodiscard]] std::shared_ptr<Pipeline> get_pipeline(const std::string& name) const;
 
+        // The published pipeline of `key`, or nullptr while it is unknown or compiling.
+        [[nodiscard]] std::shared_ptr<Pipeline> find_pipeline(PipelineKey key) const;
+
+        [[nodiscard]] bool is_pending(const PipelineKey key) const { return m_pending.contains(key); }
+        [[nodiscard]] const RenderingFormats& get_formats() const { return m_formats; }
+        [[nodiscard]] const PipelineCompileStats& get_stats() const { return m_stats; }
+
     private:
+        [[nodiscard]] std::shared_ptr<Pipeline> compile(const std::string& name,
+                                                        const PipelineDescription& description);
+
         Device& m_device;
-        RenderPass& m_render_pass;
+        RenderingFormats m_formats;
         std::unordered_map<std::string, std::shared_ptr<Pipeline>> m_pipelines;
+        std::unordered_map<PipelineKey, std::shared_ptr<Pipeline>> m_cached_pipelines;
+        // Keys being compiled in the background, with the callbacks waiting on them.
+        std::unordered_map<PipelineKey, std::vector<ReadyCallback>> m_pending;
+        std::mutex m_completed_mutex;
+        std::vector<std::pair<PipelineKey, std::shared_ptr<Pipeline>>> m_completed;
+        PipelineCompileStats m_stats;
+        std::unique_ptr<TaskQueue> m_compile_queue;
     };
 }
@@ -0,0 +1,164 @@
+#include "pipeline_cache_file.h"
+
+#include "common/logger.h"
+#include "core/stable_hash.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Comet {
+    namespace {
+        constexpr char FILE_MAGIC[4] = {'C', 'P', 'L', 'C'};
+        constexpr uint32_t FILE_VERSION = 1;
+
+        // Leading fields of every vkGetPipelineCacheData blob.
+        constexpr uint32_t VULKAN_HEADER_SIZE = 32;
+        constexpr uint32_t VULKAN_HEADER_VERSION_ONE = 1;
+
+        struct FileHeader {
+            char magic[4];
+            uint32_t version;
+            uint32_t vendor_id;
+            uint32_t device_id;
+            uint32_t driver_version;
+            uint8_t cache_uuid[16];
+            uint32_t reserved;
+            uint64_t blob_size;
+            uint64_t blob_checksum;
+        };
+
+        // Only guards against truncation and bit rot.
+        uint64_t checksum(const std::span<const uint8_t> bytes) {
+            return StableHasher().add_bytes(bytes.data(), bytes.size()).get();
+        }
+
+        uint32_t read_u32(const uint8_t* bytes) {
+            uint32_t value = 0;
+            std::memcpy(&value, bytes, sizeof(value));
+            return value;
+        }
+    }
+
+    std::vector<uint8_t> pack_pipeline_cache(const PipelineCacheIdentity& identity,
+                                             const std::span<const uint8_t> blob) {
+        FileHeader header{};
+        std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        header.version = FILE_VERSION;
+        header.vendor_id = identity.vendor_id;
+        header.device_id = identity.device_id;
+        header.driver_version = identity.driver_version;
+        std::memcpy(header.cache_uuid, identity.cache_uuid.data(), sizeof(header.cache_uuid));
+        header.blob_size = blob.size();
+        header.blob_checksum = checksum(blob);
+
+        std::vector<uint8_t> file(sizeof(header) + blob.size());
+        std::memcpy(file.data(), &header, sizeof(header));
+        if(!blob.empty()) {
+            std::memcpy(file.data() + sizeof(header), blob.data(), blob.size());
+        }
+        return file;
+    }
+
+    std::optional<std::vector<uint8_t>> unpack_pipeline_cache(const PipelineCacheIdentity& identity,
+                                                              const std::span<const uint8_t> file,
+                                                              std::string& rejection) {
+        FileHeader header{};
+        if(file.size() < sizeof(header)) {
+            rejection = "file is shorter than its header";
+            return std::nullopt;
+        }
+        std::memcpy(&header, file.data(), sizeof(header));
+        if(std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.version != FILE_VERSION) {
+            rejection = "unknown file format";
+            return std::nullopt;
+        }
+        if(header.vendor_id != identity.vendor_id || header.device_id != identity.device_id) {
+            rejection = "written for a different device";
+            return std::nullopt;
+        }
+        if(header.driver_version != identity.driver_version) {
+            rejection = "written by a different driver version";
+            return std::nullopt;
+        }
+        if(std::memcmp(header.cache_uuid, identity.cache_uuid.data(), sizeof(header.cache_uuid)) != 0) {
+            rejection = "pipeline cache UUID changed";
+            return std::nullopt;
+        }
+
+        const auto blob = file.subspan(sizeof(header));
+        if(blob.size() != header.blob_size || checksum(blob) != header.blob_checksum) {
+            rejection = "blob is truncated or corrupt";
+            return std::nullopt;
+        }
+
+        // The driver checks this too, but not every driver does it robustly.
+        if(blob.size() < VULKAN_HEADER_SIZE
+           || read_u32(blob.data()) < VULKAN_HEADER_SIZE
+           || read_u32(blob.data() + 4) != VULKAN_HEADER_VERSION_ONE
+           || read_u32(blob.data() + 8) != identity.vendor_id
+           || read_u32(blob.data() + 12) != identity.device_id
+           || std::memcmp(blob.data() + 16, identity.cache_uuid.data(), identity.cache_uuid.size()) != 0) {
+            rejection = "Vulkan pipeline cache header does not match the device";
+            return std::nullopt;
+        }
+        return std::vector<uint8_t>(blob.begin(), blob.end());
+    }
+
+    std::optional<std::vector<uint8_t>> read_pipeline_cache_file(const std::string& path) {
+        std::ifstream input(path, std::ios::binary | std::ios::ate);
+        if(!input.is_open()) {
+            return std::nullopt;
+        }
+        const std::streamsize size = input.tellg();
+        if(size < 0) {
+            return std::nullopt;
+        }
+        std::vector<uint8_t> bytes(static_cast<std::size_t>(size));
+        input.seekg(0);
+        input.read(reinterpret_cast<char*>(bytes.data()), size);
+        if(!input) {
+            LOG_WARN("Failed to read pipeline cache: {}", path);
+            return std::nullopt;
+        }
+        return bytes;
+    }
+
+    bool write_pipeline_cache_file(const std::string& path, const std::span<const uint8_t> bytes) {
+        const std::filesystem::path target(path);
+        std::error_code error;
+        if(target.has_parent_path()) {
+            std::filesystem::create_directories(target.parent_path(), error);
+            if(error) {
+                LOG_WARN("Failed to create pipeline cache directory '{}': {}",
+                    target.parent_path().string(), error.message());
+                return false;
+            }
+        }
+
+        std::filesystem::path temporary = target;
+        temporary += ".tmp";
+        {
+            std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+            if(!output.is_open()) {
+                LOG_WARN("Failed to open pipeline cache for writing: {}", temporary.string());
+                return false;
+            }
+            output.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            output.flush();
+            if(!output) {
+                LOG_WARN("Failed to write pipeline cache: {}", temporary.string());
+                std::filesystem::remove(temporary, error);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary, target, error);
+        if(error) {
+            LOG_WARN("Failed to replace pipeline cache '{}': {}", path, error.message());
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "common/export.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Comet {
+    // Identifies the driver a pipeline cache blob was produced by. A blob
+    // from any other device or driver version is discarded rather than
+    // handed to vkCreatePipelineCache.
+    struct PipelineCacheIdentity {
+        uint32_t vendor_id = 0;
+        uint32_t device_id = 0;
+        uint32_t driver_version = 0;
+        std::array<uint8_t, 16> cache_uuid{};
+
+        [[nodiscard]] bool operator==(const PipelineCacheIdentity&) const = default;
+    };
+
+    // Prefixes a vkGetPipelineCacheData blob with `identity`, its size and
+    // a checksum so truncated or foreign files can be detected on load.
+    [[nodiscard]] COMET_API std::vector<uint8_t> pack_pipeline_cache(const PipelineCacheIdentity& identity,
+                                                                     std::span<const uint8_t> blob);
+
+    // Returns the blob stored in `file` when it was written for `identity`
+    // and its Vulkan header (VK_PIPELINE_CACHE_HEADER_VERSION_ONE) agrees;
+    // otherwise nullopt with the reason in `rejection`.
+    [[nodiscard]] COMET_API std::optional<std::vector<uint8_t>> unpack_pipeline_cache(
+        const PipelineCacheIdentity& identity, std::span<const uint8_t> file, std::string& rejection);
+
+    [[nodiscard]] COMET_API std::optional<std::vector<uint8_t>> read_pipeline_cache_file(const std::string& path);
+
+    // Writes to a sibling temporary file and renames it over `path`, so a
+    // crash mid-write never leaves a partial cache behind. Creates missing
+    // parent directories.
+    COMET_API bool write_pipeline_cache_file(const std::string& path, std::span<const uint8_t> bytes);
+}
@@ -1,5 +1,6 @@
 #include "render_pass.h"
 #include "device.h"
+#include "core/stable_hash.h"
 
 #include <algorithm>
 
@@ -162,7 +163,27 @@ namespace Comet {
             dependency.dependencyFlags = vk::DependencyFlagBits::eByRegion;
             dependencies.push_back(dependency);
         }
-        // 3. create info
+        // 3. compatibility class: layouts and load/store ops do not matter
+        StableHasher compatibility;
+        const auto add_references = [&compatibility](const auto& references) {
+            compatibility.add(static_cast<uint64_t>(references.size()));
+            for(const auto& reference: references) {
+                compatibility.add(reference.index);
+            }
+        };
+        compatibility.add(static_cast<uint64_t>(m_attachments.size()));
+        for(const auto& [description, usage]: m_attachments) {
+            compatibility.add(description.format).add(description.samples);
+        }
+        compatibility.add(static_cast<uint64_t>(m_sub_passes.size()));
+        for(const auto& sub_pass: m_sub_passes) {
+            add_references(sub_pass.input_attachments);
+            add_references(sub_pass.color_attachments);
+            add_references(sub_pass.depth_stencil_attachments);
+            compatibility.add(sub_pass.sample_count > SampleCount::Count1);
+        }
+        m_compatibility_hash = compatibility.get();
+        // 4. create info
         std::vector<vk::AttachmentDescription> attachment_descriptions;
         attachment_descriptions.reserve(m_attachments.size());
         for(const auto& [description, usage]: m_attachments) {
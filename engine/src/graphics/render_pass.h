@@ -31,11 +31,15 @@ namespace Comet {
         [[nodiscard]] const std::vector<RenderSubPass>& get_sub_passes() const { return m_sub_passes; }
         [[nodiscard]] const std::vector<Attachment>& get_attachments() const { return m_attachments; }
         [[nodiscard]] uint32_t get_attachments_count() const { return static_cast<uint32_t>(m_attachments.size()); }
+        // Equal for render passes a pipeline may be used with interchangeably:
+        // same attachment formats and sample counts and same subpass references.
+        [[nodiscard]] uint64_t get_compatibility_hash() const { return m_compatibility_hash; }
 
     private:
         vk::RenderPass m_render_pass;
         Device& m_device;
         std::vector<Attachment> m_attachments;
         std::vector<RenderSubPass> m_sub_passes;
+        uint64_t m_compatibility_hash = 0;
     };
 }
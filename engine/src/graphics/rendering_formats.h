@@ -0,0 +1,29 @@
+#pragma once
+#include "vk_common.h"
+#include "core/stable_hash.h"
+
+#include <vector>
+
+namespace Comet {
+    // Attachment formats of a vkCmdBeginRendering pass. Pipelines created for
+    // dynamic rendering depend on these alone, so render targets with equal
+    // formats share pipelines whatever their size.
+    struct RenderingFormats {
+        std::vector<Format> color_formats;
+        Format depth_format = Format::UNDEFINED;
+        SampleCount samples = SampleCount::Count1;
+
+        [[nodiscard]] Format get_stencil_format() const {
+            return Graphics::has_stencil_component(depth_format) ? depth_format : Format::UNDEFINED;
+        }
+
+        [[nodiscard]] uint64_t get_compatibility_hash() const {
+            StableHasher hasher;
+            hasher.add(static_cast<uint64_t>(color_formats.size()));
+            for(const Format format: color_formats) {
+                hasher.add(format);
+            }
+            return hasher.add(depth_format).add(samples).get();
+        }
+    };
+}
@@ -12,6 +12,12 @@ namespace Comet {
                       desc.max_anisotropy);
         }
 
+        if(!std::isfinite(desc.mip_lod_bias) || desc.max_lod < 0.0f) {
+            LOG_FATAL("Sampler LOD bias must be finite and max LOD non-negative "
+                      "(requested: bias {}, max LOD {})",
+                      desc.mip_lod_bias, desc.max_lod);
+        }
+
         const float enabled_max_anisotropy =
             device.get_capability().max_sampler_anisotropy;
 
@@ -31,9 +37,9 @@ namespace Comet {
         sampler_create_info.borderColor = vk::BorderColor::eIntOpaqueBlack;
         sampler_create_info.unnormalizedCoordinates = VK_FALSE;
         sampler_create_info.mipmapMode = vk::SamplerMipmapMode::eLinear;
-        sampler_create_info.mipLodBias = 0.0f;
+        sampler_create_info.mipLodBias = desc.mip_lod_bias;
         sampler_create_info.minLod = 0.0f;
-        sampler_create_info.maxLod = VK_LOD_CLAMP_NONE;
+        sampler_create_info.maxLod = desc.max_lod;
         m_sampler = m_device.get().createSampler(sampler_create_info);
     }
 
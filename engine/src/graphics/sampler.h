@@ -12,6 +12,10 @@ namespace Comet {
         SamplerAddressMode address_mode_v = SamplerAddressMode::Repeat;
         SamplerAddressMode address_mode_w = SamplerAddressMode::Repeat;
         float max_anisotropy = 1.0f;
+        // Added to the computed LOD; negative values sharpen.
+        float mip_lod_bias = 0.0f;
+        // Highest mip level sampled; the default reaches the smallest level.
+        float max_lod = VK_LOD_CLAMP_NONE;
     };
 
     class COMET_API Sampler {
@@ -1,5 +1,6 @@
 #include "semaphore.h"
 #include "device.h"
+#include "common/logger.h"
 
 namespace Comet {
     Semaphore::Semaphore(Device& device): m_device(&device) {
@@ -7,6 +8,20 @@ namespace Comet {
         m_semaphore = m_device->get().createSemaphore(semaphore_create_info);
     }
 
+    Semaphore::Semaphore(Device& device, const uint64_t initial_value)
+        : m_device(&device), m_timeline(true) {
+        vk::SemaphoreTypeCreateInfo type_create_info = {};
+        type_create_info.semaphoreType = vk::SemaphoreType::eTimeline;
+        type_create_info.initialValue = initial_value;
+        vk::SemaphoreCreateInfo semaphore_create_info = {};
+        semaphore_create_info.pNext = &type_create_info;
+        m_semaphore = m_device->get().createSemaphore(semaphore_create_info);
+    }
+
+    Semaphore Semaphore::create_timeline(Device& device, const uint64_t initial_value) {
+        return Semaphore(device, initial_value);
+    }
+
     Semaphore::~Semaphore() {
         if (m_semaphore != VK_NULL_HANDLE && m_device) {
             m_device->get().destroySemaphore(m_semaphore);
@@ -14,7 +29,7 @@ namespace Comet {
     }
 
     Semaphore::Semaphore(Semaphore&& other) noexcept
-        : m_device(other.m_device), m_semaphore(other.m_semaphore) {
+        : m_device(other.m_device), m_semaphore(other.m_semaphore), m_timeline(other.m_timeline) {
         other.m_device = nullptr;
         other.m_semaphore = VK_NULL_HANDLE;
     }
@@ -26,9 +41,35 @@ namespace Comet {
             }
             m_device = other.m_device;
             m_semaphore = other.m_semaphore;
+            m_timeline = other.m_timeline;
             other.m_device = nullptr;
             other.m_semaphore = VK_NULL_HANDLE;
         }
         return *this;
     }
+
+    uint64_t Semaphore::get_counter_value() const {
+        if(!m_timeline) {
+            LOG_FATAL("Binary semaphores have no counter value");
+        }
+        return m_device->get().getSemaphoreCounterValue(m_semaphore);
+    }
+
+    bool Semaphore::wait(const uint64_t value, const uint64_t timeout) const {
+        if(!m_timeline) {
+            LOG_FATAL("Only timeline semaphores can be waited on from the host");
+        }
+        vk::SemaphoreWaitInfo wait_info = {};
+        wait_info.semaphoreCount = 1;
+        wait_info.pSemaphores = &m_semaphore;
+        wait_info.pValues = &value;
+        const vk::Result result = m_device->get().waitSemaphores(wait_info, timeout);
+        if(result == vk::Result::eTimeout) {
+            return false;
+        }
+        if(result != vk::Result::eSuccess) {
+            LOG_FATAL("Failed to wait for timeline semaphore: {}", vk::to_string(result));
+        }
+        return true;
+    }
 }
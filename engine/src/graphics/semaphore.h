@@ -1,6 +1,8 @@
 #pragma once
 #include "vk_common.h"
 
+#include <limits>
+
 namespace Comet {
     class Device;
 
@@ -9,6 +11,10 @@ namespace Comet {
         explicit Semaphore(Device& device);
         ~Semaphore();
 
+        // Timeline semaphores carry a 64-bit counter that queue submissions
+        // signal and wait on through QueueSemaphoreSubmit::value.
+        [[nodiscard]] static Semaphore create_timeline(Device& device, uint64_t initial_value = 0);
+
         Semaphore(const Semaphore&) = delete;
         Semaphore& operator=(const Semaphore&) = delete;
 
@@ -16,8 +22,19 @@ namespace Comet {
         Semaphore& operator=(Semaphore&& other) noexcept;
 
         [[nodiscard]] vk::Semaphore get() const { return m_semaphore; }
+        [[nodiscard]] bool is_timeline() const { return m_timeline; }
+
+        // Timeline only.
+        [[nodiscard]] uint64_t get_counter_value() const;
+
+        // Timeline only. Returns false on timeout.
+        bool wait(uint64_t value, uint64_t timeout = std::numeric_limits<uint64_t>::max()) const;
+
     private:
+        Semaphore(Device& device, uint64_t initial_value);
+
         Device* m_device;
         vk::Semaphore m_semaphore;
+        bool m_timeline = false;
     };
 }
@@ -0,0 +1,55 @@
+#include "staging_pool.h"
+
+#include "buffer.h"
+#include "common/logger.h"
+#include "device.h"
+
+namespace Comet {
+    namespace {
+        // Satisfies buffer-to-image copy offsets for every format in use,
+        // including 16-byte texels and compressed blocks.
+        constexpr size_t STAGING_ALIGNMENT = 16;
+    }
+
+    StagingPool::StagingPool(Device& device, const size_t block_size, const uint32_t max_block_count)
+        : m_device(device), m_allocator(block_size, max_block_count, STAGING_ALIGNMENT) {
+        if(block_size == 0) {
+            LOG_FATAL("StagingPool block size must be greater than zero");
+        }
+        m_blocks.reserve(max_block_count);
+    }
+
+    StagingPool::~StagingPool() = default;
+
+    StagingAllocation StagingPool::stage(const void* data, const size_t size, const uint64_t batch_value) {
+        if(!data || size == 0) {
+            LOG_ERROR("Invalid staging request of {} bytes", size);
+            return {};
+        }
+
+        if(const auto placement = m_allocator.allocate(size, batch_value)) {
+            if(placement->block == m_blocks.size()) {
+                m_blocks.push_back(std::make_shared<CPUBuffer>(
+                    m_device, Flags<BufferUsage>(BufferUsage::CopySrc), m_allocator.get_block_size(),
+                    nullptr, AllocationUsage::Upload, "staging block"));
+            }
+            CPUBuffer& block = *m_blocks[placement->block];
+            block.write(data, size, placement->offset);
+            return {&block, placement->offset};
+        }
+
+        auto buffer = std::make_shared<CPUBuffer>(
+            m_device, Flags<BufferUsage>(BufferUsage::CopySrc), size, data,
+            AllocationUsage::Upload, "dedicated staging buffer");
+        m_allocator.add_dedicated(size, batch_value);
+        const StagingAllocation allocation{buffer.get(), 0};
+        m_dedicated.push_back(std::move(buffer));
+        return allocation;
+    }
+
+    void StagingPool::recycle(const uint64_t completed_value) {
+        const size_t released = m_allocator.recycle(completed_value);
+        m_dedicated.erase(m_dedicated.begin(),
+                          m_dedicated.begin() + static_cast<std::ptrdiff_t>(released));
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "common/export.h"
+#include "core/staging_block_allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace Comet {
+    class Buffer;
+    class CPUBuffer;
+    class Device;
+
+    // Range of a staging buffer holding data for one copy command.
+    struct StagingAllocation {
+        const Buffer* buffer = nullptr;
+        size_t offset = 0;
+
+        [[nodiscard]] bool is_valid() const { return buffer != nullptr; }
+    };
+
+    // Persistently mapped upload blocks, filled linearly and handed back to
+    // the pool once the timeline value of the last batch that used them has
+    // been reached. Requests larger than a block, or arriving while every
+    // block is still in flight, get a dedicated buffer instead.
+    class COMET_API StagingPool {
+    public:
+        StagingPool(Device& device, size_t block_size, uint32_t max_block_count);
+
+        ~StagingPool();
+
+        StagingPool(const StagingPool&) = delete;
+
+        StagingPool& operator=(const StagingPool&) = delete;
+
+        StagingPool(StagingPool&&) noexcept = delete;
+
+        StagingPool& operator=(StagingPool&&) noexcept = delete;
+
+        // Copies `size` bytes of `data` into staging memory owned by the batch
+        // that will signal `batch_value`, and flushes the written range.
+        [[nodiscard]] StagingAllocation stage(const void* data, size_t size, uint64_t batch_value);
+
+        // Releases everything used by batches up to `completed_value`.
+        void recycle(uint64_t completed_value);
+
+        [[nodiscard]] const StagingPoolStats& get_stats() const { return m_allocator.get_stats(); }
+
+    private:
+        Device& m_device;
+        StagingBlockAllocator m_allocator;
+        // Indexed like the allocator's blocks.
+        std::vector<std::shared_ptr<CPUBuffer>> m_blocks;
+        // In the order reported to the allocator.
+        std::deque<std::shared_ptr<CPUBuffer>> m_dedicated;
+    };
+}
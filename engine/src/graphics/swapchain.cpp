@@ -57,7 +57,6 @@ namespace Comet {
         if(!message.empty()) {
             LOG_WARN("Swapchain selection: {}", message);
         }
-        m_device.wait_idle();
 
         vk::SharingMode image_sharing_mode;
         std::vector<uint32_t> queue_family_indices;
@@ -108,7 +107,10 @@ namespace Comet {
         m_current_index = static_cast<uint32_t>(-1);
 
         if(old_swapchain) {
-            m_device.get().destroySwapchainKHR(old_swapchain);
+            // 在途帧可能仍在呈现旧交换链的图像，待其完成后再销毁
+            m_device.get_deletion_queue().push([device = m_device.get(), old_swapchain] {
+                device.destroySwapchainKHR(old_swapchain);
+            });
         }
 
         LOG_INFO(
@@ -0,0 +1,369 @@
+#include "upload_service.h"
+
+#include "buffer.h"
+#include "common/logger.h"
+#include "common/profiler.h"
+#include "core/mip_chain.h"
+#include "device.h"
+#include "image.h"
+#include "queue.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Comet {
+    namespace {
+        // Large batches are submitted early so staging memory stays bounded.
+        constexpr size_t MAX_BATCH_STAGING_BYTES = 64ull * 1024 * 1024;
+        // Typical mesh and texture uploads fit in one block; larger ones and
+        // bursts beyond the block budget fall back to dedicated buffers.
+        constexpr size_t STAGING_BLOCK_SIZE = 16ull * 1024 * 1024;
+        constexpr uint32_t MAX_STAGING_BLOCKS = 4;
+
+        vk::ImageSubresourceRange color_subresource_range(const uint32_t base_mip_level, const uint32_t level_count) {
+            vk::ImageSubresourceRange range{};
+            range.aspectMask = vk::ImageAspectFlagBits::eColor;
+            range.baseMipLevel = base_mip_level;
+            range.levelCount = level_count;
+            range.baseArrayLayer = 0;
+            range.layerCount = 1;
+            return range;
+        }
+
+        void record_barriers(const CommandBuffer& command_buffer,
+                             const std::vector<vk::BufferMemoryBarrier2>& buffer_barriers,
+                             const std::vector<vk::ImageMemoryBarrier2>& image_barriers) {
+            if(buffer_barriers.empty() && image_barriers.empty()) {
+                return;
+            }
+            vk::DependencyInfo dependency_info{};
+            dependency_info.bufferMemoryBarrierCount = static_cast<uint32_t>(buffer_barriers.size());
+            dependency_info.pBufferMemoryBarriers = buffer_barriers.data();
+            dependency_info.imageMemoryBarrierCount = static_cast<uint32_t>(image_barriers.size());
+            dependency_info.pImageMemoryBarriers = image_barriers.data();
+            command_buffer.get().pipelineBarrier2(dependency_info);
+        }
+    }
+
+    UploadService::UploadService(Device& device)
+        : m_device(device),
+          m_queue(device.get_transfer_queue()),
+          m_graphics_family_index(device.get_graphics_queue(0).get_family_index()),
+          m_transfers_ownership(m_queue.get_family_index() != m_graphics_family_index),
+          m_command_pool(std::make_unique<CommandPool>(device, m_queue.get_family_index())),
+          m_timeline(Semaphore::create_timeline(device)),
+          m_staging_pool(device, STAGING_BLOCK_SIZE, MAX_STAGING_BLOCKS) {}
+
+    UploadService::~UploadService() {
+        if(m_recording) {
+            static_cast<void>(flush());
+        }
+        if(m_submitted_value > 0) {
+            m_timeline.wait(m_submitted_value);
+        }
+        retire_completed_batches();
+        if(!m_free_command_buffers.empty()) {
+            m_command_pool->free_command_buffers(m_free_command_buffers);
+        }
+    }
+
+    UploadTicket UploadService::upload_buffer(const void* data,
+                                              const size_t size,
+                                              const Buffer& destination,
+                                              const size_t destination_offset) {
+        if(!data || size == 0 || destination_offset > destination.get_size()
+           || size > destination.get_size() - destination_offset) {
+            LOG_ERROR("Invalid buffer upload of {} bytes at offset {}", size, destination_offset);
+            return {};
+        }
+
+        const CommandBuffer& command_buffer = begin_batch();
+        const StagingAllocation staging = m_staging_pool.stage(data, size, m_recording->value);
+        vk::BufferCopy region{};
+        region.srcOffset = staging.offset;
+        region.dstOffset = destination_offset;
+        region.size = size;
+        command_buffer.get().copyBuffer(staging.buffer->get(), destination.get(), 1, &region);
+
+        if(m_transfers_ownership) {
+            vk::BufferMemoryBarrier2 release{};
+            release.srcStageMask = vk::PipelineStageFlagBits2::eCopy;
+            release.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+            release.srcQueueFamilyIndex = m_queue.get_family_index();
+            release.dstQueueFamilyIndex = m_graphics_family_index;
+            release.buffer = destination.get();
+            release.offset = destination_offset;
+            release.size = size;
+            record_barriers(command_buffer, {release}, {});
+
+            vk::BufferMemoryBarrier2 acquire = release;
+            acquire.srcStageMask = vk::PipelineStageFlagBits2::eNone;
+            acquire.srcAccessMask = vk::AccessFlagBits2::eNone;
+            acquire.dstStageMask = vk::PipelineStageFlagBits2::eAllGraphics;
+            acquire.dstAccessMask = vk::AccessFlagBits2::eMemoryRead;
+            m_pending_buffer_acquires.push_back(acquire);
+        }
+
+        m_recording_bytes += size;
+        const UploadTicket ticket{m_recording->value};
+        if(m_recording_bytes >= MAX_BATCH_STAGING_BYTES) {
+            static_cast<void>(flush());
+        }
+        return ticket;
+    }
+
+    UploadTicket UploadService::upload_image(const void* data, const size_t size, const Image& destination) {
+        return record_image_upload(data, size, destination, destination.get_info().mip_levels);
+    }
+
+    UploadTicket UploadService::upload_image_and_blit_mips(const void* data,
+                                                           const size_t size,
+                                                           const Image& destination) {
+        if(!supports_mip_blits(destination.get_info().format)) {
+            LOG_ERROR("Mip blits are not available for format {}",
+                vk::to_string(Graphics::format_to_vk(destination.get_info().format)));
+            return {};
+        }
+        return record_image_upload(data, size, destination, 1);
+    }
+
+    bool UploadService::supports_mip_blits(const Format format) const {
+        // vkCmdBlitImage needs a graphics queue; the dedicated transfer
+        // family never has one.
+        if(m_transfers_ownership) {
+            return false;
+        }
+        constexpr auto required = vk::FormatFeatureFlagBits::eBlitSrc
+            | vk::FormatFeatureFlagBits::eBlitDst
+            | vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+        const auto features = m_device.get_format_properties(format).optimalTilingFeatures;
+        return (features & required) == required;
+    }
+
+    UploadTicket UploadService::record_image_upload(const void* data,
+                                                    const size_t size,
+                                                    const Image& destination,
+                                                    const uint32_t copied_levels) {
+        const auto& info = destination.get_info();
+        const auto levels = describe_mip_chain(
+            info.extent.x, info.extent.y, copied_levels, Graphics::format_size_in_bytes(info.format),
+            Graphics::format_block_extent(info.format));
+        const size_t expected_size = levels.back().offset + levels.back().size;
+        if(!data || size != expected_size) {
+            LOG_ERROR("Invalid image upload of {} bytes, expected {} for {} level(s)",
+                size, expected_size, copied_levels);
+            return {};
+        }
+
+        const CommandBuffer& command_buffer = begin_batch();
+        const StagingAllocation staging = m_staging_pool.stage(data, size, m_recording->value);
+        const uint32_t mip_levels = info.mip_levels;
+
+        vk::ImageMemoryBarrier2 to_transfer{};
+        to_transfer.srcStageMask = vk::PipelineStageFlagBits2::eNone;
+        to_transfer.srcAccessMask = vk::AccessFlagBits2::eNone;
+        // A dedicated transfer queue supports COPY but not BLIT, so BLIT is
+        // only named when levels are generated.
+        to_transfer.dstStageMask = copied_levels < mip_levels
+            ? vk::PipelineStageFlagBits2::eCopy | vk::PipelineStageFlagBits2::eBlit
+            : vk::PipelineStageFlags2(vk::PipelineStageFlagBits2::eCopy);
+        to_transfer.dstAccessMask = vk::AccessFlagBits2::eTransferWrite;
+        to_transfer.oldLayout = vk::ImageLayout::eUndefined;
+        to_transfer.newLayout = vk::ImageLayout::eTransferDstOptimal;
+        to_transfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        to_transfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        to_transfer.image = destination.get();
+        to_transfer.subresourceRange = color_subresource_range(0, mip_levels);
+        record_barriers(command_buffer, {}, {to_transfer});
+
+        std::vector<vk::BufferImageCopy> regions;
+        regions.reserve(levels.size());
+        for(uint32_t level = 0; level < copied_levels; ++level) {
+            vk::BufferImageCopy region{};
+            region.bufferOffset = staging.offset + levels[level].offset;
+            region.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+            region.imageSubresource.mipLevel = level;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = 1;
+            region.imageExtent = vk::Extent3D(levels[level].width, levels[level].height, 1);
+            regions.push_back(region);
+        }
+        command_buffer.get().copyBufferToImage(staging.buffer->get(), destination.get(),
+            vk::ImageLayout::eTransferDstOptimal, static_cast<uint32_t>(regions.size()), regions.data());
+
+        // Each generated level is blitted from the previous one, which is
+        // first moved to TRANSFER_SRC_OPTIMAL.
+        std::vector<vk::ImageMemoryBarrier2> to_shader;
+        if(copied_levels < mip_levels) {
+            int32_t width = static_cast<int32_t>(info.extent.x);
+            int32_t height = static_cast<int32_t>(info.extent.y);
+            for(uint32_t level = 1; level < mip_levels; ++level) {
+                vk::ImageMemoryBarrier2 to_source = to_transfer;
+                to_source.srcStageMask = vk::PipelineStageFlagBits2::eCopy | vk::PipelineStageFlagBits2::eBlit;
+                to_source.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+                to_source.dstStageMask = vk::PipelineStageFlagBits2::eBlit;
+                to_source.dstAccessMask = vk::AccessFlagBits2::eTransferRead;
+                to_source.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+                to_source.newLayout = vk::ImageLayout::eTransferSrcOptimal;
+                to_source.subresourceRange = color_subresource_range(level - 1, 1);
+                record_barriers(command_buffer, {}, {to_source});
+
+                const int32_t next_width = std::max(1, width / 2);
+                const int32_t next_height = std::max(1, height / 2);
+                vk::ImageBlit blit{};
+                blit.srcSubresource = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, level - 1, 0, 1);
+                blit.srcOffsets[1] = vk::Offset3D(width, height, 1);
+                blit.dstSubresource = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, level, 0, 1);
+                blit.dstOffsets[1] = vk::Offset3D(next_width, next_height, 1);
+                command_buffer.get().blitImage(
+                    destination.get(), vk::ImageLayout::eTransferSrcOptimal,
+                    destination.get(), vk::ImageLayout::eTransferDstOptimal,
+                    1, &blit, vk::Filter::eLinear);
+                width = next_width;
+                height = next_height;
+            }
+
+            vk::ImageMemoryBarrier2 sources = to_transfer;
+            sources.srcStageMask = vk::PipelineStageFlagBits2::eBlit;
+            sources.srcAccessMask = vk::AccessFlagBits2::eTransferRead;
+            sources.oldLayout = vk::ImageLayout::eTransferSrcOptimal;
+            sources.subresourceRange = color_subresource_range(0, mip_levels - 1);
+            to_shader.push_back(sources);
+
+            vk::ImageMemoryBarrier2 last = to_transfer;
+            last.srcStageMask = vk::PipelineStageFlagBits2::eBlit;
+            last.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+            last.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+            last.subresourceRange = color_subresource_range(mip_levels - 1, 1);
+            to_shader.push_back(last);
+        } else {
+            vk::ImageMemoryBarrier2 copied = to_transfer;
+            copied.srcStageMask = vk::PipelineStageFlagBits2::eCopy;
+            copied.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+            copied.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+            to_shader.push_back(copied);
+        }
+
+        // The layout change happens here; with a dedicated transfer family it
+        // doubles as the release half of the ownership transfer.
+        for(auto& barrier: to_shader) {
+            barrier.dstStageMask = vk::PipelineStageFlagBits2::eNone;
+            barrier.dstAccessMask = vk::AccessFlagBits2::eNone;
+            barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+            if(m_transfers_ownership) {
+                barrier.srcQueueFamilyIndex = m_queue.get_family_index();
+                barrier.dstQueueFamilyIndex = m_graphics_family_index;
+
+                vk::ImageMemoryBarrier2 acquire = barrier;
+                acquire.srcStageMask = vk::PipelineStageFlagBits2::eNone;
+                acquire.srcAccessMask = vk::AccessFlagBits2::eNone;
+                acquire.dstStageMask = vk::PipelineStageFlagBits2::eFragmentShader;
+                acquire.dstAccessMask = vk::AccessFlagBits2::eShaderSampledRead;
+                m_pending_image_acquires.push_back(acquire);
+            }
+        }
+        record_barriers(command_buffer, {}, to_shader);
+
+        m_recording_bytes += size;
+        const UploadTicket ticket{m_recording->value};
+        if(m_recording_bytes >= MAX_BATCH_STAGING_BYTES) {
+            static_cast<void>(flush());
+        }
+        return ticket;
+    }
+
+    UploadTicket UploadService::flush() {
+        if(!m_recording) {
+            return {m_submitted_value};
+        }
+        PROFILE_SCOPE("UploadService::flush");
+
+        Batch batch = std::move(*m_recording);
+        m_recording.reset();
+        m_recording_bytes = 0;
+
+        batch.command_buffer.end();
+        const QueueSemaphoreSubmit signal{
+            m_timeline,
+            Flags<PipelineStage>(PipelineStage::AllCommands),
+            batch.value
+        };
+        m_queue.submit2({}, std::span(&batch.command_buffer, 1), std::span(&signal, 1), nullptr);
+        m_submitted_value = batch.value;
+        m_in_flight.push_back(std::move(batch));
+
+        const auto& staging_stats = m_staging_pool.get_stats();
+        PROFILE_COUNTER("UploadService::staging_peak_bytes",
+            static_cast<std::int64_t>(staging_stats.peak_in_flight_bytes));
+        PROFILE_COUNTER("UploadService::staging_allocations_avoided",
+            static_cast<std::int64_t>(staging_stats.avoided_allocations));
+        return {m_submitted_value};
+    }
+
+    bool UploadService::is_complete(const UploadTicket ticket) const {
+        return ticket.value <= m_submitted_value && m_timeline.get_counter_value() >= ticket.value;
+    }
+
+    void UploadService::wait(const UploadTicket ticket) {
+        if(!ticket.is_valid()) {
+            return;
+        }
+        if(ticket.value > m_submitted_value) {
+            static_cast<void>(flush());
+        }
+        PROFILE_SCOPE("UploadService::wait");
+        m_timeline.wait(ticket.value);
+        retire_completed_batches();
+    }
+
+    void UploadService::forget(const Buffer& buffer) {
+        std::erase_if(m_pending_buffer_acquires, [&buffer](const vk::BufferMemoryBarrier2& barrier) {
+            return barrier.buffer == buffer.get();
+        });
+    }
+
+    std::optional<uint64_t> UploadService::acquire_for_graphics(const CommandBuffer& command_buffer) {
+        static_cast<void>(flush());
+        retire_completed_batches();
+        if(m_submitted_value == m_graphics_synced_value) {
+            return std::nullopt;
+        }
+
+        record_barriers(command_buffer, m_pending_buffer_acquires, m_pending_image_acquires);
+        m_pending_buffer_acquires.clear();
+        m_pending_image_acquires.clear();
+        m_graphics_synced_value = m_submitted_value;
+        return m_submitted_value;
+    }
+
+    const CommandBuffer& UploadService::begin_batch() {
+        if(!m_recording) {
+            retire_completed_batches();
+            CommandBuffer command_buffer = m_free_command_buffers.empty()
+                ? m_command_pool->allocate_command_buffer()
+                : m_free_command_buffers.back();
+            if(!m_free_command_buffers.empty()) {
+                m_free_command_buffers.pop_back();
+            }
+            command_buffer.reset();
+            command_buffer.begin(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+            m_recording.emplace(Batch{
+                .value = m_submitted_value + 1,
+                .command_buffer = command_buffer
+            });
+        }
+        return m_recording->command_buffer;
+    }
+
+    void UploadService::retire_completed_batches() {
+        if(m_in_flight.empty()) {
+            return;
+        }
+        const uint64_t completed_value = m_timeline.get_counter_value();
+        while(!m_in_flight.empty() && m_in_flight.front().value <= completed_value) {
+            m_free_command_buffers.push_back(m_in_flight.front().command_buffer);
+            m_in_flight.pop_front();
+        }
+        m_staging_pool.recycle(completed_value);
+    }
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "command_buffer.h"
+#include "common/export.h"
+#include "semaphore.h"
+#include "staging_pool.h"
+#include "upload_ticket.h"
+#include "vk_common.h"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Comet {
+    class Buffer;
+    class Device;
+    class Image;
+    class Queue;
+
+    // Records resource copies into batches submitted to the device's
+    // transfer queue (graphics queue 0 when there is no dedicated family).
+    // Each submission signals a timeline semaphore with the batch's ticket
+    // value. Source data is copied into a StagingPool whose blocks are
+    // recycled once that value is reached.
+    //
+    // With a dedicated transfer family the destination resources are
+    // released to the graphics family; the matching acquire barriers are
+    // recorded by acquire_for_graphics() into the next frame's command
+    // buffer. Resources uploaded after that call become usable one frame
+    // later. Not thread-safe: uploads and frame recording share one thread.
+    class COMET_API UploadService {
+    public:
+        explicit UploadService(Device& device);
+
+        ~UploadService();
+
+        UploadService(const UploadService&) = delete;
+
+        UploadService& operator=(const UploadService&) = delete;
+
+        UploadService(UploadService&&) noexcept = delete;
+
+        UploadService& operator=(UploadService&&) noexcept = delete;
+
+        // Copies `size` bytes of `data` into `destination` at
+        // `destination_offset`. `data` may be released as soon as the call
+        // returns.
+        UploadTicket upload_buffer(const void* data, size_t size, const Buffer& destination,
+                                   size_t destination_offset = 0);
+
+        // Copies every mip level of `destination` from tightly packed texels,
+        // laid out largest level first as describe_mip_chain() reports, and
+        // leaves the image in SHADER_READ_ONLY_OPTIMAL.
+        UploadTicket upload_image(const void* data, size_t size, const Image& destination);
+
+        // Copies mip 0 only and fills the remaining levels with linear blits.
+        // Requires supports_mip_blits() for the image's format.
+        UploadTicket upload_image_and_blit_mips(const void* data, size_t size, const Image& destination);
+
+        // Blits need a graphics-capable upload queue and a format that
+        // supports linear filtering of blit sources.
+        [[nodiscard]] bool supports_mip_blits(Format format) const;
+
+        // Submits the batch being recorded, if any. Returns the ticket of the
+        // most recently submitted batch.
+        UploadTicket flush();
+
+        [[nodiscard]] bool is_complete(UploadTicket ticket) const;
+
+        // Blocks the calling thread until `ticket` completes, submitting it
+        // first if it is still being recorded.
+        void wait(UploadTicket ticket);
+
+        // Flushes pending uploads and records the queue-family acquire
+        // barriers for everything submitted since the previous call. Returns
+        // the timeline value the graphics submission must wait on, if any.
+        [[nodiscard]] std::optional<uint64_t> acquire_for_graphics(const CommandBuffer& command_buffer);
+
+        // Drops the pending acquire barriers of `buffer` so it can be destroyed
+        // before a frame has taken ownership of it. Its uploads must have
+        // completed.
+        void forget(const Buffer& buffer);
+
+        [[nodiscard]] const Semaphore& get_timeline_semaphore() const { return m_timeline; }
+
+        [[nodiscard]] bool transfers_ownership() const { return m_transfers_ownership; }
+
+        [[nodiscard]] const StagingPoolStats& get_staging_stats() const { return m_staging_pool.get_stats(); }
+
+    private:
+        struct Batch {
+            uint64_t value = 0;
+            CommandBuffer command_buffer;
+        };
+
+        [[nodiscard]] const CommandBuffer& begin_batch();
+
+        UploadTicket record_image_upload(const void* data, size_t size, const Image& destination,
+                                         uint32_t copied_levels);
+
+        void retire_completed_batches();
+
+        Device& m_device;
+        Queue& m_queue;
+        uint32_t m_graphics_family_index;
+        bool m_transfers_ownership;
+        std::unique_ptr<CommandPool> m_command_pool;
+        Semaphore m_timeline;
+        StagingPool m_staging_pool;
+
+        std::optional<Batch> m_recording;
+        size_t m_recording_bytes = 0;
+        std::deque<Batch> m_in_flight;
+        std::vector<CommandBuffer> m_free_command_buffers;
+        uint64_t m_submitted_value = 0;
+        uint64_t m_graphics_synced_value = 0;
+
+        std::vector<vk::BufferMemoryBarrier2> m_pending_buffer_acquires;
+        std::vector<vk::ImageMemoryBarrier2> m_pending_image_acquires;
+    };
+}
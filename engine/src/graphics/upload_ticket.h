@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Comet {
+    // Timeline value of the upload batch that carries a resource's initial
+    // contents. A default ticket refers to no work and is always complete.
+    struct UploadTicket {
+        uint64_t value = 0;
+
+        [[nodiscard]] bool is_valid() const { return value != 0; }
+    };
+}
@@ -1,5 +1,7 @@
 #include "vertex_description.h"
 
+#include "core/stable_hash.h"
+
 namespace Comet {
     void VertexInputDescription::add_binding(const uint32_t binding, const uint32_t stride, const VertexInputRate input_rate) {
         vk::VertexInputBindingDescription bind_desc{};
@@ -18,4 +20,18 @@ namespace Comet {
         attr_desc.offset = static_cast<uint32_t>(offset);
         m_attributes.push_back(attr_desc);
     }
+
+    uint64_t VertexInputDescription::get_layout_hash() const {
+        StableHasher hasher;
+        hasher.add(static_cast<uint64_t>(m_bindings.size()));
+        for(const auto& binding: m_bindings) {
+            hasher.add(binding.binding).add(binding.stride).add(binding.inputRate);
+        }
+        hasher.add(static_cast<uint64_t>(m_attributes.size()));
+        for(const auto& attribute: m_attributes) {
+            hasher.add(attribute.location).add(attribute.binding)
+                  .add(attribute.format).add(attribute.offset);
+        }
+        return hasher.get();
+    }
 }
@@ -13,6 +13,9 @@ namespace Comet {
         [[nodiscard]] const std::vector<vk::VertexInputBindingDescription>& get_bindings() const { return m_bindings; }
         [[nodiscard]] const std::vector<vk::VertexInputAttributeDescription>& get_attributes() const { return m_attributes; }
 
+        // Stable hash of the bindings and attributes, in declaration order.
+        [[nodiscard]] uint64_t get_layout_hash() const;
+
     private:
         std::vector<vk::VertexInputBindingDescription> m_bindings;
         std::vector<vk::VertexInputAttributeDescription> m_attributes;
@@ -141,6 +141,37 @@ namespace Comet {
 
         }
 
+        void select_transfer_queue_family(DeviceCandidate& candidate) {
+            const auto queue_families =
+                candidate.capability.physical_device.getQueueFamilyProperties();
+            const auto& graphics_family = candidate.capability.graphics_queue_family;
+            const auto& present_family = candidate.capability.present_queue_family;
+
+            std::optional<uint32_t> selected;
+            for(uint32_t index = 0; index < queue_families.size(); ++index) {
+                const auto flags = queue_families[index].queueFlags;
+                if(!(flags & vk::QueueFlagBits::eTransfer)
+                   || static_cast<bool>(flags & vk::QueueFlagBits::eGraphics)
+                   || index == graphics_family.queue_family_index
+                   || index == present_family.queue_family_index) {
+                    continue;
+                }
+                // A DMA-only family beats an async compute family.
+                if(!selected || !(flags & vk::QueueFlagBits::eCompute)) {
+                    selected = index;
+                }
+                if(!(flags & vk::QueueFlagBits::eCompute)) {
+                    break;
+                }
+            }
+            if(selected) {
+                candidate.capability.transfer_queue_family = {
+                    .queue_family_index = *selected,
+                    .queue_count = queue_families[*selected].queueCount
+                };
+            }
+        }
+
         DeviceCandidate evaluate_device(
             const vk::PhysicalDevice physical_device,
             const vk::SurfaceKHR surface,
@@ -156,6 +187,7 @@ namespace Comet {
                 surface,
                 required_graphics_queue_count,
                 required_present_queue_count);
+            select_transfer_queue_family(candidate);
 
             DeviceCandidateInfo candidate_info{
                 .api_version = properties.apiVersion,
@@ -218,25 +250,38 @@ namespace Comet {
             const auto supported_features = physical_device.getFeatures();
             candidate_info.sampler_anisotropy_supported = supported_features.samplerAnisotropy;
             candidate_info.max_sampler_anisotropy = properties.limits.maxSamplerAnisotropy;
+            candidate_info.texture_compression_bc_supported = supported_features.textureCompressionBC;
             if(properties.apiVersion >= VK_API_VERSION_1_3) {
                 vk::PhysicalDeviceVulkan13Features supported_vulkan13_features{};
+                vk::PhysicalDeviceVulkan12Features supported_vulkan12_features{};
+                supported_vulkan12_features.pNext = &supported_vulkan13_features;
                 vk::PhysicalDeviceFeatures2 supported_features2{};
-                supported_features2.pNext = &supported_vulkan13_features;
+                supported_features2.pNext = &supported_vulkan12_features;
                 physical_device.getFeatures2(&supported_features2);
                 candidate_info.synchronization2_supported =
                     supported_vulkan13_features.synchronization2;
+                candidate_info.dynamic_rendering_supported =
+                    supported_vulkan13_features.dynamicRendering;
+                candidate_info.timeline_semaphore_supported =
+                    supported_vulkan12_features.timelineSemaphore;
             }
 
-            auto [score, rejection_reasons, notes, score_reasons, enabled_features, enabled_vulkan13_features, max_sampler_anisotropy] = evaluate_device_candidate(
+            auto [score, rejection_reasons, notes, score_reasons, enabled_features, enabled_vulkan12_features, enabled_vulkan13_features, max_sampler_anisotropy] = evaluate_device_candidate(
                 candidate_info, request);
             candidate.score = score;
             candidate.rejection_reasons = std::move(rejection_reasons);
             candidate.notes = std::move(notes);
             candidate.score_reasons = std::move(score_reasons);
             candidate.capability.enabled_features = enabled_features;
+            candidate.capability.enabled_vulkan12_features =
+                enabled_vulkan12_features;
             candidate.capability.enabled_vulkan13_features =
                 enabled_vulkan13_features;
             candidate.capability.max_sampler_anisotropy = max_sampler_anisotropy;
+            candidate.capability.min_uniform_buffer_offset_alignment =
+                properties.limits.minUniformBufferOffsetAlignment;
+            candidate.capability.min_storage_buffer_offset_alignment =
+                properties.limits.minStorageBufferOffsetAlignment;
 
             return candidate;
         }
@@ -288,6 +333,18 @@ namespace Comet {
         } else {
             evaluation.enabled_vulkan13_features.synchronization2 = VK_TRUE;
         }
+        if(!candidate.dynamic_rendering_supported) {
+            evaluation.rejection_reasons.emplace_back(
+                "required Vulkan 1.3 feature dynamicRendering is unsupported");
+        } else {
+            evaluation.enabled_vulkan13_features.dynamicRendering = VK_TRUE;
+        }
+        if(!candidate.timeline_semaphore_supported) {
+            evaluation.rejection_reasons.emplace_back(
+                "required Vulkan 1.2 feature timelineSemaphore is unsupported");
+        } else {
+            evaluation.enabled_vulkan12_features.timelineSemaphore = VK_TRUE;
+        }
 
         if(request.max_sampler_anisotropy > 1.0f) {
             if(candidate.sampler_anisotropy_supported) {
@@ -311,6 +368,13 @@ namespace Comet {
             }
         }
 
+        if(candidate.texture_compression_bc_supported) {
+            evaluation.enabled_features.textureCompressionBC = VK_TRUE;
+        } else {
+            evaluation.notes.emplace_back(
+                "BC texture compression is unsupported; compressed textures will be decoded to RGBA8");
+        }
+
         const uint32_t device_type_score = get_device_type_score(candidate.device_type);
         evaluation.score += device_type_score;
         evaluation.score_reasons.emplace_back(
@@ -532,6 +596,9 @@ namespace Comet {
             LOG_INFO("Enabled optional device feature: samplerAnisotropy (max: {})",
                 selected_candidate->capability.max_sampler_anisotropy);
         }
+        if(selected_candidate->capability.enabled_features.textureCompressionBC) {
+            LOG_INFO("Enabled optional device feature: textureCompressionBC");
+        }
 #endif
 
         return std::move(selected_candidate->capability);
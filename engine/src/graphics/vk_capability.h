@@ -40,10 +40,17 @@ namespace Comet {
         vk::PhysicalDevice physical_device;
         QueueFamilyInfo graphics_queue_family;
         QueueFamilyInfo present_queue_family;
+        // Transfer-capable family without graphics support, preferring one
+        // without compute as well. Empty when uploads share the graphics queue.
+        QueueFamilyInfo transfer_queue_family;
         std::vector<const char*> enabled_extensions;
         vk::PhysicalDeviceFeatures enabled_features{};
+        vk::PhysicalDeviceVulkan12Features enabled_vulkan12_features{};
         vk::PhysicalDeviceVulkan13Features enabled_vulkan13_features{};
         float max_sampler_anisotropy = 1.0f;
+        // Dynamic buffer offsets must be multiples of these.
+        vk::DeviceSize min_uniform_buffer_offset_alignment = 256;
+        vk::DeviceSize min_storage_buffer_offset_alignment = 256;
     };
 
     struct SwapchainConfig {
@@ -84,8 +91,11 @@ namespace Comet {
         bool color_format_supported = false;
         bool depth_format_supported = false;
         bool synchronization2_supported = false;
+        bool dynamic_rendering_supported = false;
+        bool timeline_semaphore_supported = false;
         bool sampler_anisotropy_supported = false;
         float max_sampler_anisotropy = 1.0f;
+        bool texture_compression_bc_supported = false;
     };
 
     struct DeviceCandidateEvaluation {
@@ -94,6 +104,7 @@ namespace Comet {
         std::vector<std::string> notes;
         std::vector<std::string> score_reasons;
         vk::PhysicalDeviceFeatures enabled_features{};
+        vk::PhysicalDeviceVulkan12Features enabled_vulkan12_features{};
         vk::PhysicalDeviceVulkan13Features enabled_vulkan13_features{};
         float max_sampler_anisotropy = 1.0f;
 
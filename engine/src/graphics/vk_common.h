@@ -78,13 +78,52 @@ namespace Comet {
                    || format == Format::D32_SFLOAT_S8_UINT;
         }
 
+        inline bool has_stencil_component(const Format format) {
+            return is_depth_stencil_format(format) && !is_depth_only_format(format);
+        }
+
+        // Formats whose texels are stored B, G, R, A; decoded images are RGBA.
+        inline bool is_bgra8_format(const Format format) {
+            return format == Format::B8G8R8A8_UNORM || format == Format::B8G8R8A8_SRGB;
+        }
+
+        inline bool is_block_compressed_format(const Format format) {
+            return format >= Format::BC1_RGB_UNORM_BLOCK && format <= Format::BC7_SRGB_BLOCK;
+        }
+
+        // Texel footprint of one addressable unit: 4 for BCn blocks, 1 otherwise.
+        inline uint32_t format_block_extent(const Format format) {
+            return is_block_compressed_format(format) ? 4 : 1;
+        }
+
+        // Bytes per texel, or per block for block-compressed formats.
         inline uint32_t format_size_in_bytes(const Format format) {
             switch(format) {
                 case Format::R8_UNORM: return 1;
                 case Format::R8G8B8A8_UNORM:
+                case Format::R8G8B8A8_SRGB:
                 case Format::B8G8R8A8_UNORM:
+                case Format::B8G8R8A8_SRGB:
                     return 4;
                 case Format::R16G16B16A16_SFLOAT: return 8;
+                case Format::BC1_RGB_UNORM_BLOCK:
+                case Format::BC1_RGB_SRGB_BLOCK:
+                case Format::BC1_RGBA_UNORM_BLOCK:
+                case Format::BC1_RGBA_SRGB_BLOCK:
+                case Format::BC4_UNORM_BLOCK:
+                case Format::BC4_SNORM_BLOCK:
+                    return 8;
+                case Format::BC2_UNORM_BLOCK:
+                case Format::BC2_SRGB_BLOCK:
+                case Format::BC3_UNORM_BLOCK:
+                case Format::BC3_SRGB_BLOCK:
+                case Format::BC5_UNORM_BLOCK:
+                case Format::BC5_SNORM_BLOCK:
+                case Format::BC6H_UFLOAT_BLOCK:
+                case Format::BC6H_SFLOAT_BLOCK:
+                case Format::BC7_UNORM_BLOCK:
+                case Format::BC7_SRGB_BLOCK:
+                    return 16;
                 default: LOG_FATAL("Unsupported format for byte size calculation");
             }
         }
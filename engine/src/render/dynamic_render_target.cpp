@@ -0,0 +1,259 @@
+#include "dynamic_render_target.h"
+#include "graphics/command_buffer.h"
+#include "graphics/device.h"
+#include "graphics/swapchain.h"
+#include "graphics/image.h"
+#include "graphics/image_view.h"
+
+#include <array>
+#include <span>
+
+namespace Comet {
+    namespace {
+        vk::ImageMemoryBarrier2 layout_barrier(const Image& image, const vk::ImageAspectFlags aspect,
+                                               const vk::ImageLayout old_layout, const vk::ImageLayout new_layout) {
+            vk::ImageMemoryBarrier2 barrier{};
+            barrier.oldLayout = old_layout;
+            barrier.newLayout = new_layout;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = image.get();
+            barrier.subresourceRange.aspectMask = aspect;
+            barrier.subresourceRange.baseMipLevel = 0;
+            barrier.subresourceRange.levelCount = 1;
+            barrier.subresourceRange.baseArrayLayer = 0;
+            barrier.subresourceRange.layerCount = 1;
+            return barrier;
+        }
+
+        // Every attachment is cleared on load, so previous contents are discarded.
+        vk::ImageMemoryBarrier2 color_attachment_barrier(const Image& image, const bool was_sampled) {
+            auto barrier = layout_barrier(image, vk::ImageAspectFlagBits::eColor,
+                vk::ImageLayout::eUndefined, vk::ImageLayout::eColorAttachmentOptimal);
+            barrier.srcStageMask = vk::PipelineStageFlagBits2::eColorAttachmentOutput;
+            if(was_sampled) {
+                barrier.srcStageMask |= vk::PipelineStageFlagBits2::eFragmentShader;
+            }
+            barrier.srcAccessMask = vk::AccessFlagBits2::eNone;
+            barrier.dstStageMask = vk::PipelineStageFlagBits2::eColorAttachmentOutput;
+            barrier.dstAccessMask = vk::AccessFlagBits2::eColorAttachmentWrite;
+            return barrier;
+        }
+
+        vk::ImageMemoryBarrier2 depth_attachment_barrier(const Image& image, const vk::ImageAspectFlags aspect) {
+            auto barrier = layout_barrier(image, aspect,
+                vk::ImageLayout::eUndefined, vk::ImageLayout::eDepthStencilAttachmentOptimal);
+            barrier.srcStageMask = vk::PipelineStageFlagBits2::eEarlyFragmentTests
+                                   | vk::PipelineStageFlagBits2::eLateFragmentTests;
+            barrier.srcAccessMask = vk::AccessFlagBits2::eDepthStencilAttachmentWrite;
+            barrier.dstStageMask = barrier.srcStageMask;
+            barrier.dstAccessMask = vk::AccessFlagBits2::eDepthStencilAttachmentRead
+                                    | vk::AccessFlagBits2::eDepthStencilAttachmentWrite;
+            return barrier;
+        }
+
+        void record_barriers(const CommandBuffer& command_buffer,
+                             const std::span<const vk::ImageMemoryBarrier2> barriers) {
+            vk::DependencyInfo dependency_info{};
+            dependency_info.imageMemoryBarrierCount = static_cast<uint32_t>(barriers.size());
+            dependency_info.pImageMemoryBarriers = barriers.data();
+            command_buffer.get().pipelineBarrier2(dependency_info);
+        }
+    }
+
+    std::unique_ptr<DynamicRenderTarget> DynamicRenderTarget::create_swapchain_target(
+        Device& device, Swapchain& swapchain, RenderingFormats formats) {
+        return std::unique_ptr<DynamicRenderTarget>(new DynamicRenderTarget(
+            device, &swapchain, std::move(formats),
+            Math::Vec2u(swapchain.get_width(), swapchain.get_height()),
+            static_cast<uint32_t>(swapchain.get_images().size())));
+    }
+
+    std::unique_ptr<DynamicRenderTarget> DynamicRenderTarget::create_sampled_target(
+        Device& device, RenderingFormats formats, const Math::Vec2u size, const uint32_t frame_count) {
+        return std::unique_ptr<DynamicRenderTarget>(new DynamicRenderTarget(
+            device, nullptr, std::move(formats), size, frame_count));
+    }
+
+    DynamicRenderTarget::DynamicRenderTarget(Device& device, Swapchain* swapchain, RenderingFormats formats,
+                                             const Math::Vec2u size, const uint32_t frame_count)
+        : m_device(device), m_swapchain(swapchain), m_formats(std::move(formats)),
+          m_extent(size), m_frame_count(frame_count),
+          m_color_clear_value(Math::Vec4(0.2f, 0.3f, 0.3f, 1.0f)),
+          m_depth_clear_value(1.0f, 0) {
+        if(m_formats.color_formats.size() != 1) {
+            LOG_FATAL("Dynamic render target needs exactly one color format, got {}",
+                m_formats.color_formats.size());
+        }
+        recreate();
+    }
+
+    DynamicRenderTarget::~DynamicRenderTarget() {
+        release_attachments();
+    }
+
+    void DynamicRenderTarget::recreate() {
+        if(m_swapchain) {
+            m_extent.x = m_swapchain->get_width();
+            m_extent.y = m_swapchain->get_height();
+            m_frame_count = static_cast<uint32_t>(m_swapchain->get_images().size());
+        }
+        m_needs_recreate = false;
+        release_attachments();
+        if(m_extent.x == 0 || m_extent.y == 0) {
+            return;
+        }
+
+        const Format color_format = m_formats.color_formats.front();
+        const Math::Vec3u extent(m_extent.x, m_extent.y, 1);
+        Flags<ImageAspect> depth_aspect(ImageAspect::Depth);
+        if(Graphics::has_stencil_component(m_formats.depth_format)) {
+            depth_aspect |= ImageAspect::Stencil;
+        }
+
+        m_attachments.resize(m_frame_count);
+        for(uint32_t index = 0; index < m_frame_count; ++index) {
+            FrameAttachments& attachments = m_attachments[index];
+            if(is_multisampled()) {
+                attachments.color_image = Image::create(m_device,
+                    ImageInfo{color_format, extent, Flags<ImageUsage>(ImageUsage::ColorAttachment)},
+                    m_formats.samples, "render target msaa color image");
+                attachments.color_view = std::make_shared<ImageView>(
+                    m_device, *attachments.color_image, Flags<ImageAspect>(ImageAspect::Color));
+            }
+
+            if(m_swapchain) {
+                attachments.output_image = m_swapchain->get_images()[index];
+            } else {
+                attachments.output_image = Image::create(m_device,
+                    ImageInfo{color_format, extent, Flags<ImageUsage>(ImageUsage::ColorAttachment) | ImageUsage::Sampled},
+                    SampleCount::Count1, "render target color image");
+            }
+            attachments.output_view = std::make_shared<ImageView>(
+                m_device, *attachments.output_image, Flags<ImageAspect>(ImageAspect::Color));
+
+            if(m_formats.depth_format != Format::UNDEFINED) {
+                attachments.depth_image = Image::create(m_device,
+                    ImageInfo{m_formats.depth_format, extent, Flags<ImageUsage>(ImageUsage::DepthStencilAttachment)},
+                    m_formats.samples, "render target depth image");
+                attachments.depth_view = std::make_shared<ImageView>(
+                    m_device, *attachments.depth_image, depth_aspect);
+            }
+        }
+    }
+
+    void DynamicRenderTarget::release_attachments() {
+        if(m_attachments.empty()) {
+            return;
+        }
+        // Frames in flight may still render into the old images.
+        m_device.get_deletion_queue().retire(
+            std::make_shared<std::vector<FrameAttachments>>(std::move(m_attachments)));
+        m_attachments.clear();
+    }
+
+    void DynamicRenderTarget::resize(const uint32_t width, const uint32_t height) {
+        if(m_extent.x == width && m_extent.y == height) {
+            return;
+        }
+        m_extent.x = width;
+        m_extent.y = height;
+        m_needs_recreate = true;
+    }
+
+    void DynamicRenderTarget::set_clear_value(const ClearValue& clear_value) {
+        if(clear_value.is_color()) {
+            m_color_clear_value = clear_value;
+        } else {
+            m_depth_clear_value = clear_value;
+        }
+    }
+
+    void DynamicRenderTarget::begin_render_target(const CommandBuffer& command_buffer, const uint32_t frame_index) {
+        if(m_needs_recreate) {
+            recreate();
+        }
+        if(frame_index >= m_attachments.size()) {
+            LOG_FATAL("Render target frame index {} exceeds frame count {}",
+                frame_index, m_attachments.size());
+        }
+        m_current_index = frame_index;
+        const FrameAttachments& attachments = m_attachments[frame_index];
+        const bool has_stencil = Graphics::has_stencil_component(m_formats.depth_format);
+
+        std::vector<vk::ImageMemoryBarrier2> barriers;
+        barriers.push_back(color_attachment_barrier(*attachments.output_image, m_swapchain == nullptr));
+        if(attachments.color_image) {
+            barriers.push_back(color_attachment_barrier(*attachments.color_image, false));
+        }
+        if(attachments.depth_image) {
+            vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eDepth;
+            if(has_stencil) {
+                aspect |= vk::ImageAspectFlagBits::eStencil;
+            }
+            barriers.push_back(depth_attachment_barrier(*attachments.depth_image, aspect));
+        }
+        record_barriers(command_buffer, barriers);
+
+        vk::RenderingAttachmentInfo color_attachment{};
+        color_attachment.imageLayout = vk::ImageLayout::eColorAttachmentOptimal;
+        color_attachment.loadOp = vk::AttachmentLoadOp::eClear;
+        color_attachment.clearValue = m_color_clear_value.vk_value();
+        if(attachments.color_image) {
+            // 多重采样结果在渲染结束时直接解析到输出图像，无需保存
+            color_attachment.imageView = attachments.color_view->get();
+            color_attachment.storeOp = vk::AttachmentStoreOp::eDontCare;
+            color_attachment.resolveMode = vk::ResolveModeFlagBits::eAverage;
+            color_attachment.resolveImageView = attachments.output_view->get();
+            color_attachment.resolveImageLayout = vk::ImageLayout::eColorAttachmentOptimal;
+        } else {
+            color_attachment.imageView = attachments.output_view->get();
+            color_attachment.storeOp = vk::AttachmentStoreOp::eStore;
+        }
+
+        vk::RenderingAttachmentInfo depth_attachment{};
+        if(attachments.depth_view) {
+            depth_attachment.imageView = attachments.depth_view->get();
+            depth_attachment.imageLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal;
+            depth_attachment.loadOp = vk::AttachmentLoadOp::eClear;
+            depth_attachment.storeOp = vk::AttachmentStoreOp::eDontCare;
+            depth_attachment.clearValue = m_depth_clear_value.vk_value();
+        }
+
+        vk::RenderingInfo rendering_info{};
+        rendering_info.renderArea.offset = vk::Offset2D{0, 0};
+        rendering_info.renderArea.extent = vk::Extent2D{m_extent.x, m_extent.y};
+        rendering_info.layerCount = 1;
+        rendering_info.colorAttachmentCount = 1;
+        rendering_info.pColorAttachments = &color_attachment;
+        if(attachments.depth_view) {
+            rendering_info.pDepthAttachment = &depth_attachment;
+            if(has_stencil) {
+                rendering_info.pStencilAttachment = &depth_attachment;
+            }
+        }
+        command_buffer.begin_rendering(rendering_info);
+    }
+
+    void DynamicRenderTarget::end_render_target(const CommandBuffer& command_buffer) const {
+        command_buffer.end_rendering();
+
+        const FrameAttachments& attachments = m_attachments.at(m_current_index);
+        std::array<vk::ImageMemoryBarrier2, 1> barriers;
+        if(m_swapchain) {
+            // 呈现前的等待由 render finished 信号量保证
+            barriers[0] = layout_barrier(*attachments.output_image, vk::ImageAspectFlagBits::eColor,
+                vk::ImageLayout::eColorAttachmentOptimal, vk::ImageLayout::ePresentSrcKHR);
+            barriers[0].dstStageMask = vk::PipelineStageFlagBits2::eNone;
+            barriers[0].dstAccessMask = vk::AccessFlagBits2::eNone;
+        } else {
+            barriers[0] = layout_barrier(*attachments.output_image, vk::ImageAspectFlagBits::eColor,
+                vk::ImageLayout::eColorAttachmentOptimal, vk::ImageLayout::eShaderReadOnlyOptimal);
+            barriers[0].dstStageMask = vk::PipelineStageFlagBits2::eFragmentShader;
+            barriers[0].dstAccessMask = vk::AccessFlagBits2::eShaderSampledRead;
+        }
+        barriers[0].srcStageMask = vk::PipelineStageFlagBits2::eColorAttachmentOutput;
+        barriers[0].srcAccessMask = vk::AccessFlagBits2::eColorAttachmentWrite;
+        record_barriers(command_buffer, barriers);
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "graphics/vk_common.h"
+#include "graphics/rendering_formats.h"
+#include "core/math_utils.h"
+#include "common/export.h"
+
+#include <memory>
+#include <vector>
+
+namespace Comet {
+    class Image;
+    class ImageView;
+    class Swapchain;
+    class Device;
+    class CommandBuffer;
+
+    // Attachments of a vkCmdBeginRendering pass with one color attachment.
+    // There is no render pass or framebuffer object, so recreating the target
+    // only reallocates images and pipelines depend on get_formats() alone.
+    class COMET_API DynamicRenderTarget {
+    public:
+        // Renders into the acquired swapchain image and leaves it ready to present.
+        static std::unique_ptr<DynamicRenderTarget> create_swapchain_target(
+            Device& device, Swapchain& swapchain, RenderingFormats formats);
+
+        // Renders into one of `frame_count` images and leaves it ready to be sampled.
+        static std::unique_ptr<DynamicRenderTarget> create_sampled_target(
+            Device& device, RenderingFormats formats, Math::Vec2u size, uint32_t frame_count);
+
+        ~DynamicRenderTarget();
+
+        DynamicRenderTarget(const DynamicRenderTarget&) = delete;
+
+        DynamicRenderTarget& operator=(const DynamicRenderTarget&) = delete;
+
+        DynamicRenderTarget(DynamicRenderTarget&&) noexcept = delete;
+
+        DynamicRenderTarget& operator=(DynamicRenderTarget&&) noexcept = delete;
+
+        // Reallocates the images at the current size, or at the swapchain's.
+        // The old images are destroyed once the frames using them completed,
+        // so no device wait is needed.
+        void recreate();
+
+        // Takes effect at the next begin_render_target().
+        void resize(uint32_t width, uint32_t height);
+
+        void set_clear_value(const ClearValue& clear_value);
+
+        void begin_render_target(const CommandBuffer& command_buffer, uint32_t frame_index);
+
+        void end_render_target(const CommandBuffer& command_buffer) const;
+
+        [[nodiscard]] Math::Vec2u get_size() const { return m_extent; }
+        [[nodiscard]] uint32_t get_frame_count() const { return m_frame_count; }
+        [[nodiscard]] const RenderingFormats& get_formats() const { return m_formats; }
+        [[nodiscard]] bool is_dirty() const { return m_needs_recreate; }
+
+        // The single-sampled image the frame ends up in.
+        [[nodiscard]] std::shared_ptr<ImageView> get_color_view(const uint32_t index) const {
+            return m_attachments.at(index).output_view;
+        }
+
+    private:
+        struct FrameAttachments {
+            // Multisampled color, resolved into the output; null without MSAA.
+            std::shared_ptr<Image> color_image;
+            std::shared_ptr<ImageView> color_view;
+            std::shared_ptr<Image> output_image;
+            std::shared_ptr<ImageView> output_view;
+            std::shared_ptr<Image> depth_image;
+            std::shared_ptr<ImageView> depth_view;
+        };
+
+        DynamicRenderTarget(Device& device, Swapchain* swapchain, RenderingFormats formats,
+                            Math::Vec2u size, uint32_t frame_count);
+
+        // Hands the images to the device's deletion queue.
+        void release_attachments();
+
+        [[nodiscard]] bool is_multisampled() const { return m_formats.samples != SampleCount::Count1; }
+
+        Device& m_device;
+        // Null for sampled targets.
+        Swapchain* m_swapchain;
+        RenderingFormats m_formats;
+        Math::Vec2u m_extent;
+        uint32_t m_frame_count;
+        ClearValue m_color_clear_value;
+        ClearValue m_depth_clear_value;
+        std::vector<FrameAttachments> m_attachments;
+        bool m_needs_recreate = false;
+        uint32_t m_current_index = 0;
+    };
+}
@@ -1,10 +1,12 @@
 #include "frame_manager.h"
 #include "common/logger.h"
+#include "common/profiler.h"
 #include "graphics/device.h"
 
 namespace Comet {
     FrameManager::FrameManager(Device& device, const uint32_t frame_slot_count)
-        : m_device(device), m_frame_slot_count(frame_slot_count) {
+        : m_device(device), m_frame_timeline(Semaphore::create_timeline(device, 0)),
+          m_frame_slot_count(frame_slot_count) {
         if(frame_slot_count == 0) {
             LOG_FATAL("FrameManager requires at least one frame slot");
         }
@@ -16,31 +18,41 @@ namespace Comet {
         for(uint32_t i = 0; i < frame_slot_count; ++i) {
             m_frame_slots.emplace_back(device, command_buffers.at(i));
         }
+        device.get_deletion_queue().set_current_frame(m_frame_number);
     }
 
-    void FrameManager::begin_frame() const {
-        const auto& fence = m_frame_slots.at(m_current_frame_slot).in_flight_fence;
-        m_device.wait_for_fences(std::span(&fence, 1));
+    void FrameManager::begin_frame() {
+        // 该帧槽上一次提交的帧完成后才能复用其 command buffer
+        if(m_frame_number > m_frame_slot_count) {
+            static_cast<void>(wait_for_frame(m_frame_number - m_frame_slot_count));
+        }
+
+        const auto destroyed = m_device.get_deletion_queue().collect(get_completed_frame());
+        PROFILE_COUNTER("FrameManager::deferred_destructions", static_cast<int64_t>(destroyed));
     }
 
     void FrameManager::prepare_image(const uint32_t image_index) {
+        // 该图像的 render finished 信号量可能仍被上一次使用它的帧占用
         auto& image_state = m_swapchain_image_states.at(image_index);
-        if(const auto previous_frame_slot = image_state.in_flight_frame_slot;
-           previous_frame_slot.has_value()) {
-            const auto& previous_fence =
-                m_frame_slots.at(*previous_frame_slot).in_flight_fence;
-            m_device.wait_for_fences(std::span(&previous_fence, 1));
+        if(image_state.last_frame != 0) {
+            static_cast<void>(wait_for_frame(image_state.last_frame));
         }
+        image_state.last_frame = m_frame_number;
+    }
 
-        auto& current_fence =
-            m_frame_slots.at(m_current_frame_slot).in_flight_fence;
-        m_device.reset_fences(std::span(&current_fence, 1));
-        image_state.in_flight_frame_slot = m_current_frame_slot;
+    bool FrameManager::wait_for_frame(const uint64_t frame, const uint64_t timeout) const {
+        if(frame >= m_frame_number) {
+            LOG_FATAL("Cannot wait for frame {} before it is submitted (current frame {})",
+                frame, m_frame_number);
+        }
+        return m_frame_timeline.wait(frame, timeout);
     }
 
     void FrameManager::end_frame() {
         m_current_frame_slot =
             (m_current_frame_slot + 1) % m_frame_slot_count;
+        ++m_frame_number;
+        m_device.get_deletion_queue().set_current_frame(m_frame_number);
     }
 
     void FrameManager::initialize_swapchain_images(const uint32_t image_count) {
@@ -50,6 +62,11 @@ namespace Comet {
 
         LOG_INFO("create {} swapchain image states for {} frame slots",
             image_count, m_frame_slot_count);
+        // Presents still in flight may wait on the old semaphores.
+        if(!m_swapchain_image_states.empty()) {
+            m_device.get_deletion_queue().retire(std::make_shared<std::vector<SwapchainImageState>>(
+                std::move(m_swapchain_image_states)));
+        }
         m_swapchain_image_states.clear();
         m_swapchain_image_states.reserve(image_count);
         for(uint32_t i = 0; i < image_count; ++i) {
@@ -1,35 +1,41 @@
 #pragma once
 #include "graphics/command_buffer.h"
-#include "graphics/fence.h"
 #include "graphics/semaphore.h"
-#include <optional>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 namespace Comet {
     struct FrameSlot {
-        Fence in_flight_fence;
         Semaphore image_available_semaphore;
         CommandBuffer command_buffer;
 
         FrameSlot(Device& device, const CommandBuffer& command_buffer)
-            : in_flight_fence(device),
-              image_available_semaphore(device),
+            : image_available_semaphore(device),
               command_buffer(command_buffer) {}
     };
 
     struct SwapchainImageState {
+        // Presentation can only wait on binary semaphores.
         Semaphore render_finished_semaphore;
-        std::optional<uint32_t> in_flight_frame_slot;
+        // Frame that last rendered into the image, 0 if none.
+        uint64_t last_frame = 0;
 
         explicit SwapchainImageState(Device& device)
             : render_finished_semaphore(device) {}
     };
 
+    // Paces frames with one timeline semaphore on the graphics queue: the
+    // submission of frame N signals value N, so any subsystem can wait for
+    // or poll the completion of a frame. Binary semaphores are only used
+    // where the swapchain requires them.
     class FrameManager {
     public:
         explicit FrameManager(Device& device, uint32_t frame_slot_count);
 
-        void begin_frame() const;
+        // Waits until the frame slot's previous frame has finished and
+        // destroys what completed frames released.
+        void begin_frame();
 
         void prepare_image(uint32_t image_index);
 
@@ -37,6 +43,15 @@ namespace Comet {
 
         void initialize_swapchain_images(uint32_t image_count);
 
+        // Blocks until `frame` has finished on the GPU. Returns false on timeout.
+        bool wait_for_frame(uint64_t frame, uint64_t timeout = std::numeric_limits<uint64_t>::max()) const;
+
+        // Latest frame finished on the GPU, 0 if none.
+        [[nodiscard]] uint64_t get_completed_frame() const { return m_frame_timeline.get_counter_value(); }
+        // Number of the frame being recorded; the first frame is 1. Its
+        // submission signals get_frame_timeline() with this value.
+        [[nodiscard]] uint64_t get_frame_number() const { return m_frame_number; }
+        [[nodiscard]] const Semaphore& get_frame_timeline() const { return m_frame_timeline; }
         [[nodiscard]] uint32_t get_current_frame_slot_index() const { return m_current_frame_slot; }
         [[nodiscard]] uint32_t get_frame_slot_count() const { return m_frame_slot_count; }
 
@@ -54,9 +69,11 @@ namespace Comet {
 
     private:
         Device& m_device;
+        Semaphore m_frame_timeline;
         std::vector<FrameSlot> m_frame_slots;
         std::vector<SwapchainImageState> m_swapchain_image_states;
         uint32_t m_current_frame_slot = 0;
         uint32_t m_frame_slot_count = 0;
+        uint64_t m_frame_number = 1;
     };
 }
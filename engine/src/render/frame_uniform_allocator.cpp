@@ -0,0 +1,76 @@
+#include "frame_uniform_allocator.h"
+
+#include "common/logger.h"
+#include "graphics/device.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Comet {
+    FrameUniformAllocator::FrameUniformAllocator(Device& device,
+                                                 const uint32_t frame_slot_count,
+                                                 const size_t region_size) {
+        if(frame_slot_count == 0 || region_size == 0) {
+            LOG_FATAL("FrameUniformAllocator requires at least one non-empty frame region");
+        }
+
+        const auto& capability = device.get_capability();
+        m_uniform_alignment = std::max<size_t>(capability.min_uniform_buffer_offset_alignment, 1);
+        m_storage_alignment = std::max<size_t>(capability.min_storage_buffer_offset_alignment, 1);
+
+        // Every region starts on an offset valid for both binding types.
+        m_region_size = LinearAllocator::align_up(
+            region_size, std::max(m_uniform_alignment, m_storage_alignment));
+        const size_t buffer_size = m_region_size * frame_slot_count;
+        if(buffer_size > std::numeric_limits<uint32_t>::max()) {
+            LOG_FATAL("FrameUniformAllocator size {} exceeds the range of dynamic offsets",
+                buffer_size);
+        }
+
+        m_buffer = Buffer::create_cpu_buffer(
+            device,
+            Flags<BufferUsage>(BufferUsage::Uniform) | BufferUsage::Storage,
+            buffer_size,
+            nullptr,
+            "frame uniform buffer");
+        m_mapped_data = static_cast<std::byte*>(
+            std::static_pointer_cast<CPUBuffer>(m_buffer)->get_mapped_data());
+        m_region.reset(0, m_region_size);
+    }
+
+    void FrameUniformAllocator::begin_frame(const uint32_t frame_slot_index) {
+        const size_t begin = m_region_size * frame_slot_index;
+        if(begin >= m_buffer->get_size()) {
+            LOG_FATAL("Frame slot {} has no region in the frame uniform buffer", frame_slot_index);
+        }
+        m_region.reset(begin, begin + m_region_size);
+    }
+
+    std::optional<FrameAllocation> FrameUniformAllocator::allocate_uniform(const size_t size) {
+        return allocate(size, m_uniform_alignment);
+    }
+
+    std::optional<FrameAllocation> FrameUniformAllocator::allocate_storage(const size_t size) {
+        return allocate(size, m_storage_alignment);
+    }
+
+    void FrameUniformAllocator::flush() const {
+        std::static_pointer_cast<CPUBuffer>(m_buffer)->flush(
+            m_region.get_begin(), m_region.get_used());
+    }
+
+    std::optional<FrameAllocation> FrameUniformAllocator::allocate(
+        const size_t size, const size_t alignment) {
+        const auto offset = m_region.allocate(size, alignment);
+        if(!offset) {
+            LOG_ERROR("Frame uniform region exhausted: {} of {} bytes used, {} requested",
+                m_region.get_used(), m_region_size, size);
+            return std::nullopt;
+        }
+        return FrameAllocation{
+            .data = m_mapped_data + *offset,
+            .offset = static_cast<uint32_t>(*offset),
+            .size = size
+        };
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "common/export.h"
+#include "core/linear_allocator.h"
+#include "graphics/buffer.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+
+namespace Comet {
+    class Device;
+
+    // Block handed out by FrameUniformAllocator. `offset` is the value to pass
+    // as the dynamic offset when binding the allocator's buffer.
+    struct FrameAllocation {
+        void* data = nullptr;
+        uint32_t offset = 0;
+        size_t size = 0;
+    };
+
+    // One persistently mapped buffer split into a region per frame slot.
+    // Blocks are bump-allocated from the current slot's region and released
+    // together when that slot is reused, so per-frame uniform and storage
+    // data needs no Vulkan allocations. Descriptors reference the buffer
+    // once and select a block through UniformBufferDynamic or
+    // StorageBufferDynamic offsets.
+    class COMET_API FrameUniformAllocator {
+    public:
+        FrameUniformAllocator(Device& device, uint32_t frame_slot_count, size_t region_size);
+
+        FrameUniformAllocator(const FrameUniformAllocator&) = delete;
+
+        FrameUniformAllocator& operator=(const FrameUniformAllocator&) = delete;
+
+        FrameUniformAllocator(FrameUniformAllocator&&) noexcept = delete;
+
+        FrameUniformAllocator& operator=(FrameUniformAllocator&&) noexcept = delete;
+
+        // Rewinds the region of `frame_slot_index`. The slot's previous frame
+        // must have retired, which FrameManager::begin_frame guarantees.
+        void begin_frame(uint32_t frame_slot_index);
+
+        [[nodiscard]] std::optional<FrameAllocation> allocate_uniform(size_t size);
+
+        [[nodiscard]] std::optional<FrameAllocation> allocate_storage(size_t size);
+
+        template<typename T>
+        [[nodiscard]] std::optional<FrameAllocation> push_uniform(const T& value) {
+            auto allocation = allocate_uniform(sizeof(T));
+            if(allocation) {
+                std::memcpy(allocation->data, &value, sizeof(T));
+            }
+            return allocation;
+        }
+
+        // Flushes everything allocated since begin_frame() as a single range.
+        void flush() const;
+
+        [[nodiscard]] const std::shared_ptr<Buffer>& get_buffer() const { return m_buffer; }
+        [[nodiscard]] size_t get_region_size() const { return m_region_size; }
+        [[nodiscard]] size_t get_used() const { return m_region.get_used(); }
+
+    private:
+        [[nodiscard]] std::optional<FrameAllocation> allocate(size_t size, size_t alignment);
+
+        std::shared_ptr<Buffer> m_buffer;
+        std::byte* m_mapped_data = nullptr;
+        LinearAllocator m_region;
+        size_t m_region_size = 0;
+        size_t m_uniform_alignment = 0;
+        size_t m_storage_alignment = 0;
+    };
+}
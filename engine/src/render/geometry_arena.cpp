@@ -0,0 +1,126 @@
+#include "geometry_arena.h"
+
+#include "common/logger.h"
+#include "common/profiler.h"
+#include "graphics/buffer.h"
+#include "graphics/command_buffer.h"
+#include "graphics/device.h"
+#include "graphics/upload_service.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace Comet {
+    GeometryArena::GeometryArena(Device& device, const uint32_t vertex_capacity, const uint32_t index_capacity)
+        : m_device(device), m_ranges(vertex_capacity, index_capacity) {
+        if(vertex_capacity == 0 || index_capacity == 0) {
+            LOG_FATAL("GeometryArena requires non-zero vertex and index capacities");
+        }
+        rebuild(vertex_capacity, index_capacity);
+    }
+
+    GeometryArena::~GeometryArena() = default;
+
+    GeometryHandle GeometryArena::allocate(const std::span<const Math::Vertex> vertices,
+                                           const std::span<const uint32_t> indices) {
+        PROFILE_SCOPE("GeometryArena::allocate");
+        if(vertices.empty()) {
+            LOG_ERROR("GeometryArena cannot allocate geometry without vertices");
+            return {};
+        }
+
+        const auto vertex_count = static_cast<uint32_t>(vertices.size());
+        const auto index_count = static_cast<uint32_t>(indices.size());
+        auto handle = m_ranges.allocate(vertex_count, index_count);
+        if(!handle) {
+            // Growth leaves a quarter of the buffer free so that a burst of
+            // allocations does not trigger a rebuild each.
+            const GeometryCapacity capacity = m_ranges.grown_capacity(vertex_count, index_count);
+            if(capacity.vertex > std::numeric_limits<uint32_t>::max()
+               || capacity.index > std::numeric_limits<uint32_t>::max()) {
+                LOG_FATAL("GeometryArena capacity {} / {} exceeds 32-bit element offsets",
+                    capacity.vertex, capacity.index);
+            }
+            rebuild(capacity.vertex, capacity.index);
+            handle = m_ranges.allocate(vertex_count, index_count);
+            if(!handle) {
+                LOG_FATAL("GeometryArena failed to allocate {} vertices and {} indices after growing",
+                    vertices.size(), indices.size());
+            }
+        }
+
+        const GeometryRange& range = m_ranges.get_range(*handle);
+        std::ranges::copy(vertices, m_vertices.begin() + range.vertex_offset);
+        auto& upload_service = m_device.get_upload_service();
+        static_cast<void>(upload_service.upload_buffer(
+            vertices.data(), vertices.size_bytes(), *m_vertex_buffer, range.vertex_offset * sizeof(Math::Vertex)));
+        if(!indices.empty()) {
+            std::ranges::copy(indices, m_indices.begin() + range.first_index);
+            static_cast<void>(upload_service.upload_buffer(
+                indices.data(), indices.size_bytes(), *m_index_buffer, range.first_index * sizeof(uint32_t)));
+        }
+        return *handle;
+    }
+
+    void GeometryArena::free(const GeometryHandle handle) {
+        m_ranges.free(handle);
+    }
+
+    void GeometryArena::bind(const CommandBuffer& command_buffer) const {
+        command_buffer.bind_vertex_buffer({*m_vertex_buffer, 0});
+        command_buffer.bind_index_buffer(*m_index_buffer, 0, vk::IndexType::eUint32);
+    }
+
+    void GeometryArena::compact() {
+        const GeometryArenaStats stats = m_ranges.get_stats();
+        rebuild(stats.vertex_capacity, stats.index_capacity);
+    }
+
+    void GeometryArena::rebuild(const size_t vertex_capacity, const size_t index_capacity) {
+        PROFILE_SCOPE("GeometryArena::rebuild");
+        auto& upload_service = m_device.get_upload_service();
+        if(m_vertex_buffer) {
+            // 旧缓冲可能仍被上传批次引用；在途的帧由删除队列保证
+            upload_service.wait(upload_service.flush());
+            upload_service.forget(*m_vertex_buffer);
+            upload_service.forget(*m_index_buffer);
+            auto& deletion_queue = m_device.get_deletion_queue();
+            deletion_queue.retire(std::move(m_vertex_buffer));
+            deletion_queue.retire(std::move(m_index_buffer));
+        }
+
+        std::vector<Math::Vertex> vertices(vertex_capacity);
+        std::vector<uint32_t> indices(index_capacity);
+        m_ranges.repack(vertex_capacity, index_capacity,
+            [&](const GeometryRange& from, const GeometryRange& to) {
+                std::copy_n(m_vertices.begin() + from.vertex_offset, from.vertex_count,
+                            vertices.begin() + to.vertex_offset);
+                std::copy_n(m_indices.begin() + from.first_index, from.index_count,
+                            indices.begin() + to.first_index);
+            });
+        m_vertices = std::move(vertices);
+        m_indices = std::move(indices);
+        const GeometryArenaStats stats = m_ranges.get_stats();
+        const size_t vertex_cursor = stats.vertex_used;
+        const size_t index_cursor = stats.index_used;
+
+        m_vertex_buffer = std::make_shared<GPUBuffer>(
+            m_device, Flags<BufferUsage>(BufferUsage::Vertex),
+            vertex_capacity * sizeof(Math::Vertex), nullptr, "geometry vertex buffer");
+        m_index_buffer = std::make_shared<GPUBuffer>(
+            m_device, Flags<BufferUsage>(BufferUsage::Index),
+            index_capacity * sizeof(uint32_t), nullptr, "geometry index buffer");
+        if(vertex_cursor > 0) {
+            static_cast<void>(upload_service.upload_buffer(
+                m_vertices.data(), vertex_cursor * sizeof(Math::Vertex), *m_vertex_buffer));
+        }
+        if(index_cursor > 0) {
+            static_cast<void>(upload_service.upload_buffer(
+                m_indices.data(), index_cursor * sizeof(uint32_t), *m_index_buffer));
+        }
+
+        LOG_INFO("Geometry arena: {} / {} vertices, {} / {} indices",
+            vertex_cursor, vertex_capacity, index_cursor, index_capacity);
+    }
+}
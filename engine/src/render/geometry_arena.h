@@ -0,0 +1,71 @@
+#pragma once
+
+#include "common/export.h"
+#include "core/geometry_range_allocator.h"
+#include "core/math_utils.h"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Comet {
+    class Buffer;
+    class CommandBuffer;
+    class Device;
+
+    // One device-local vertex buffer and one index buffer shared by every
+    // mesh, sub-allocated with best-fit free lists so draws only differ in
+    // vertex_offset/first_index. A CPU copy of the contents lets growth and
+    // compact() re-upload packed data without reading device memory back.
+    // Both replace the buffers, so they must not run while a frame that
+    // binds the arena is being recorded.
+    class COMET_API GeometryArena {
+    public:
+        GeometryArena(Device& device, uint32_t vertex_capacity, uint32_t index_capacity);
+
+        ~GeometryArena();
+
+        GeometryArena(const GeometryArena&) = delete;
+
+        GeometryArena& operator=(const GeometryArena&) = delete;
+
+        GeometryArena(GeometryArena&&) noexcept = delete;
+
+        GeometryArena& operator=(GeometryArena&&) noexcept = delete;
+
+        // Grows both buffers when the free lists cannot fit the request.
+        [[nodiscard]] GeometryHandle allocate(std::span<const Math::Vertex> vertices,
+                                              std::span<const uint32_t> indices);
+
+        // The range becomes reusable immediately; the GPU must no longer read
+        // it. Owners of live geometry defer this through the device's
+        // DeletionQueue.
+        void free(GeometryHandle handle);
+
+        [[nodiscard]] const GeometryRange& get_range(GeometryHandle handle) const {
+            return m_ranges.get_range(handle);
+        }
+
+        void bind(const CommandBuffer& command_buffer) const;
+
+        // Packs live ranges to the front of fresh buffers, removing every
+        // free-list gap. Waits only for pending uploads; the old buffers are
+        // retired to the DeletionQueue for frames still in flight.
+        void compact();
+
+        [[nodiscard]] GeometryArenaStats get_stats() const { return m_ranges.get_stats(); }
+
+        [[nodiscard]] Device& get_device() const { return m_device; }
+
+    private:
+        void rebuild(size_t vertex_capacity, size_t index_capacity);
+
+        Device& m_device;
+        std::shared_ptr<Buffer> m_vertex_buffer;
+        std::shared_ptr<Buffer> m_index_buffer;
+        GeometryRangeAllocator m_ranges;
+        std::vector<Math::Vertex> m_vertices;
+        std::vector<uint32_t> m_indices;
+    };
+}
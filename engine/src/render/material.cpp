@@ -2,6 +2,7 @@
 
 #include <utility>
 #include "common/logger.h"
+#include "core/stable_hash.h"
 
 namespace Comet {
     void MaterialConfig::set_blend_op(const BlendOp color_op, const BlendOp alpha_op) {
@@ -17,6 +18,39 @@ namespace Comet {
         m_dst_alpha_blend_factor = dst_alpha;
     }
 
+    void MaterialConfig::apply_to(PipelineConfig& config) const {
+        config.set_input_assembly_state(m_topology);
+        config.rasterization_state.cull_mode = m_cull_mode;
+        config.rasterization_state.polygon_mode = m_polygon_mode;
+        config.depth_stencil_state.depth_test_enable = m_depth_test_enable;
+        config.depth_stencil_state.depth_write_enable = m_depth_write_enable;
+        config.depth_stencil_state.depth_compare_op = m_depth_compare_op;
+        config.set_color_blend_attachment_state(PipelineColorBlendState{
+            .blend_enable = m_alpha_blend_enable,
+            .src_color_blend_factor = m_src_color_blend_factor,
+            .dst_color_blend_factor = m_dst_color_blend_factor,
+            .color_blend_op = m_color_blend_op,
+            .src_alpha_blend_factor = m_src_alpha_blend_factor,
+            .dst_alpha_blend_factor = m_dst_alpha_blend_factor,
+            .alpha_blend_op = m_alpha_blend_op
+        });
+    }
+
+    uint64_t MaterialConfig::get_state_hash() const {
+        StableHasher hasher;
+        hasher.add(m_vertex_shader ? std::string_view(m_vertex_shader->get_name()) : std::string_view());
+        hasher.add(m_fragment_shader ? std::string_view(m_fragment_shader->get_name()) : std::string_view());
+        hasher.add(m_cull_mode).add(m_polygon_mode).add(m_topology);
+        hasher.add(m_depth_test_enable).add(m_depth_write_enable).add(m_depth_compare_op);
+        hasher.add(m_alpha_blend_enable);
+        if(m_alpha_blend_enable) {
+            hasher.add(m_color_blend_op).add(m_alpha_blend_op)
+                  .add(m_src_color_blend_factor).add(m_dst_color_blend_factor)
+                  .add(m_src_alpha_blend_factor).add(m_dst_alpha_blend_factor);
+        }
+        return hasher.get();
+    }
+
     Material::Material(std::string name, const MaterialConfig& config)
         : m_name(std::move(name)), m_config(config) {}
 
@@ -57,6 +57,15 @@ namespace Comet {
         void set_blend_factors(BlendFactor src_color, BlendFactor dst_color,
                                BlendFactor src_alpha = BlendFactor::One, BlendFactor dst_alpha = BlendFactor::Zero);
 
+        // Overwrites the topology, rasterization, depth and blend state of
+        // `config` with this material's; everything else is left as is.
+        void apply_to(PipelineConfig& config) const;
+
+        // Stable hash of the shader names and of the state apply_to() writes.
+        // Blend factors and ops only count while blending is enabled, so
+        // configs that draw identically hash identically.
+        [[nodiscard]] uint64_t get_state_hash() const;
+
         [[nodiscard]] const std::shared_ptr<Shader>& get_vertex_shader() const { return m_vertex_shader; }
         [[nodiscard]] const std::shared_ptr<Shader>& get_fragment_shader() const { return m_fragment_shader; }
         [[nodiscard]] CullMode get_cull_mode() const { return m_cull_mode; }
@@ -102,7 +111,13 @@ namespace Comet {
 
         [[nodiscard]] const std::string& get_name() const { return m_name; }
         [[nodiscard]] const MaterialConfig& get_config() const { return m_config; }
-        [[nodiscard]] MaterialConfig& get_config_mut() { return m_config; }
+        // Bumps the config version; fetch it again for each later edit so
+        // pipelines keyed on the old state get rebuilt.
+        [[nodiscard]] MaterialConfig& get_config_mut() {
+            ++m_config_version;
+            return m_config;
+        }
+        [[nodiscard]] uint64_t get_config_version() const { return m_config_version; }
 
         void set_property(const std::string& name, float value);
 
@@ -130,6 +145,7 @@ namespace Comet {
     private:
         std::string m_name;
         MaterialConfig m_config;
+        uint64_t m_config_version = 0;
         std::map<std::string, MaterialProperty> m_properties;
     };
 
@@ -1,34 +1,42 @@
 #include "mesh.h"
 
+#include "common/logger.h"
+#include "graphics/command_buffer.h"
+#include "graphics/deletion_queue.h"
+#include "graphics/device.h"
+
 namespace Comet {
-    Mesh::Mesh(Device& device, const std::vector<Math::Vertex>& vertices, const std::vector<uint32_t>& indices)
-    : m_vertex_count(vertices.size()), m_index_count(indices.size()) {
+    Mesh::Mesh(std::shared_ptr<GeometryArena> arena,
+               const std::vector<Math::Vertex>& vertices,
+               const std::vector<uint32_t>& indices)
+    : m_arena(std::move(arena)), m_bounds(Math::compute_bounds(vertices)) {
         if(vertices.empty()) {
             LOG_FATAL("vertices array is empty, can't create mesh");
         }
-        m_vertex_buffer = Buffer::create_gpu_buffer(device, Flags<BufferUsage>(BufferUsage::Vertex),
-            vertices.size() * sizeof(Math::Vertex), vertices.data(), "mesh vertex buffer");
-        if(!indices.empty()) {
-            m_index_buffer = Buffer::create_gpu_buffer(device, Flags<BufferUsage>(BufferUsage::Index),
-                indices.size() * sizeof(uint32_t), indices.data(), "mesh index buffer");
-        } else {
-            m_index_buffer.reset();
-        }
+        m_geometry = m_arena->allocate(vertices, indices);
     }
 
     Mesh::~Mesh() {
-        m_vertex_buffer.reset();
-        m_index_buffer.reset();
+        if(m_geometry.is_valid()) {
+            // Frames in flight may still draw the range, so it is only
+            // returned to the arena once they have completed.
+            m_arena->get_device().get_deletion_queue().push(
+                [arena = m_arena, geometry = m_geometry]() { arena->free(geometry); });
+        }
     }
 
-    void Mesh::draw(const CommandBuffer& command_buffer) const {
-        command_buffer.bind_vertex_buffer({*m_vertex_buffer, 0});
+    void Mesh::bind(const CommandBuffer& command_buffer) const {
+        m_arena->bind(command_buffer);
+    }
 
-        if(m_index_count > 0) {
-            command_buffer.bind_index_buffer(*m_index_buffer, 0, vk::IndexType::eUint32);
-            command_buffer.draw_indexed(m_index_count, 1, 0, 0);
+    void Mesh::draw(const CommandBuffer& command_buffer,
+                    const uint32_t instance_count, const uint32_t first_instance) const {
+        const GeometryRange& range = get_geometry_range();
+        if(range.index_count > 0) {
+            command_buffer.draw_indexed(range.index_count, instance_count, range.first_index,
+                static_cast<int32_t>(range.vertex_offset), first_instance);
         } else {
-            command_buffer.draw(m_vertex_count, 1, 0, 0);
+            command_buffer.draw(range.vertex_count, instance_count, range.vertex_offset, first_instance);
         }
     }
 
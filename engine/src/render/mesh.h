@@ -1,23 +1,43 @@
 #pragma once
 #include "common/export.h"
-#include "graphics/buffer.h"
 #include "common/geometry_utils.h"
-#include "graphics/device.h"
+#include "core/bounds.h"
+#include "geometry_arena.h"
+
+#include <memory>
+#include <vector>
 
 namespace Comet {
+    class CommandBuffer;
 
     class COMET_API Mesh {
     public:
-        Mesh(Device& device, const std::vector<Math::Vertex>& vertices, const std::vector<uint32_t>& indices = {});
+        Mesh(std::shared_ptr<GeometryArena> arena,
+             const std::vector<Math::Vertex>& vertices,
+             const std::vector<uint32_t>& indices = {});
         ~Mesh();
 
-        void draw(const CommandBuffer& command_buffer) const;
+        Mesh(const Mesh&) = delete;
+
+        Mesh& operator=(const Mesh&) = delete;
+
+        // Binds the arena's shared vertex and index buffers; every mesh of the
+        // same arena can be drawn after a single bind.
+        void bind(const CommandBuffer& command_buffer) const;
+
+        void draw(const CommandBuffer& command_buffer,
+                  uint32_t instance_count = 1, uint32_t first_instance = 0) const;
+
+        [[nodiscard]] const GeometryArena& get_geometry_arena() const { return *m_arena; }
+        [[nodiscard]] const GeometryRange& get_geometry_range() const { return m_arena->get_range(m_geometry); }
+
+        // Local-space bounds of the vertices the mesh was built from.
+        [[nodiscard]] const Math::BoundingVolume& get_bounds() const { return m_bounds; }
 
     private:
-        std::shared_ptr<Buffer> m_vertex_buffer;
-        std::shared_ptr<Buffer> m_index_buffer;
-        uint32_t m_vertex_count;
-        uint32_t m_index_count;
+        std::shared_ptr<GeometryArena> m_arena;
+        GeometryHandle m_geometry;
+        Math::BoundingVolume m_bounds;
     };
 
 }
@@ -3,6 +3,8 @@
 #include "common/profiler.h"
 #include "graphics/convert.h"
 
+#include <filesystem>
+
 namespace Comet {
     RenderContext::RenderContext(const Window& window, const Config::Vulkan& vulkan_config, const Config::Render& render_config) {
         PROFILE_SCOPE("RenderContext::Constructor");
@@ -31,7 +33,12 @@ namespace Comet {
         m_context = std::make_unique<Context>(window, vulkan_config, capability_request);
 
         LOG_INFO("create device");
-        m_device = std::make_unique<Device>(*m_context);
+        Device::CreateInfo device_create_info;
+        if(!vulkan_config.pipeline_cache_dir.empty()) {
+            device_create_info.pipeline_cache_path =
+                (std::filesystem::path(vulkan_config.pipeline_cache_dir) / "pipeline_cache.bin").string();
+        }
+        m_device = std::make_unique<Device>(*m_context, device_create_info);
 
         LOG_INFO("create swapchain");
         m_swapchain = std::make_unique<Swapchain>(
@@ -0,0 +1,152 @@
+#include "render_queue.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace Comet {
+    namespace {
+        constexpr std::uint64_t field(const std::uint32_t value, const std::uint32_t bits) {
+            return value & ((std::uint64_t{1} << bits) - 1);
+        }
+
+        constexpr std::uint32_t DEPTH_MASK = (1u << RenderQueue::DEPTH_BITS) - 1;
+        constexpr std::uint32_t MAX_ID = (1u << RenderQueue::ID_BITS) - 1;
+        constexpr std::uint32_t MAX_PIPELINE_ID = (1u << RenderQueue::PIPELINE_BITS) - 1;
+        // Blended items must stay in depth order across pipelines, so they
+        // all share one pipeline field.
+        constexpr std::uint32_t BLENDED_PIPELINE = 1;
+    }
+
+    std::uint32_t RenderQueue::quantize_depth(const float view_depth) {
+        if(!(view_depth > 0.0f)) {
+            return 0;
+        }
+        // Positive floats order like their bit patterns; keeping the top
+        // bits gives a logarithmic quantisation without knowing the far plane.
+        return std::min(std::bit_cast<std::uint32_t>(view_depth) >> (32 - DEPTH_BITS - 1),
+                        DEPTH_MASK);
+    }
+
+    std::uint64_t RenderQueue::make_opaque_key(const std::uint32_t pipeline,
+                                               const std::uint32_t material,
+                                               const std::uint32_t mesh,
+                                               const std::uint32_t depth) {
+        // [63] bucket | [62:56] pipeline | [55:40] material | [39:24] mesh | [23:0] depth
+        return field(pipeline, PIPELINE_BITS) << 56
+               | field(material, ID_BITS) << 40
+               | field(mesh, ID_BITS) << 24
+               | field(depth, DEPTH_BITS);
+    }
+
+    std::uint64_t RenderQueue::make_blended_key(const std::uint32_t pipeline,
+                                                const std::uint32_t material,
+                                                const std::uint32_t mesh,
+                                                const std::uint32_t depth) {
+        // [63] bucket | [62:56] pipeline | [55:32] inverted depth | [31:16] material | [15:0] mesh
+        return std::uint64_t{1} << 63
+               | field(pipeline, PIPELINE_BITS) << 56
+               | field(DEPTH_MASK - std::min(depth, DEPTH_MASK), DEPTH_BITS) << 32
+               | field(material, ID_BITS) << 16
+               | field(mesh, ID_BITS);
+    }
+
+    void RenderQueue::build(const std::span<const ResolvedRenderItem> items,
+                            const Math::Mat4& view_matrix,
+                            const PipelineKeyFunction& pipeline_key) {
+        m_draws.clear();
+        m_entries.clear();
+        m_material_ids.clear();
+        m_pipeline_ids.clear();
+        m_mesh_ids.clear();
+        m_entries.reserve(items.size());
+
+        // Only the depth row of the view matrix is needed per item.
+        const Math::Vec4 depth_row(-view_matrix[0][2], -view_matrix[1][2],
+                                   -view_matrix[2][2], -view_matrix[3][2]);
+        for(std::size_t index = 0; index < items.size(); ++index) {
+            const ResolvedRenderItem& item = items[index];
+            const Math::Vec4& origin = item.model_matrix[3];
+            const float view_depth = depth_row.x * origin.x + depth_row.y * origin.y
+                                     + depth_row.z * origin.z + depth_row.w * origin.w;
+            const std::uint32_t depth = quantize_depth(view_depth);
+            const MaterialIds material = material_ids(item.material, pipeline_key);
+            const std::uint32_t mesh = mesh_id(item.mesh.get());
+
+            m_entries.push_back({
+                .key = item.material.alpha_blend
+                           ? make_blended_key(BLENDED_PIPELINE, material.material, mesh, depth)
+                           : make_opaque_key(material.pipeline, material.material, mesh, depth),
+                .item_index = static_cast<std::uint32_t>(index)
+            });
+        }
+        sort_entries();
+
+        m_instance_matrices.resize(m_entries.size());
+        for(std::size_t position = 0; position < m_entries.size(); ++position) {
+            const ResolvedRenderItem& item = items[m_entries[position].item_index];
+            m_instance_matrices[position] = item.model_matrix;
+
+            if(!m_draws.empty()) {
+                RenderDraw& draw = m_draws.back();
+                if(draw.first_item->mesh == item.mesh
+                   && draw.first_item->material.material_handle == item.material.material_handle
+                   && draw.alpha_blend == item.material.alpha_blend) {
+                    ++draw.instance_count;
+                    continue;
+                }
+            }
+            m_draws.push_back({
+                .first_item = &item,
+                .first_instance = static_cast<std::uint32_t>(position),
+                .instance_count = 1,
+                .alpha_blend = item.material.alpha_blend
+            });
+        }
+    }
+
+    void RenderQueue::sort_entries() {
+        m_scratch.resize(m_entries.size());
+        for(std::uint32_t shift = 0; shift < 64; shift += 8) {
+            std::array<std::uint32_t, 256> offsets{};
+            for(const SortEntry& entry: m_entries) {
+                ++offsets[(entry.key >> shift) & 0xff];
+            }
+            if(std::ranges::find(offsets, static_cast<std::uint32_t>(m_entries.size()))
+               != offsets.end()) {
+                continue;
+            }
+
+            std::uint32_t running = 0;
+            for(std::uint32_t& offset: offsets) {
+                const std::uint32_t count = offset;
+                offset = running;
+                running += count;
+            }
+            for(const SortEntry& entry: m_entries) {
+                m_scratch[offsets[(entry.key >> shift) & 0xff]++] = entry;
+            }
+            m_entries.swap(m_scratch);
+        }
+    }
+
+    RenderQueue::MaterialIds RenderQueue::material_ids(const MaterialBinding& material,
+                                                       const PipelineKeyFunction& pipeline_key) {
+        const auto [entry, inserted] = m_material_ids.try_emplace(material.material_handle);
+        if(inserted) {
+            entry->second.material =
+                std::min(static_cast<std::uint32_t>(m_material_ids.size() - 1), MAX_ID);
+            const std::uint64_t key = pipeline_key ? pipeline_key(material) : 0;
+            const auto [pipeline, added] = m_pipeline_ids.try_emplace(
+                key, std::min(static_cast<std::uint32_t>(m_pipeline_ids.size()), MAX_PIPELINE_ID));
+            entry->second.pipeline = pipeline->second;
+        }
+        return entry->second;
+    }
+
+    std::uint32_t RenderQueue::mesh_id(const Mesh* mesh) {
+        const auto [entry, inserted] = m_mesh_ids.try_emplace(
+            mesh, std::min(static_cast<std::uint32_t>(m_mesh_ids.size()), MAX_ID));
+        return entry->second;
+    }
+}
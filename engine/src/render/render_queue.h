@@ -0,0 +1,94 @@
+#pragma once
+
+#include "common/export.h"
+#include "render_submission.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Comet {
+    // Run of consecutive queue entries sharing pipeline, mesh and material,
+    // recorded as one instanced draw.
+    struct RenderDraw {
+        const ResolvedRenderItem* first_item = nullptr;
+        std::uint32_t first_instance = 0;
+        std::uint32_t instance_count = 0;
+        bool alpha_blend = false;
+    };
+
+    // Orders resolved items by packed 64-bit sort keys. Opaque items come
+    // first, grouped by pipeline state, material and mesh and then front to
+    // back; alpha-blended items follow, back to front. Adjacent items with the
+    // same state collapse into one instanced draw whose model matrices are
+    // contiguous in get_instance_matrices(). Storage is reused between frames.
+    class COMET_API RenderQueue {
+    public:
+        static constexpr std::uint32_t DEPTH_BITS = 24;
+        static constexpr std::uint32_t ID_BITS = 16;
+        static constexpr std::uint32_t PIPELINE_BITS = 7;
+
+        // Maps a material to the key of the pipeline state it draws with.
+        // Materials with equal keys share a pipeline.
+        using PipelineKeyFunction = std::function<std::uint64_t(const MaterialBinding&)>;
+
+        // Monotonic in view-space depth; items behind the camera map to 0.
+        [[nodiscard]] static std::uint32_t quantize_depth(float view_depth);
+
+        [[nodiscard]] static std::uint64_t make_opaque_key(std::uint32_t pipeline,
+                                                           std::uint32_t material,
+                                                           std::uint32_t mesh,
+                                                           std::uint32_t depth);
+
+        [[nodiscard]] static std::uint64_t make_blended_key(std::uint32_t pipeline,
+                                                            std::uint32_t material,
+                                                            std::uint32_t mesh,
+                                                            std::uint32_t depth);
+
+        // Without `pipeline_key` every opaque material is assumed to share
+        // one pipeline.
+        void build(std::span<const ResolvedRenderItem> items, const Math::Mat4& view_matrix,
+                   const PipelineKeyFunction& pipeline_key = {});
+
+        [[nodiscard]] const std::vector<RenderDraw>& get_draws() const { return m_draws; }
+
+        [[nodiscard]] const std::vector<Math::Mat4>& get_instance_matrices() const {
+            return m_instance_matrices;
+        }
+
+    private:
+        struct SortEntry {
+            std::uint64_t key = 0;
+            std::uint32_t item_index = 0;
+        };
+
+        // Stable LSD radix sort over 8-bit digits; digits shared by every
+        // key are skipped.
+        void sort_entries();
+
+        struct MaterialIds {
+            std::uint32_t material = 0;
+            std::uint32_t pipeline = 0;
+        };
+
+        [[nodiscard]] MaterialIds material_ids(const MaterialBinding& material,
+                                               const PipelineKeyFunction& pipeline_key);
+
+        [[nodiscard]] std::uint32_t mesh_id(const Mesh* mesh);
+
+        std::vector<RenderDraw> m_draws;
+        std::vector<Math::Mat4> m_instance_matrices;
+        std::vector<SortEntry> m_entries;
+        std::vector<SortEntry> m_scratch;
+
+        // Dense per-frame ids keep pipeline, material and mesh fields small.
+        // Ids saturate, which only weakens grouping: draws are split on the
+        // actual mesh and material, never on the key.
+        std::unordered_map<AssetHandle, MaterialIds> m_material_ids;
+        std::unordered_map<std::uint64_t, std::uint32_t> m_pipeline_ids;
+        std::unordered_map<const Mesh*, std::uint32_t> m_mesh_ids;
+    };
+}
@@ -4,6 +4,7 @@
 #include "core/math_utils.h"
 #include "scene/entity_id.h"
 
+#include <cstdint>
 #include <vector>
 
 namespace Comet {
@@ -23,8 +24,31 @@ namespace Comet {
         AssetHandle material_handle = INVALID_ASSET_HANDLE;
     };
 
+    // Incrementally extracted scenes keep one slot per entity. Free slots
+    // are left in place with an invalid entity id and are skipped by consumers.
     struct RenderScene {
         std::vector<RenderCamera> cameras;
         std::vector<RenderItem> render_items;
     };
+
+    // Render item slots touched by one incremental extraction. A slot freed
+    // and reused in the same extraction appears in both removed and added.
+    struct RenderSceneChanges {
+        std::vector<std::uint32_t> added_items;
+        std::vector<std::uint32_t> removed_items;
+        std::vector<std::uint32_t> modified_items;
+        bool cameras_changed = false;
+
+        void clear() {
+            added_items.clear();
+            removed_items.clear();
+            modified_items.clear();
+            cameras_changed = false;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return added_items.empty() && removed_items.empty()
+                   && modified_items.empty() && !cameras_changed;
+        }
+    };
 }
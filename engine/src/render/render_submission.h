@@ -6,17 +6,23 @@
 #include "scene/entity_id.h"
 
 #include <array>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <vector>
 
 namespace Comet {
+    class Material;
     class Mesh;
     class Texture;
 
     struct MaterialBinding {
         AssetHandle material_handle = INVALID_ASSET_HANDLE;
+        // Source of the pipeline state; nullptr draws with the default pipeline.
+        std::shared_ptr<const Material> material;
         std::array<std::shared_ptr<Texture>, 2> textures;
+        // Blended materials are drawn after opaque ones, back to front.
+        bool alpha_blend = false;
     };
 
     struct ResolvedRenderItem {
@@ -29,5 +35,7 @@ namespace Comet {
     struct RenderSubmission {
         std::optional<ViewProjectMatrix> view_project_matrix;
         std::vector<ResolvedRenderItem> render_items;
+        // Items dropped because their bounds lie outside the camera frustum.
+        std::size_t culled_item_count = 0;
     };
 }
@@ -5,10 +5,15 @@
 #include "graphics/vertex_description.h"
 
 namespace Comet {
+    namespace {
+        constexpr std::chrono::seconds PIPELINE_CACHE_SAVE_INTERVAL{60};
+    }
+
     Renderer::Renderer(const Window& window,
                        const Config& config,
                        const AssetRegistry& asset_registry)
         : m_scene_resolver(asset_registry),
+          m_last_pipeline_cache_save(std::chrono::steady_clock::now()),
           m_vulkan_config(config.vulkan),
           m_render_config(config.render) {
         PROFILE_SCOPE("Renderer::Constructor");
@@ -19,15 +24,16 @@ namespace Comet {
         // Create resource manager
         LOG_INFO("create resource manager");
         m_resource_manager = std::make_unique<ResourceManager>(
-            m_render_context->get_device());
+            m_render_context->get_device(), config.threading.texture_decode_threads);
 
         // Create scene renderer
         LOG_INFO("create scene renderer");
         m_scene_renderer = std::make_unique<SceneRenderer>(
-            *m_render_context, m_vulkan_config, m_render_config);
+            *m_render_context, m_vulkan_config, m_render_config,
+            config.threading.pipeline_compile_threads);
 
-        // Setup render pass (moved to SceneRenderer)
-        m_scene_renderer->setup_render_pass();
+        // Setup swapchain rendering (moved to SceneRenderer)
+        m_scene_renderer->setup_rendering();
 
         // Setup pipeline
         setup_pipeline();
@@ -36,7 +42,7 @@ namespace Comet {
     void Renderer::setup_pipeline() {
         // 创建 DescriptorSetLayout bindings
         DescriptorSetLayoutBindings bindings;
-        bindings.add_binding(0, DescriptorType::UniformBuffer, Flags<ShaderStage>(ShaderStage::Vertex));
+        bindings.add_binding(0, DescriptorType::UniformBufferDynamic, Flags<ShaderStage>(ShaderStage::Vertex));
         bindings.add_binding(2, DescriptorType::CombinedImageSampler, Flags<ShaderStage>(ShaderStage::Fragment));
         bindings.add_binding(3, DescriptorType::CombinedImageSampler, Flags<ShaderStage>(ShaderStage::Fragment));
 
@@ -46,8 +52,6 @@ namespace Comet {
         // 创建 ShaderLayout（包含 DescriptorSetLayout）
         ShaderLayout layout = {};
         layout.descriptor_set_layouts.push_back(descriptor_set_layout);
-        layout.push_constants.push_back(std::make_shared<PushConstantRange>(
-            ShaderStage::Vertex, 0, sizeof(PushConstant)));
 
         // 创建 VertexInputDescription
         VertexInputDescription vertex_input_description;
@@ -55,11 +59,19 @@ namespace Comet {
         vertex_input_description.add_attribute(0, 0, Format::R32G32B32_SFLOAT, offsetof(Math::Vertex, position));
         vertex_input_description.add_attribute(1, 0, Format::R32G32_SFLOAT, offsetof(Math::Vertex, texcoord));
         vertex_input_description.add_attribute(2, 0, Format::R32G32B32_SFLOAT, offsetof(Math::Vertex, normal));
+        // 实例模型矩阵，每列占用一个 location
+        vertex_input_description.add_binding(1, sizeof(Math::Mat4), VertexInputRate::Instance);
+        for(uint32_t column = 0; column < 4; ++column) {
+            vertex_input_description.add_attribute(
+                3 + column, 1, Format::R32G32B32A32_SFLOAT, column * sizeof(Math::Vec4));
+        }
 
         // 创建 PipelineConfig
         PipelineConfig pipeline_config = {};
         pipeline_config.set_vertex_input_state(vertex_input_description);
         pipeline_config.set_input_assembly_state(Topology::TriangleList);
+        // 投影矩阵未翻转 Y 轴，逆时针建模的三角形在帧缓冲中为顺时针
+        pipeline_config.rasterization_state.front_face = FrontFace::CW;
 
         const auto msaa_samples = m_vulkan_config.msaa_samples;
 
@@ -70,11 +82,25 @@ namespace Comet {
         // 让 SceneRenderer 创建 Pipeline
         m_scene_renderer->setup_pipeline(
             *m_resource_manager, layout, vertex_input_description, pipeline_config);
+        // 预编译已注册材质的管线
+        precompile_pipelines();
+    }
+
+    void Renderer::precompile_pipelines() {
+        m_scene_renderer->precompile_pipelines(m_resource_manager->get_material_manager());
     }
 
     void Renderer::on_render(const RenderScene& render_scene) {
         PROFILE_SCOPE("render frame");
 
+        // Textures created here join the upload batch the frame waits on
+        m_resource_manager->update();
+        // Pipelines compiled in the background since the last frame
+        m_scene_renderer->update_pipelines();
+        if(m_startup_pending) {
+            report_startup_time();
+        }
+
         // Begin frame (acquires image and begins command buffer)
         if(!m_scene_renderer->begin_frame()) {
             return;
@@ -91,12 +117,44 @@ namespace Comet {
 
         // End frame (submits and presents)
         m_scene_renderer->end_frame();
+
+        // Keep the on-disk pipeline cache close to current in case the
+        // process does not shut down cleanly. Reading back and writing the
+        // cache can take milliseconds, so it happens off the render thread.
+        const auto now = std::chrono::steady_clock::now();
+        if(now - m_last_pipeline_cache_save >= PIPELINE_CACHE_SAVE_INTERVAL) {
+            m_render_context->get_device().save_pipeline_cache_async();
+            m_last_pipeline_cache_save = now;
+        }
+    }
+
+    void Renderer::report_startup_time() {
+        // 启动耗时：从创建设备到预编译的管线全部就绪，用于对比冷/热管线缓存
+        if(m_scene_renderer->get_pipeline_manager().get_stats().pending > 0) {
+            return;
+        }
+        m_startup_pending = false;
+        const Device& device = m_render_context->get_device();
+        const auto startup_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - device.get_creation_time()).count();
+        PROFILE_COUNTER("Renderer::startup_us", static_cast<int64_t>(startup_us));
+        LOG_INFO("Startup took {:.2f} ms from device creation to precompiled pipelines ({} pipeline cache)",
+            static_cast<double>(startup_us) / 1000.0,
+            device.is_pipeline_cache_warm() ? "warm" : "cold");
     }
 
     void Renderer::enable_viewport_rendering(const Math::Vec2u initial_size) {
-        m_render_context->wait_idle();
-        m_scene_renderer->setup_viewport_render_pass(initial_size);
-        setup_pipeline();
+        // Pipelines are kept: the viewport target has the swapchain's formats.
+        // The swapchain target's images are released through the deletion
+        // queue, so the GPU is not drained.
+        const auto switch_start = std::chrono::steady_clock::now();
+        m_scene_renderer->setup_viewport_rendering(initial_size);
+
+        const auto switch_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - switch_start).count();
+        PROFILE_COUNTER("Renderer::viewport_mode_switch_us", static_cast<int64_t>(switch_us));
+        LOG_INFO("switched to viewport rendering in {:.2f} ms",
+            static_cast<double>(switch_us) / 1000.0);
     }
 
     void Renderer::request_viewport_resize(const Math::Vec2u size) const {
@@ -7,6 +7,7 @@
 #include "resource_manager.h"
 #include "scene_renderer.h"
 
+#include <chrono>
 #include <functional>
 #include <memory>
 
@@ -27,6 +28,10 @@ namespace Comet {
 
         void request_viewport_resize(Math::Vec2u size) const;
 
+        // Starts compiling the pipelines of all registered materials in the
+        // background. Call after loading materials.
+        void precompile_pipelines();
+
         using ImGuiRenderDelegate = std::function<void(CommandBuffer&)>;
 
         void set_on_imgui_render(ImGuiRenderDelegate delegate) {
@@ -43,11 +48,18 @@ namespace Comet {
     private:
         void setup_pipeline();
 
+        // Logs the time from device creation until the first frame with no
+        // pipeline compile pending, then clears m_startup_pending.
+        void report_startup_time();
+
         std::unique_ptr<RenderContext> m_render_context;
         std::unique_ptr<ResourceManager> m_resource_manager;
         std::unique_ptr<SceneRenderer> m_scene_renderer;
         SceneResolver m_scene_resolver;
         ImGuiRenderDelegate m_on_imgui_render;
+        std::chrono::steady_clock::time_point m_last_pipeline_cache_save;
+        // Cleared once startup time has been reported.
+        bool m_startup_pending = true;
 
         Config::Vulkan m_vulkan_config;
         Config::Render m_render_config;
@@ -1,8 +1,16 @@
 #include "resource_manager.h"
 #include "common/logger.h"
+#include "texture_compression.h"
 
 namespace Comet {
-    ResourceManager::ResourceManager(Device& device) : m_device(device) {
+    namespace {
+        // Starting sizes of the shared geometry buffers; the arena doubles
+        // them when they run out.
+        constexpr uint32_t INITIAL_GEOMETRY_VERTEX_CAPACITY = 64 * 1024;
+        constexpr uint32_t INITIAL_GEOMETRY_INDEX_CAPACITY = 256 * 1024;
+    }
+
+    ResourceManager::ResourceManager(Device& device, const uint32_t texture_decode_threads) : m_device(device) {
         LOG_INFO("create shader manager");
         m_shader_manager = std::make_unique<ShaderManager>(device);
         
@@ -11,6 +19,13 @@ namespace Comet {
 
         LOG_INFO("create material manager");
         m_material_manager = std::make_unique<MaterialManager>();
+
+        LOG_INFO("create geometry arena");
+        m_geometry_arena = std::make_shared<GeometryArena>(
+            device, INITIAL_GEOMETRY_VERTEX_CAPACITY, INITIAL_GEOMETRY_INDEX_CAPACITY);
+
+        LOG_INFO("create texture loader");
+        m_texture_loader = std::make_unique<TextureLoader>(device, texture_decode_threads);
     }
 
     ResourceManager::~ResourceManager() = default;
@@ -20,18 +35,43 @@ namespace Comet {
             return m_textures.find(path)->second;
         }
         
-        auto texture = std::make_shared<Texture>(m_device, path);
+        std::shared_ptr<Texture> texture;
+        if(path.ends_with(".ctex")) {
+            CompressedTexture compressed;
+            if(!load_compressed_texture(path, compressed)) {
+                LOG_FATAL("Failed to load compressed texture from path: {}", path);
+            }
+            texture = std::make_shared<Texture>(m_device, compressed);
+        } else {
+            texture = std::make_shared<Texture>(m_device, path);
+        }
         m_textures[path] = texture;
         return texture;
     }
 
+    std::shared_ptr<AsyncTexture> ResourceManager::load_texture_async(const std::string& path) {
+        if (const auto pending = m_async_textures.find(path); pending != m_async_textures.end()) {
+            return pending->second;
+        }
+        if (const auto loaded = m_textures.find(path); loaded != m_textures.end()) {
+            return m_texture_loader->wrap(path, loaded->second);
+        }
+
+        auto texture = m_texture_loader->load(path);
+        texture->on_ready([this, path](const std::shared_ptr<Texture>& resident) {
+            m_textures.try_emplace(path, resident);
+        });
+        m_async_textures[path] = texture;
+        return texture;
+    }
+
     std::shared_ptr<Mesh> ResourceManager::create_mesh(const std::string& name, const std::vector<Math::Vertex>& vertices,
                                                        const std::vector<uint32_t>& indices) {
         if (m_meshes.contains(name)) {
             return m_meshes.find(name)->second;
         }
 
-        auto mesh = std::make_shared<Mesh>(m_device, vertices, indices);
+        auto mesh = std::make_shared<Mesh>(m_geometry_arena, vertices, indices);
         m_meshes[name] = mesh;
         return mesh;
     }
@@ -49,4 +89,11 @@ namespace Comet {
         }
         return nullptr;
     }
+
+    void ResourceManager::update() {
+        m_texture_loader->update();
+        std::erase_if(m_async_textures, [](const auto& entry) {
+            return entry.second->is_ready() || entry.second->has_failed();
+        });
+    }
 }
@@ -4,12 +4,13 @@
 #include "graphics/sampler.h"
 #include "material.h"
 #include "texture.h"
+#include "texture_loader.h"
 #include "mesh.h"
 
 namespace Comet {
     class COMET_API ResourceManager {
     public:
-        explicit ResourceManager(Device& device);
+        ResourceManager(Device& device, uint32_t texture_decode_threads);
         ~ResourceManager();
         
         [[nodiscard]] ShaderManager& get_shader_manager() { return *m_shader_manager; }
@@ -18,20 +19,33 @@ namespace Comet {
         [[nodiscard]] const SamplerManager& get_sampler_manager() const { return *m_sampler_manager; }
         [[nodiscard]] MaterialManager& get_material_manager() { return *m_material_manager; }
         [[nodiscard]] const MaterialManager& get_material_manager() const { return *m_material_manager; }
+        [[nodiscard]] GeometryArena& get_geometry_arena() { return *m_geometry_arena; }
+        [[nodiscard]] const GeometryArena& get_geometry_arena() const { return *m_geometry_arena; }
 
         std::shared_ptr<Texture> load_texture(const std::string& path);
+        // Decodes on the texture loader's workers; the handle serves a
+        // placeholder until the texture is resident, after which
+        // get_texture() also finds it.
+        std::shared_ptr<AsyncTexture> load_texture_async(const std::string& path);
         std::shared_ptr<Mesh> create_mesh(const std::string& name, const std::vector<Math::Vertex>& vertices,
                                           const std::vector<uint32_t>& indices);
 
         [[nodiscard]] std::shared_ptr<Texture> get_texture(const std::string& name) const;
         [[nodiscard]] std::shared_ptr<Mesh> get_mesh(const std::string& name) const;
 
+        // Advances asynchronous loads; called once per frame by the renderer.
+        void update();
+
     private:
         Device& m_device;
         std::unique_ptr<ShaderManager> m_shader_manager;
         std::unique_ptr<SamplerManager> m_sampler_manager;
         std::unique_ptr<MaterialManager> m_material_manager;
+        // Shared with every mesh, which may outlive the manager.
+        std::shared_ptr<GeometryArena> m_geometry_arena;
         std::unordered_map<std::string, std::shared_ptr<Texture>> m_textures;
+        std::unordered_map<std::string, std::shared_ptr<AsyncTexture>> m_async_textures;
+        std::unique_ptr<TextureLoader> m_texture_loader;
         std::unordered_map<std::string, std::shared_ptr<Mesh>> m_meshes;
     };
 }
@@ -4,52 +4,230 @@
 #include "scene/scene.h"
 
 namespace Comet {
-    RenderScene SceneExtractor::extract(Scene& scene) {
-        scene.update_world_transforms();
-
-        RenderScene render_scene;
-
-        const auto camera_view =
-                scene.m_registry.view<IdComponent, TransformComponent,
-                                      WorldTransformComponent, CameraComponent>();
-        render_scene.cameras.reserve(camera_view.size_hint());
-        for(const entt::entity handle: camera_view) {
-            const auto& [id] = camera_view.get<IdComponent>(handle);
-            const auto& world_transform =
-                    camera_view.get<WorldTransformComponent>(handle);
-            const auto& [primary, fov, near_clip, far_clip] =
-                    camera_view.get<CameraComponent>(handle);
-
-            render_scene.cameras.push_back({
+    namespace {
+        RenderCamera make_render_camera(const EntityId id,
+                                        const WorldTransformComponent& world_transform,
+                                        const CameraComponent& camera) {
+            const auto& [primary, fov, near_clip, far_clip] = camera;
+            return {
                 .entity_id = id,
                 .primary = primary,
-                .view_matrix = Math::inverse(
-                    world_transform.camera_world_matrix),
+                .view_matrix = Math::inverse(world_transform.camera_world_matrix),
                 .fov_degrees = fov,
                 .near_clip = near_clip,
                 .far_clip = far_clip
-            });
+            };
         }
 
-        const auto view =
-                scene.m_registry.view<IdComponent, TransformComponent,
-                                      WorldTransformComponent, MeshRendererComponent>();
-        render_scene.render_items.reserve(view.size_hint());
-
-        for(const entt::entity handle: view) {
-            const auto& [id] = view.get<IdComponent>(handle);
-            const auto& world_transform =
-                    view.get<WorldTransformComponent>(handle);
-            const auto& [mesh, material] = view.get<MeshRendererComponent>(handle);
-
-            render_scene.render_items.push_back({
+        RenderItem make_render_item(const EntityId id,
+                                    const WorldTransformComponent& world_transform,
+                                    const MeshRendererComponent& mesh_renderer) {
+            const auto& [mesh, material] = mesh_renderer;
+            return {
                 .entity_id = id,
                 .model_matrix = world_transform.world_matrix,
                 .mesh_handle = mesh,
                 .material_handle = material
-            });
+            };
+        }
+
+        template<typename Component>
+        void disconnect_all(entt::registry& registry, SceneExtractor& instance) {
+            registry.on_construct<Component>().disconnect(&instance);
+            registry.on_update<Component>().disconnect(&instance);
+            registry.on_destroy<Component>().disconnect(&instance);
+        }
+    }
+
+    SceneExtractor::SceneExtractor(Scene& scene)
+        : m_scene(scene) {
+        entt::registry& registry = m_scene.m_registry;
+        registry.on_construct<IdComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+        registry.on_destroy<IdComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+        registry.on_construct<TransformComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+        registry.on_destroy<TransformComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+        registry.on_construct<WorldTransformComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+        registry.on_update<WorldTransformComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+        registry.on_destroy<WorldTransformComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+        registry.on_construct<MeshRendererComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+        registry.on_update<MeshRendererComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+        registry.on_destroy<MeshRendererComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+        registry.on_construct<CameraComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+        registry.on_update<CameraComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+        registry.on_destroy<CameraComponent>()
+            .connect<&SceneExtractor::on_render_state_changed>(*this);
+
+        queue_grouped_entities();
+    }
+
+    SceneExtractor::~SceneExtractor() {
+        entt::registry& registry = m_scene.m_registry;
+        disconnect_all<IdComponent>(registry, *this);
+        disconnect_all<TransformComponent>(registry, *this);
+        disconnect_all<WorldTransformComponent>(registry, *this);
+        disconnect_all<MeshRendererComponent>(registry, *this);
+        disconnect_all<CameraComponent>(registry, *this);
+    }
+
+    const RenderSceneChanges& SceneExtractor::update() {
+        // Recomposed world transforms publish on_update, queueing their entities.
+        m_scene.update_world_transforms();
+
+        m_changes.clear();
+        for(const entt::entity handle: m_pending) {
+            m_pending_handles[static_cast<std::size_t>(entt::to_entity(handle))] = entt::null;
+            sync_entity(handle);
+        }
+        m_pending.clear();
+        return m_changes;
+    }
+
+    const RenderSceneChanges& SceneExtractor::rebuild() {
+        m_render_scene = {};
+        m_bindings.clear();
+        m_free_item_slots.clear();
+        m_free_camera_slots.clear();
+        m_pending.clear();
+        m_pending_handles.clear();
+
+        queue_grouped_entities();
+        return update();
+    }
+
+    RenderScene SceneExtractor::extract(Scene& scene) {
+        scene.update_world_transforms();
+
+        RenderScene render_scene;
+
+        render_scene.cameras.reserve(scene.m_cameras.size());
+        for(const auto [handle, camera, id, transform, world_transform]: scene.m_cameras.each()) {
+            render_scene.cameras.push_back(make_render_camera(id.id, world_transform, camera));
+        }
+
+        render_scene.render_items.reserve(scene.m_renderables.size());
+        for(const auto [handle, world_transform, mesh_renderer, id, transform]:
+            scene.m_renderables.each()) {
+            render_scene.render_items.push_back(
+                make_render_item(id.id, world_transform, mesh_renderer));
         }
 
         return render_scene;
     }
+
+    void SceneExtractor::queue_grouped_entities() {
+        entt::registry& registry = m_scene.m_registry;
+        for(const entt::entity handle: m_scene.m_renderables) {
+            on_render_state_changed(registry, handle);
+        }
+        for(const entt::entity handle: m_scene.m_cameras) {
+            on_render_state_changed(registry, handle);
+        }
+    }
+
+    void SceneExtractor::on_render_state_changed(entt::registry&, const entt::entity handle) {
+        const auto index = static_cast<std::size_t>(entt::to_entity(handle));
+        if(index >= m_pending_handles.size()) {
+            m_pending_handles.resize(index + 1, entt::null);
+        }
+        if(m_pending_handles[index] != handle) {
+            m_pending_handles[index] = handle;
+            m_pending.push_back(handle);
+        }
+    }
+
+    void SceneExtractor::sync_entity(const entt::entity handle) {
+        const auto index = static_cast<std::size_t>(entt::to_entity(handle));
+        if(index >= m_bindings.size()) {
+            m_bindings.resize(index + 1);
+        }
+
+        // Signals fire before components are removed, so the registry is
+        // only inspected once every change has been recorded.
+        SlotBinding& binding = m_bindings[index];
+        if(binding.handle != handle) {
+            release_item(binding);
+            release_camera(binding);
+            binding.handle = handle;
+        }
+
+        // Group membership implies the entity is alive and has every
+        // component its render state is built from.
+        if(m_scene.m_renderables.contains(handle)) {
+            if(binding.item_slot == INVALID_SLOT) {
+                if(!m_free_item_slots.empty()) {
+                    binding.item_slot = m_free_item_slots.back();
+                    m_free_item_slots.pop_back();
+                } else {
+                    binding.item_slot = static_cast<std::uint32_t>(m_render_scene.render_items.size());
+                    m_render_scene.render_items.emplace_back();
+                }
+                m_changes.added_items.push_back(binding.item_slot);
+            } else {
+                m_changes.modified_items.push_back(binding.item_slot);
+            }
+            const auto [world_transform, mesh_renderer, id] = m_scene.m_renderables.get<
+                WorldTransformComponent, MeshRendererComponent, IdComponent>(handle);
+            m_render_scene.render_items[binding.item_slot] =
+                make_render_item(id.id, world_transform, mesh_renderer);
+        } else {
+            release_item(binding);
+        }
+
+        if(m_scene.m_cameras.contains(handle)) {
+            if(binding.camera_slot == INVALID_SLOT) {
+                if(!m_free_camera_slots.empty()) {
+                    binding.camera_slot = m_free_camera_slots.back();
+                    m_free_camera_slots.pop_back();
+                } else {
+                    binding.camera_slot = static_cast<std::uint32_t>(m_render_scene.cameras.size());
+                    m_render_scene.cameras.emplace_back();
+                }
+            }
+            const auto [camera, id, world_transform] = m_scene.m_cameras.get<
+                CameraComponent, IdComponent, WorldTransformComponent>(handle);
+            m_render_scene.cameras[binding.camera_slot] =
+                make_render_camera(id.id, world_transform, camera);
+            m_changes.cameras_changed = true;
+        } else {
+            release_camera(binding);
+        }
+
+        if(binding.item_slot == INVALID_SLOT && binding.camera_slot == INVALID_SLOT) {
+            binding.handle = entt::null;
+        }
+    }
+
+    void SceneExtractor::release_item(SlotBinding& binding) {
+        if(binding.item_slot == INVALID_SLOT) {
+            return;
+        }
+
+        m_render_scene.render_items[binding.item_slot] = {};
+        m_free_item_slots.push_back(binding.item_slot);
+        m_changes.removed_items.push_back(binding.item_slot);
+        binding.item_slot = INVALID_SLOT;
+    }
+
+    void SceneExtractor::release_camera(SlotBinding& binding) {
+        if(binding.camera_slot == INVALID_SLOT) {
+            return;
+        }
+
+        m_render_scene.cameras[binding.camera_slot] = {};
+        m_free_camera_slots.push_back(binding.camera_slot);
+        m_changes.cameras_changed = true;
+        binding.camera_slot = INVALID_SLOT;
+    }
 }
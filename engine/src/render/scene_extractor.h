@@ -3,11 +3,75 @@
 #include "common/export.h"
 #include "render/render_scene.h"
 
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <entt.hpp>
+
 namespace Comet {
     class Scene;
 
+    // Keeps a persistent RenderScene in sync with a Scene. Component signals
+    // record which entities changed, and update() only revisits those, so a
+    // frame in which nothing changed costs nothing beyond the empty check.
     class COMET_API SceneExtractor {
     public:
+        explicit SceneExtractor(Scene& scene);
+
+        ~SceneExtractor();
+
+        SceneExtractor(const SceneExtractor&) = delete;
+
+        SceneExtractor& operator=(const SceneExtractor&) = delete;
+
+        SceneExtractor(SceneExtractor&&) noexcept = delete;
+
+        SceneExtractor& operator=(SceneExtractor&&) noexcept = delete;
+
+        // Applies the changes recorded since the previous call and returns them.
+        const RenderSceneChanges& update();
+
+        // Discards every slot and extracts the whole scene again; all live
+        // items are reported as added.
+        const RenderSceneChanges& rebuild();
+
+        [[nodiscard]] const RenderScene& get_render_scene() const { return m_render_scene; }
+
+        // Full, non-incremental extraction into a densely packed RenderScene.
         [[nodiscard]] static RenderScene extract(Scene& scene);
+
+    private:
+        static constexpr std::uint32_t INVALID_SLOT = std::numeric_limits<std::uint32_t>::max();
+
+        struct SlotBinding {
+            entt::entity handle = entt::null;
+            std::uint32_t item_slot = INVALID_SLOT;
+            std::uint32_t camera_slot = INVALID_SLOT;
+        };
+
+        void on_render_state_changed(entt::registry& registry, entt::entity handle);
+
+        // Queues every entity that currently holds a render item or camera.
+        void queue_grouped_entities();
+
+        void sync_entity(entt::entity handle);
+
+        void release_item(SlotBinding& binding);
+
+        void release_camera(SlotBinding& binding);
+
+        Scene& m_scene;
+        RenderScene m_render_scene;
+        RenderSceneChanges m_changes;
+
+        // Entities whose render state may have changed, deduplicated by the
+        // handle last queued for each entt::to_entity slot.
+        std::vector<entt::entity> m_pending;
+        std::vector<entt::entity> m_pending_handles;
+
+        // Render slots per entt::to_entity slot.
+        std::vector<SlotBinding> m_bindings;
+        std::vector<std::uint32_t> m_free_item_slots;
+        std::vector<std::uint32_t> m_free_camera_slots;
     };
 }
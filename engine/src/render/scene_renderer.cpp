@@ -8,65 +8,58 @@
 #include "graphics/buffer.h"
 #include "graphics/sampler.h"
 #include "graphics/pipeline.h"
-#include "graphics/render_pass.h"
-#include "graphics/attachment.h"
+#include "graphics/upload_service.h"
 #include "graphics/vertex_description.h"
+#include "core/stable_hash.h"
+#include "material.h"
 #include "resource_manager.h"
 
+#include "cube_texture_instanced_vert.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <unordered_set>
+
 namespace Comet {
+    namespace {
+        int64_t elapsed_us(const std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
     SceneRenderer::SceneRenderer(RenderContext& context,
                                  const Config::Vulkan& vulkan_config,
-                                 const Config::Render& render_config)
-        : m_context(context), m_vulkan_config(vulkan_config), m_render_config(render_config) {
+                                 const Config::Render& render_config,
+                                 const uint32_t pipeline_compile_threads)
+        : m_context(context), m_pipeline_compile_threads(pipeline_compile_threads),
+          m_vulkan_config(vulkan_config), m_render_config(render_config) {
         LOG_INFO("create frame manager");
         m_frame_manager = std::make_unique<FrameManager>(
             context.get_device(), render_config.max_frames_in_flight);
 
-        LOG_INFO("create per-frame uniform buffers");
+        LOG_INFO("create frame uniform allocator");
         const uint32_t frame_slot_count = m_frame_manager->get_frame_slot_count();
-        m_view_project_uniform_buffers.reserve(frame_slot_count);
-        for(uint32_t index = 0; index < frame_slot_count; ++index) {
-            m_view_project_uniform_buffers.push_back(Buffer::create_cpu_buffer(
-                context.get_device(),
-                Flags<BufferUsage>(BufferUsage::Uniform),
-                sizeof(ViewProjectMatrix),
-                nullptr,
-                "view-project uniform buffer"));
-        }
+        m_frame_uniforms = std::make_unique<FrameUniformAllocator>(
+            context.get_device(),
+            frame_slot_count,
+            static_cast<size_t>(render_config.frame_uniform_buffer_kb) * 1024);
+        m_instance_buffers.resize(frame_slot_count);
     }
 
-    void SceneRenderer::setup_render_pass() {
-        LOG_INFO("create render pass");
-
+    void SceneRenderer::setup_rendering() {
         reset_render_pipeline();
 
-        const auto surface_format = m_vulkan_config.surface_format;
-        const auto depth_format = m_vulkan_config.depth_format;
-        const auto msaa_samples = m_vulkan_config.msaa_samples;
-
-        std::vector<Attachment> attachments;
-        attachments.emplace_back(Attachment::get_color_attachment(surface_format, msaa_samples));
-        attachments.emplace_back(Attachment::get_depth_attachment(depth_format, msaa_samples));
-
-        std::vector<RenderSubPass> render_sub_passes;
-        RenderSubPass render_sub_pass_0 = {
-            {},
-            {SubpassColorAttachment(0)},
-            {SubpassDepthStencilAttachment(1)},
-            msaa_samples
-        };
-        render_sub_passes.emplace_back(render_sub_pass_0);
-
-        m_render_pass = std::make_shared<RenderPass>(
-            m_context.get_device(), attachments, render_sub_passes, surface_format);
-
         LOG_INFO("create render pipeline manager");
         m_pipeline_manager = std::make_unique<PipelineManager>(
-            m_context.get_device(), *m_render_pass);
+            m_context.get_device(), get_rendering_formats(), m_pipeline_compile_threads);
 
         LOG_INFO("create render target");
-        m_render_target = RenderTarget::create_swapchain_target(
-            m_context.get_device(), *m_render_pass, m_context.get_swapchain());
+        m_render_target = DynamicRenderTarget::create_swapchain_target(
+            m_context.get_device(), m_context.get_swapchain(), get_rendering_formats());
         set_render_target_clear_color();
 
         const auto image_count = static_cast<uint32_t>(
@@ -79,47 +72,18 @@ namespace Comet {
         m_viewport_size_stable_frames = 0;
     }
 
-    void SceneRenderer::setup_viewport_render_pass(const Math::Vec2u size) {
+    void SceneRenderer::setup_viewport_rendering(const Math::Vec2u size) {
         if(size.x == 0 || size.y == 0) {
             LOG_FATAL("Viewport render target size must be greater than zero");
         }
 
-        LOG_INFO("create viewport render pass at {}x{}", size.x, size.y);
-        reset_render_pipeline();
-
-        const auto surface_format = m_vulkan_config.surface_format;
-        const auto depth_format = m_vulkan_config.depth_format;
-        const auto msaa_samples = m_vulkan_config.msaa_samples;
-
-        Attachment color_attachment = Attachment::get_color_attachment(
-            surface_format, msaa_samples);
-        if(msaa_samples == SampleCount::Count1) {
-            color_attachment.description.store_op = AttachmentStoreOp::Store;
-            color_attachment.description.final_layout = ImageLayout::ShaderReadOnlyOptimal;
-            color_attachment.usage |= ImageUsage::Sampled;
+        LOG_INFO("create viewport render target at {}x{}", size.x, size.y);
+        if(!m_pipeline_manager) {
+            m_pipeline_manager = std::make_unique<PipelineManager>(
+                m_context.get_device(), get_rendering_formats(), m_pipeline_compile_threads);
         }
-
-        std::vector<Attachment> attachments;
-        attachments.emplace_back(color_attachment);
-        attachments.emplace_back(Attachment::get_depth_attachment(depth_format, msaa_samples));
-
-        RenderSubPass render_sub_pass = {
-            {},
-            {SubpassColorAttachment(0)},
-            {SubpassDepthStencilAttachment(1)},
-            msaa_samples
-        };
-        render_sub_pass.resolve_final_layout = ImageLayout::ShaderReadOnlyOptimal;
-        render_sub_pass.resolve_usage =
-            Flags<ImageUsage>(ImageUsage::ColorAttachment) | ImageUsage::Sampled;
-
-        m_render_pass = std::make_shared<RenderPass>(
-            m_context.get_device(), attachments,
-            std::vector<RenderSubPass>{render_sub_pass}, surface_format);
-        m_pipeline_manager = std::make_unique<PipelineManager>(
-            m_context.get_device(), *m_render_pass);
-        m_render_target = RenderTarget::create_multi_target(
-            m_context.get_device(), *m_render_pass, size,
+        m_render_target = DynamicRenderTarget::create_sampled_target(
+            m_context.get_device(), get_rendering_formats(), size,
             m_frame_manager->get_frame_slot_count());
         set_render_target_clear_color();
 
@@ -145,14 +109,105 @@ namespace Comet {
 
         // 创建着色器
         const auto vert_shader = resource_manager.get_shader_manager().load_shader(
-            "cube_texture_vert", CUBE_TEXTURE_VERT, layout);
+            "cube_texture_instanced_vert", CUBE_TEXTURE_INSTANCED_VERT, layout);
         const auto frag_shader = resource_manager.get_shader_manager().load_shader(
             "cube_texture_frag", CUBE_TEXTURE_FRAG, layout);
         m_default_sampler = resource_manager.get_sampler_manager().get_linear_repeat();
 
         // 创建 Pipeline
         m_pipeline = m_pipeline_manager->create_pipeline(
-            "cube_pipeline", layout, vertex_input, config, vert_shader, frag_shader);
+            "cube_instanced_pipeline", layout, vertex_input, config, vert_shader, frag_shader);
+
+        // 半透明物体：开启混合，保留深度测试但不写深度
+        PipelineConfig blend_config = config;
+        blend_config.enable_alpha_blend();
+        blend_config.depth_stencil_state.depth_write_enable = false;
+        m_blend_pipeline = m_pipeline_manager->create_pipeline(
+            "cube_instanced_blend_pipeline", layout, vertex_input, blend_config,
+            vert_shader, frag_shader);
+
+        m_base_pipeline = PipelineDescription{
+            .layout = layout,
+            .vertex_input = vertex_input,
+            .config = config,
+            .vert_shader = vert_shader,
+            .frag_shader = frag_shader
+        };
+        StableHasher base_hasher;
+        base_hasher.add(vert_shader->get_name()).add(frag_shader->get_name());
+        base_hasher.add(vertex_input.get_layout_hash());
+        base_hasher.add(m_pipeline_manager->get_formats().get_compatibility_hash());
+        base_hasher.add(config.rasterization_state.front_face).add(config.multisample_state.rasterization_samples);
+        m_base_pipeline_hash = base_hasher.get();
+        m_material_pipelines.clear();
+    }
+
+    void SceneRenderer::precompile_pipelines(const MaterialManager& material_manager) {
+        if(!m_pipeline_manager || !m_base_pipeline.vert_shader) {
+            LOG_ERROR("SceneRenderer pipelines are not set up. Call setup_pipeline() first.");
+            return;
+        }
+
+        std::unordered_set<PipelineKey> keys;
+        for(const auto& [name, material]: material_manager.get_materials()) {
+            const PipelineKey key = get_material_pipeline_key(material->get_config());
+            if(keys.insert(key).second && !m_pipeline_manager->is_pending(key)) {
+                static_cast<void>(m_pipeline_manager->request_pipeline(
+                    key, describe_material_pipeline(*material)));
+            }
+        }
+        LOG_INFO("{} material(s) share {} pipeline state(s), {} compile(s) pending",
+            material_manager.get_materials().size(), keys.size(),
+            m_pipeline_manager->get_stats().pending);
+    }
+
+    void SceneRenderer::update_pipelines() {
+        if(m_pipeline_manager) {
+            m_pipeline_manager->update();
+        }
+    }
+
+    PipelineKey SceneRenderer::get_material_pipeline_key(const MaterialConfig& config) const {
+        return StableHasher(m_base_pipeline_hash).add(config.get_state_hash()).get();
+    }
+
+    PipelineDescription SceneRenderer::describe_material_pipeline(const Material& material) const {
+        PipelineDescription description = m_base_pipeline;
+        const MaterialConfig& config = material.get_config();
+        config.apply_to(description.config);
+        if(config.get_vertex_shader()) {
+            description.vert_shader = config.get_vertex_shader();
+        }
+        if(config.get_fragment_shader()) {
+            description.frag_shader = config.get_fragment_shader();
+        }
+        return description;
+    }
+
+    SceneRenderer::MaterialPipeline& SceneRenderer::resolve_material_pipeline(const MaterialBinding& binding) {
+        MaterialPipeline& entry = m_material_pipelines[binding.material_handle];
+        const uint64_t config_version = binding.material->get_config_version();
+        if(entry.config_version != config_version) {
+            entry.config_version = config_version;
+            entry.key = get_material_pipeline_key(binding.material->get_config());
+            entry.pipeline.reset();
+        }
+        if(!entry.pipeline) {
+            entry.pipeline = m_pipeline_manager->find_pipeline(entry.key);
+            if(!entry.pipeline && !m_pipeline_manager->is_pending(entry.key)) {
+                static_cast<void>(m_pipeline_manager->request_pipeline(
+                    entry.key, describe_material_pipeline(*binding.material)));
+            }
+        }
+        return entry;
+    }
+
+    const Pipeline* SceneRenderer::select_pipeline(const RenderDraw& draw) {
+        const MaterialBinding& binding = draw.first_item->material;
+        if(!binding.material) {
+            return draw.alpha_blend ? m_blend_pipeline.get() : m_pipeline.get();
+        }
+        return resolve_material_pipeline(binding).pipeline.get();
     }
 
     const DescriptorSet& SceneRenderer::prepare_material_descriptor_set(
@@ -170,7 +225,7 @@ namespace Comet {
             const uint32_t frame_slot_count = m_frame_manager->get_frame_slot_count();
             DescriptorPoolSizes descriptor_pool_sizes;
             descriptor_pool_sizes.add_pool_size(
-                DescriptorType::UniformBuffer, frame_slot_count);
+                DescriptorType::UniformBufferDynamic, frame_slot_count);
             descriptor_pool_sizes.add_pool_size(
                 DescriptorType::CombinedImageSampler, 2 * frame_slot_count);
             state.pool = std::make_shared<DescriptorPool>(
@@ -202,38 +257,83 @@ namespace Comet {
 
         if(!submission.view_project_matrix) return;
 
-        if(!m_pipeline || !m_default_sampler) {
+        if(!m_pipeline || !m_blend_pipeline || !m_default_sampler) {
             LOG_ERROR("SceneRenderer resources are not set up. Call setup_pipeline() first.");
             return;
         }
 
-        const uint32_t frame_slot_index =
-                m_frame_manager->get_current_frame_slot_index();
-        const auto& view_project_buffer =
-                m_view_project_uniform_buffers.at(frame_slot_index);
-        std::static_pointer_cast<CPUBuffer>(view_project_buffer)->write(
-            &*submission.view_project_matrix);
+        const auto view_project_block =
+                m_frame_uniforms->push_uniform(*submission.view_project_matrix);
+        if(!view_project_block) return;
+        const auto& view_project_buffer = m_frame_uniforms->get_buffer();
 
         const auto& command_buffer = m_frame_manager->get_current_command_buffer();
-        command_buffer.bind_pipeline(*m_pipeline);
-
         const auto size = m_render_target->get_size();
         command_buffer.set_viewport(Graphics::get_viewport(
             static_cast<float>(size.x), static_cast<float>(size.y)));
         command_buffer.set_scissor(Graphics::get_scissor(
             static_cast<float>(size.x), static_cast<float>(size.y)));
 
-        for(const ResolvedRenderItem& item: submission.render_items) {
+        // Sorted by state, then depth; runs of equal state become one
+        // instanced draw.
+        m_render_queue.build(submission.render_items, submission.view_project_matrix->view,
+            [this](const MaterialBinding& binding) -> std::uint64_t {
+                return binding.material ? resolve_material_pipeline(binding).key : 0;
+            });
+        const auto& draws = m_render_queue.get_draws();
+        PROFILE_COUNTER("SceneRenderer::draw_calls", static_cast<std::int64_t>(draws.size()));
+        if(draws.empty()) return;
+
+        // Instances are addressed through first_instance, so one binding at
+        // offset zero serves every draw of the frame.
+        const Buffer& instance_buffer =
+                prepare_instance_buffer(m_render_queue.get_instance_matrices());
+        command_buffer.bind_vertex_buffer({instance_buffer, 0}, 1);
+
+        BoundState bound_state;
+        for(const RenderDraw& draw: draws) {
+            // Skipped rather than drawn with the default pipeline, whose
+            // cull and depth state may differ from the material's.
+            const Pipeline* pipeline = select_pipeline(draw);
+            if(!pipeline) continue;
             const DescriptorSet& descriptor_set = prepare_material_descriptor_set(
-                item.material, view_project_buffer, *m_default_sampler);
-            render_item(item, descriptor_set);
+                draw.first_item->material, view_project_buffer, *m_default_sampler);
+            render_draw(draw, *pipeline, descriptor_set,
+                view_project_block->offset, bound_state);
+        }
+        PROFILE_COUNTER("SceneRenderer::binds_saved",
+            static_cast<std::int64_t>(bound_state.binds_saved));
+    }
+
+    const Buffer& SceneRenderer::prepare_instance_buffer(
+        const std::vector<Math::Mat4>& instance_matrices) {
+        constexpr size_t MIN_INSTANCE_CAPACITY = 1024;
+
+        const uint32_t frame_slot_index =
+                m_frame_manager->get_current_frame_slot_index();
+        auto& instance_buffer = m_instance_buffers.at(frame_slot_index);
+        const size_t required_size = instance_matrices.size() * sizeof(Math::Mat4);
+        if(!instance_buffer || instance_buffer->get_size() < required_size) {
+            const size_t capacity = std::bit_ceil(
+                std::max(instance_matrices.size(), MIN_INSTANCE_CAPACITY));
+            instance_buffer = Buffer::create_cpu_buffer(
+                m_context.get_device(),
+                Flags<BufferUsage>(BufferUsage::Vertex),
+                capacity * sizeof(Math::Mat4),
+                nullptr,
+                "instance transform buffer");
         }
+
+        std::static_pointer_cast<CPUBuffer>(instance_buffer)->write(
+            instance_matrices.data(), required_size);
+        return *instance_buffer;
     }
 
     bool SceneRenderer::begin_frame() {
         PROFILE_SCOPE("SceneRenderer::begin_frame");
         apply_pending_viewport_resize();
         m_frame_manager->begin_frame();
+        m_frame_uniforms->begin_frame(m_frame_manager->get_current_frame_slot_index());
 
         auto& swapchain = m_context.get_swapchain();
         auto& frame_slot = m_frame_manager->get_current_frame_slot();
@@ -255,44 +355,60 @@ namespace Comet {
         m_frame_manager->prepare_image(image_index);
         auto& command_buffer = m_frame_manager->get_current_command_buffer();
         command_buffer.begin(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
-        if(m_uses_viewport_target) {
-            m_render_target->begin_render_target(
-                command_buffer, m_frame_manager->get_current_frame_slot_index());
-        } else {
-            m_render_target->begin_render_target(command_buffer);
-        }
+        // 获取传输队列已提交资源的所有权，提交时等待对应的 timeline 值
+        m_pending_upload_wait =
+                m_context.get_device().get_upload_service().acquire_for_graphics(command_buffer);
+        m_render_target->begin_render_target(command_buffer, m_uses_viewport_target
+            ? m_frame_manager->get_current_frame_slot_index()
+            : swapchain.get_current_index());
 
         return true;
     }
 
-    void SceneRenderer::render_item(const ResolvedRenderItem& render_item,
-                                    const DescriptorSet& descriptor_set) const {
-        PROFILE_SCOPE("SceneRenderer::render_item");
-
+    void SceneRenderer::render_draw(const RenderDraw& draw,
+                                    const Pipeline& pipeline,
+                                    const DescriptorSet& descriptor_set,
+                                    const uint32_t view_project_offset,
+                                    BoundState& bound_state) const {
         const auto& command_buffer =
                 m_frame_manager->get_current_command_buffer();
 
-        // Bind descriptor sets
+        if(bound_state.pipeline != &pipeline) {
+            command_buffer.bind_pipeline(pipeline);
+            bound_state.pipeline = &pipeline;
+            // Rebind the set against the new pipeline's layout.
+            bound_state.descriptor_set = nullptr;
+        } else {
+            ++bound_state.binds_saved;
+        }
+
         const vk::DescriptorSet vk_descriptor_set = descriptor_set.get();
-        command_buffer.get().bindDescriptorSets(
-            vk::PipelineBindPoint::eGraphics,
-            m_pipeline->get_layout()->get(),
-            0,
-            1,
-            &vk_descriptor_set,
-            0,
-            nullptr);
+        if(bound_state.descriptor_set != vk_descriptor_set
+           || bound_state.view_project_offset != view_project_offset) {
+            command_buffer.get().bindDescriptorSets(
+                vk::PipelineBindPoint::eGraphics,
+                pipeline.get_layout()->get(),
+                0,
+                1,
+                &vk_descriptor_set,
+                1,
+                &view_project_offset);
+            bound_state.descriptor_set = vk_descriptor_set;
+            bound_state.view_project_offset = view_project_offset;
+        } else {
+            ++bound_state.binds_saved;
+        }
 
-        const PushConstant push_constant{.model = render_item.model_matrix};
-        command_buffer.push_constants(
-            *m_pipeline->get_layout(),
-            Flags<ShaderStage>(ShaderStage::Vertex),
-            0,
-            &push_constant,
-            sizeof(push_constant));
+        // Meshes share the arena's buffers, so they are only bound once.
+        const Mesh* mesh = draw.first_item->mesh.get();
+        if(bound_state.geometry != &mesh->get_geometry_arena()) {
+            mesh->bind(command_buffer);
+            bound_state.geometry = &mesh->get_geometry_arena();
+        } else {
+            ++bound_state.binds_saved;
+        }
 
-        // Draw
-        render_item.mesh->draw(command_buffer);
+        mesh->draw(command_buffer, draw.instance_count, draw.first_instance);
     }
 
     void SceneRenderer::end_frame() {
@@ -305,24 +421,42 @@ namespace Comet {
         auto& image_state =
                 m_frame_manager->get_swapchain_image_state(image_index);
 
+        // 本帧所有 uniform 写入一次性 flush
+        m_frame_uniforms->flush();
+
         // End command buffer
         frame_slot.command_buffer.end();
 
         // Submit
         const auto& graphics_queue = device.get_graphics_queue(0);
-        const QueueSemaphoreSubmit image_available_wait{
+        std::vector<QueueSemaphoreSubmit> waits;
+        waits.emplace_back(
             frame_slot.image_available_semaphore,
-            Flags<PipelineStage>(PipelineStage::ColorAttachmentOutput)
-        };
-        const QueueSemaphoreSubmit render_finished_signal{
-            image_state.render_finished_semaphore,
-            Flags<PipelineStage>(PipelineStage::AllCommands)
+            Flags<PipelineStage>(PipelineStage::ColorAttachmentOutput));
+        if(m_pending_upload_wait) {
+            waits.emplace_back(
+                device.get_upload_service().get_timeline_semaphore(),
+                Flags<PipelineStage>(PipelineStage::AllCommands),
+                *m_pending_upload_wait);
+            m_pending_upload_wait.reset();
+        }
+        // 帧时间线信号本帧编号，替代每个帧槽的 fence
+        const std::array<QueueSemaphoreSubmit, 2> signals{
+            QueueSemaphoreSubmit{
+                image_state.render_finished_semaphore,
+                Flags<PipelineStage>(PipelineStage::AllCommands)
+            },
+            QueueSemaphoreSubmit{
+                m_frame_manager->get_frame_timeline(),
+                Flags<PipelineStage>(PipelineStage::AllCommands),
+                m_frame_manager->get_frame_number()
+            }
         };
         graphics_queue.submit2(
-            std::span(&image_available_wait, 1),
+            std::span<const QueueSemaphoreSubmit>(waits),
             std::span(&frame_slot.command_buffer, 1),
-            std::span(&render_finished_signal, 1),
-            &frame_slot.in_flight_fence);
+            std::span<const QueueSemaphoreSubmit>(signals),
+            nullptr);
 
         // Present
         auto& present_queue = device.get_present_queue(0);
@@ -398,9 +532,14 @@ namespace Comet {
         }
 
         if(!m_uses_viewport_target) {
-            m_render_target = RenderTarget::create_swapchain_target(
-                m_context.get_device(), *m_render_pass, m_context.get_swapchain());
-            set_render_target_clear_color();
+            // 仅重新分配附件图像，管线与附件尺寸无关
+            const auto recreate_start = std::chrono::steady_clock::now();
+            m_render_target->recreate();
+            const int64_t recreate_us = elapsed_us(recreate_start);
+            PROFILE_COUNTER("SceneRenderer::swapchain_target_recreate_us", recreate_us);
+            LOG_INFO("swapchain render target recreated at {}x{} in {:.2f} ms",
+                m_render_target->get_size().x, m_render_target->get_size().y,
+                static_cast<double>(recreate_us) / 1000.0);
         }
 
         const auto image_count =
@@ -415,9 +554,18 @@ namespace Comet {
 
     void SceneRenderer::reset_render_pipeline() {
         m_pipeline.reset();
+        m_blend_pipeline.reset();
+        m_material_pipelines.clear();
         m_pipeline_manager.reset();
         m_render_target.reset();
-        m_render_pass.reset();
+    }
+
+    RenderingFormats SceneRenderer::get_rendering_formats() const {
+        return RenderingFormats{
+            .color_formats = {m_vulkan_config.surface_format},
+            .depth_format = m_vulkan_config.depth_format,
+            .samples = m_vulkan_config.msaa_samples
+        };
     }
 
     void SceneRenderer::set_render_target_clear_color() const {
@@ -437,10 +585,19 @@ namespace Comet {
             return;
         }
 
-        m_context.wait_idle();
+        // The old images go to the deletion queue, so frames in flight keep
+        // rendering into them without a device wait.
+        const auto resize_start = std::chrono::steady_clock::now();
         m_render_target->resize(
             m_requested_viewport_size.x, m_requested_viewport_size.y);
+        m_render_target->recreate();
         m_viewport_size_stable_frames = 0;
+
+        const int64_t resize_us = elapsed_us(resize_start);
+        PROFILE_COUNTER("SceneRenderer::viewport_resize_us", resize_us);
+        LOG_INFO("viewport render target resized to {}x{} in {:.2f} ms",
+            m_requested_viewport_size.x, m_requested_viewport_size.y,
+            static_cast<double>(resize_us) / 1000.0);
     }
 
     void SceneRenderer::update_descriptor_set(const DescriptorSet& descriptor_set,
@@ -467,7 +624,7 @@ namespace Comet {
         view_project_write.dstSet = descriptor_set.get();
         view_project_write.dstBinding = 0;
         view_project_write.dstArrayElement = 0;
-        view_project_write.descriptorType = vk::DescriptorType::eUniformBuffer;
+        view_project_write.descriptorType = vk::DescriptorType::eUniformBufferDynamic;
         view_project_write.descriptorCount = 1;
         view_project_write.pBufferInfo = &buffer_info;
         write_sets.emplace_back(view_project_write);
@@ -3,25 +3,29 @@
 #include "common/export.h"
 #include "common/shader_resources.h"
 #include "core/math_utils.h"
+#include "dynamic_render_target.h"
 #include "frame_manager.h"
+#include "frame_uniform_allocator.h"
 #include "graphics/buffer.h"
 #include "graphics/descriptor_set.h"
 #include "graphics/pipeline.h"
-#include "graphics/render_pass.h"
 #include "graphics/sampler.h"
 #include "graphics/vertex_description.h"
 #include "mesh.h"
 #include "render_context.h"
+#include "render_queue.h"
 #include "render_submission.h"
-#include "render_target.h"
 #include "texture.h"
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
 namespace Comet {
+    class Material;
+    class MaterialManager;
     class ResourceManager;
     class VertexInputDescription;
 
@@ -35,11 +39,15 @@ namespace Comet {
 
         SceneRenderer(RenderContext& context,
                       const Config::Vulkan& vulkan_config,
-                      const Config::Render& render_config);
+                      const Config::Render& render_config,
+                      uint32_t pipeline_compile_threads = 1);
 
-        void setup_render_pass();
+        // Renders straight into the swapchain.
+        void setup_rendering();
 
-        void setup_viewport_render_pass(Math::Vec2u size);
+        // Renders into sampled images for an editor viewport. Pipelines only
+        // depend on attachment formats, so the ones already built are kept.
+        void setup_viewport_rendering(Math::Vec2u size);
 
         std::shared_ptr<DescriptorSetLayout> create_descriptor_set_layout(const DescriptorSetLayoutBindings& bindings);
 
@@ -48,6 +56,15 @@ namespace Comet {
                             const VertexInputDescription& vertex_input,
                             const PipelineConfig& config);
 
+        // Queues background compilation of the pipeline state of every material
+        // in `material_manager` so that their first draws need not fall back.
+        // Materials with identical state share one pipeline. Requires
+        // setup_pipeline().
+        void precompile_pipelines(const MaterialManager& material_manager);
+
+        // Publishes pipelines whose background compilation has finished.
+        void update_pipelines();
+
         void render(const RenderSubmission& submission);
 
         [[nodiscard]] bool begin_frame();
@@ -63,12 +80,10 @@ namespace Comet {
         [[nodiscard]] RenderMode get_render_mode() const { return m_render_mode; }
         [[nodiscard]] FrameManager& get_frame_manager() { return *m_frame_manager; }
         [[nodiscard]] const FrameManager& get_frame_manager() const { return *m_frame_manager; }
-        [[nodiscard]] RenderTarget& get_render_target() { return *m_render_target; }
-        [[nodiscard]] const RenderTarget& get_render_target() const { return *m_render_target; }
+        [[nodiscard]] DynamicRenderTarget& get_render_target() { return *m_render_target; }
+        [[nodiscard]] const DynamicRenderTarget& get_render_target() const { return *m_render_target; }
         [[nodiscard]] PipelineManager& get_pipeline_manager() { return *m_pipeline_manager; }
         [[nodiscard]] const PipelineManager& get_pipeline_manager() const { return *m_pipeline_manager; }
-        [[nodiscard]] RenderPass& get_render_pass() { return *m_render_pass; }
-        [[nodiscard]] const RenderPass& get_render_pass() const { return *m_render_pass; }
         [[nodiscard]] const std::shared_ptr<Pipeline>& get_pipeline() const { return m_pipeline; }
         [[nodiscard]] CommandBuffer& get_current_command_buffer() const;
         [[nodiscard]] bool is_viewport_rendering() const { return m_uses_viewport_target; }
@@ -98,32 +113,84 @@ namespace Comet {
             const std::shared_ptr<Buffer>& view_project_buffer,
             const Sampler& sampler);
 
-        void render_item(const ResolvedRenderItem& render_item,
-                         const DescriptorSet& descriptor_set) const;
+        [[nodiscard]] const Buffer& prepare_instance_buffer(
+            const std::vector<Math::Mat4>& instance_matrices);
+
+        // State bound on the current command buffer during render(), used to
+        // skip binds that would not change anything.
+        struct BoundState {
+            const Pipeline* pipeline = nullptr;
+            vk::DescriptorSet descriptor_set;
+            uint32_t view_project_offset = 0;
+            const GeometryArena* geometry = nullptr;
+            std::size_t binds_saved = 0;
+        };
+
+        // Hash of the shader pair, MaterialConfig, vertex layout and
+        // attachment formats.
+        [[nodiscard]] PipelineKey get_material_pipeline_key(const MaterialConfig& config) const;
+
+        [[nodiscard]] PipelineDescription describe_material_pipeline(const Material& material) const;
+
+        struct MaterialPipeline {
+            PipelineKey key = 0;
+            // Material config version the key was computed from.
+            std::optional<uint64_t> config_version;
+            // Null while the state's pipeline is still compiling.
+            std::shared_ptr<Pipeline> pipeline;
+        };
+
+        // The material's cache entry, rekeyed only when its config version
+        // changes. Requests the pipeline if it is neither compiled nor pending.
+        MaterialPipeline& resolve_material_pipeline(const MaterialBinding& binding);
+
+        // The pipeline of the material's state, or null while it compiles.
+        // Draws without a material use the default opaque or blend pipeline.
+        [[nodiscard]] const Pipeline* select_pipeline(const RenderDraw& draw);
+
+        void render_draw(const RenderDraw& draw,
+                         const Pipeline& pipeline,
+                         const DescriptorSet& descriptor_set,
+                         uint32_t view_project_offset,
+                         BoundState& bound_state) const;
 
         void update_descriptor_set(const DescriptorSet& descriptor_set,
                                    const DescriptorResources& resources,
                                    const Sampler& sampler) const;
 
+        [[nodiscard]] RenderingFormats get_rendering_formats() const;
         void reset_render_pipeline();
         void set_render_target_clear_color() const;
         void apply_pending_viewport_resize();
 
         SwapchainRecreateCallback m_swapchain_recreate_callback;
         RenderContext& m_context;
-        std::shared_ptr<RenderPass> m_render_pass;
         std::unique_ptr<PipelineManager> m_pipeline_manager;
         std::unique_ptr<FrameManager> m_frame_manager;
-        std::unique_ptr<RenderTarget> m_render_target;
+        std::unique_ptr<DynamicRenderTarget> m_render_target;
         RenderMode m_render_mode = RenderMode::Runtime;
         bool m_uses_viewport_target = false;
         Math::Vec2u m_requested_viewport_size = Math::Vec2u(0);
         uint32_t m_viewport_size_stable_frames = 0;
         std::shared_ptr<Pipeline> m_pipeline;
+        std::shared_ptr<Pipeline> m_blend_pipeline;
+        // What material pipelines are derived from, recorded by setup_pipeline().
+        PipelineDescription m_base_pipeline;
+        // Hash of the parts of the key that setup_pipeline() fixes.
+        uint64_t m_base_pipeline_hash = 0;
+        std::unordered_map<AssetHandle, MaterialPipeline> m_material_pipelines;
+        uint32_t m_pipeline_compile_threads;
         std::shared_ptr<Sampler> m_default_sampler;
         std::shared_ptr<DescriptorSetLayout> m_descriptor_set_layout;
         std::unordered_map<AssetHandle, MaterialDescriptorState> m_material_descriptors;
-        std::vector<std::shared_ptr<Buffer>> m_view_project_uniform_buffers;
+        // Transient per-frame uniform blocks, bound through dynamic offsets.
+        std::unique_ptr<FrameUniformAllocator> m_frame_uniforms;
+        // Per frame slot; grown on demand and only rewritten once the slot's
+        // previous frame has retired.
+        std::vector<std::shared_ptr<Buffer>> m_instance_buffers;
+        RenderQueue m_render_queue;
+        // Upload timeline value this frame's submission waits on, if any.
+        std::optional<uint64_t> m_pending_upload_wait;
         Config::Vulkan m_vulkan_config;
         Config::Render m_render_config;
     };
@@ -2,11 +2,14 @@
 
 #include "asset/registry.h"
 #include "common/logger.h"
+#include "common/profiler.h"
+#include "core/bounds.h"
 #include "material.h"
 #include "mesh.h"
 #include "texture.h"
 
 #include <cmath>
+#include <cstdint>
 #include <utility>
 
 namespace Comet {
@@ -15,16 +18,36 @@ namespace Comet {
 
     RenderSubmission SceneResolver::resolve(
         const RenderScene& render_scene, const Math::Vec2u render_size) {
+        PROFILE_SCOPE("SceneResolver::resolve");
         RenderSubmission submission;
         submission.view_project_matrix = resolve_camera(render_scene, render_size);
         submission.render_items.reserve(render_scene.render_items.size());
 
+        // Without a camera nothing is drawn, so there is nothing to cull against.
+        std::optional<Math::Frustum> frustum;
+        if(submission.view_project_matrix) {
+            frustum = Math::make_frustum(
+                submission.view_project_matrix->projection * submission.view_project_matrix->view);
+        }
+
         for(const RenderItem& render_item : render_scene.render_items) {
-            if(auto resolved_item = resolve_item(render_item)) {
-                submission.render_items.push_back(std::move(*resolved_item));
+            if(render_item.entity_id == INVALID_ENTITY_ID) continue;
+
+            auto resolved_item = resolve_item(render_item);
+            if(!resolved_item) continue;
+
+            if(frustum && !Math::intersects(
+                *frustum, resolved_item->mesh->get_bounds(), render_item.model_matrix)) {
+                ++submission.culled_item_count;
+                continue;
             }
+            submission.render_items.push_back(std::move(*resolved_item));
         }
 
+        PROFILE_COUNTER("SceneResolver::visible_items",
+            static_cast<std::int64_t>(submission.render_items.size()));
+        PROFILE_COUNTER("SceneResolver::culled_items",
+            static_cast<std::int64_t>(submission.culled_item_count));
         return submission;
     }
 
@@ -33,7 +56,7 @@ namespace Comet {
         const RenderCamera* primary_camera = nullptr;
         std::size_t primary_camera_count = 0;
         for(const RenderCamera& camera : render_scene.cameras) {
-            if(!camera.primary) continue;
+            if(!camera.primary || camera.entity_id == INVALID_ENTITY_ID) continue;
 
             ++primary_camera_count;
             if(!primary_camera || camera.entity_id < primary_camera->entity_id) {
@@ -159,7 +182,9 @@ namespace Comet {
             .mesh = mesh,
             .material = {
                 .material_handle = render_item.material_handle,
-                .textures = std::move(textures)
+                .material = material,
+                .textures = std::move(textures),
+                .alpha_blend = material->get_config().is_alpha_blend_enabled()
             }
         };
     }
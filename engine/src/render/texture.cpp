@@ -1,13 +1,46 @@
 #include "texture.h"
 #include <stb_image.h>
 #include <glm/gtx/io.hpp>
+#include "core/mip_chain.h"
+#include "core/texel_swizzle.h"
 #include "graphics/device.h"
-#include "graphics/command_context.h"
 #include "graphics/image.h"
 #include "graphics/image_view.h"
-#include "graphics/buffer.h"
+#include "graphics/upload_service.h"
+#include "texture_compression.h"
 
 namespace Comet {
+    namespace {
+        // Formats build_rgba8_mip_chain can filter; the channel order does
+        // not matter to a per-channel box filter.
+        bool is_rgba8_format(const Format format) {
+            switch(format) {
+                case Format::R8G8B8A8_UNORM:
+                case Format::R8G8B8A8_SRGB:
+                case Format::B8G8R8A8_UNORM:
+                case Format::B8G8R8A8_SRGB:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        // Formats whose colour channels have to be filtered in linear space.
+        bool is_srgb8_format(const Format format) {
+            return format == Format::R8G8B8A8_SRGB || format == Format::B8G8R8A8_SRGB;
+        }
+
+        Format compressed_format(const TextureCompression compression, const bool srgb) {
+            switch(compression) {
+                case TextureCompression::BC1: return srgb ? Format::BC1_RGBA_SRGB_BLOCK : Format::BC1_RGBA_UNORM_BLOCK;
+                case TextureCompression::BC3: return srgb ? Format::BC3_SRGB_BLOCK : Format::BC3_UNORM_BLOCK;
+                case TextureCompression::BC5: return Format::BC5_UNORM_BLOCK;
+                case TextureCompression::BC7: return srgb ? Format::BC7_SRGB_BLOCK : Format::BC7_UNORM_BLOCK;
+            }
+            return Format::UNDEFINED;
+        }
+    }
+
     Texture::Texture(Device& device, const std::string& img_path, const Format format)
         : m_width(0), m_height(0), m_channels(0), m_format(format) {
         uint8_t* data = stbi_load(img_path.c_str(), &m_width, &m_height, &m_channels, STBI_rgb_alpha);
@@ -16,6 +49,10 @@ namespace Comet {
         }
         LOG_INFO("Loaded texture: {}x{}, channels: {}", m_width, m_height, m_channels);
         const size_t size = m_width * m_height * Graphics::format_size_in_bytes(m_format);
+        // stb_image 输出 RGBA，BGRA 目标格式需要交换 R/B 通道
+        if(Graphics::is_bgra8_format(m_format)) {
+            swizzle_rgba8_to_bgra8(data, data, static_cast<size_t>(m_width) * m_height);
+        }
         create_image(device, size, data);
         stbi_image_free(data);
     }
@@ -28,20 +65,36 @@ namespace Comet {
         for(int y = 0; y < m_height; ++y) {
             for(int x = 0; x < m_width; ++x) {
                 const size_t idx = 4 * (y * m_width + x);
-                pixels[idx + 0] = color.x; // R
+                pixels[idx + 0] = color.z; // B
                 pixels[idx + 1] = color.y; // G
-                pixels[idx + 2] = color.z; // B
+                pixels[idx + 2] = color.x; // R
                 pixels[idx + 3] = color.w; // A
             }
         }
         create_image(device, size, pixels.data());
     }
 
+    Texture::Texture(Device& device, const int width, const int height, const uint8_t* pixels, const Format format)
+        : m_width(width), m_height(height), m_channels(4), m_format(format) {
+        const size_t size = static_cast<size_t>(m_width) * m_height * Graphics::format_size_in_bytes(m_format);
+        create_image(device, size, pixels);
+    }
+
+    Texture::Texture(Device& device, const CompressedTexture& compressed)
+        : m_width(static_cast<int>(compressed.width)), m_height(static_cast<int>(compressed.height)), m_channels(4) {
+        m_format = compressed_format(compressed.compression, compressed.srgb);
+        create_compressed_image(device, compressed);
+    }
+
     Texture::~Texture() {
         m_image_view.reset();
         m_image.reset();
     }
 
+    uint32_t Texture::get_mip_levels() const {
+        return m_image ? m_image->get_info().mip_levels : 0;
+    }
+
     void Texture::create_image(Device& device, size_t size, const void* data) {
         if(!data || size == 0) {
             LOG_ERROR("Invalid data or size for texture creation: data={}, size={}",
@@ -49,36 +102,68 @@ namespace Comet {
             return;
         }
 
+        // 生成完整 mip 链：上传队列支持 blit 时在 GPU 上逐级缩小，否则在 CPU 上盒式滤波
+        auto& upload_service = device.get_upload_service();
+        const uint32_t full_mip_levels = compute_mip_level_count(m_width, m_height);
+        const bool blit_mips = full_mip_levels > 1 && upload_service.supports_mip_blits(m_format);
+        const bool filter_mips = !blit_mips && full_mip_levels > 1 && is_rgba8_format(m_format);
+        if(!blit_mips && !filter_mips && full_mip_levels > 1) {
+            LOG_WARN("No mip generation path for texture format {}, using a single level",
+                static_cast<int>(m_format));
+        }
+
+        auto usage = Flags<ImageUsage>(ImageUsage::Sampled) | ImageUsage::CopyDst;
+        if(blit_mips) {
+            usage |= ImageUsage::CopySrc;
+        }
         m_image = Image::create(device, {
             .format = m_format, .extent = Math::Vec3u(m_width, m_height, 1),
-            .usage = Flags<ImageUsage>(ImageUsage::Sampled) | Flags<ImageUsage>(ImageUsage::CopyDst)
+            .usage = usage,
+            .mip_levels = blit_mips || filter_mips ? full_mip_levels : 1
         }, SampleCount::Count1, "texture image");
         m_image_view = std::make_shared<ImageView>(device, *m_image, Flags<ImageAspect>(ImageAspect::Color));
 
-        auto stage_buffer = Buffer::create_upload_buffer(
-            device,
-            Flags<BufferUsage>(BufferUsage::CopySrc),
-            size,
-            data,
-            "texture upload buffer");
-
-        const auto ctx = device.create_command_context();
-        // 1. Transition image layout from UNDEFINED to TRANSFER_DST_OPTIMAL
-        ctx->transition_image_layout(m_image->get(),
-            vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal);
-
-        // 2. Copy buffer to image
-        const auto extent = Graphics::get_extent(m_image->get_info().extent.x, m_image->get_info().extent.y);
-        ctx->copy_buffer_to_image(stage_buffer->get(), m_image->get(),
-            vk::ImageLayout::eTransferDstOptimal, extent);
+        // 布局转换与拷贝在传输队列上异步完成，像素先拷入可复用的暂存池
+        if(blit_mips) {
+            m_upload_ticket = upload_service.upload_image_and_blit_mips(data, size, *m_image);
+        } else if(filter_mips) {
+            const auto chain = build_rgba8_mip_chain(
+                static_cast<const uint8_t*>(data), m_width, m_height, full_mip_levels,
+                is_srgb8_format(m_format));
+            m_upload_ticket = upload_service.upload_image(chain.data(), chain.size(), *m_image);
+        } else {
+            m_upload_ticket = upload_service.upload_image(data, size, *m_image);
+        }
+    }
 
-        // 3. Transition image layout from TRANSFER_DST_OPTIMAL to SHADER_READ_ONLY_OPTIMAL
-        ctx->transition_image_layout(m_image->get(),
-            vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal);
+    void Texture::create_compressed_image(Device& device, const CompressedTexture& compressed) {
+        if(compressed.mip_levels == 0 || compressed.data.empty()) {
+            LOG_ERROR("Invalid compressed texture: {}x{}, {} level(s)",
+                compressed.width, compressed.height, compressed.mip_levels);
+            return;
+        }
 
-        // 提交并等待完成
-        ctx->submit_and_wait();
+        // 设备未启用 BC 压缩时在 CPU 上解码为 RGBA8，保留烘焙好的 mip 链
+        std::vector<uint8_t> decoded;
+        const void* data = compressed.data.data();
+        size_t size = compressed.data.size();
+        if(!device.get_capability().enabled_features.textureCompressionBC) {
+            decoded = decompress_texture(compressed);
+            if(decoded.empty()) {
+                LOG_ERROR("Failed to decode compressed texture for the RGBA8 fallback");
+                return;
+            }
+            m_format = compressed.srgb ? Format::R8G8B8A8_SRGB : Format::R8G8B8A8_UNORM;
+            data = decoded.data();
+            size = decoded.size();
+        }
 
-        stage_buffer.reset();
+        m_image = Image::create(device, {
+            .format = m_format, .extent = Math::Vec3u(m_width, m_height, 1),
+            .usage = Flags<ImageUsage>(ImageUsage::Sampled) | ImageUsage::CopyDst,
+            .mip_levels = compressed.mip_levels
+        }, SampleCount::Count1, "compressed texture image");
+        m_image_view = std::make_shared<ImageView>(device, *m_image, Flags<ImageAspect>(ImageAspect::Color));
+        m_upload_ticket = device.get_upload_service().upload_image(data, size, *m_image);
     }
 }
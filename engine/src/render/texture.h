@@ -2,6 +2,7 @@
 #include "common/export.h"
 #include "graphics/vk_common.h"
 #include "graphics/convert.h"
+#include "graphics/upload_ticket.h"
 #include "core/math_utils.h"
 
 namespace Comet {
@@ -9,20 +10,29 @@ namespace Comet {
     class ImageView;
     class Buffer;
     class Device;
+    struct CompressedTexture;
 
     class COMET_API Texture {
     public:
         explicit Texture(Device& device, const std::string& img_path, Format format = Format::B8G8R8A8_UNORM);
         Texture(Device& device, int width, int height, Math::Vec4u color);
+        // `pixels` are already in the channel order of `format`.
+        Texture(Device& device, int width, int height, const uint8_t* pixels, Format format);
+        // Uploads a cooked BCn mip chain as is, or decoded to RGBA8 when the
+        // device did not enable textureCompressionBC.
+        Texture(Device& device, const CompressedTexture& compressed);
         ~Texture();
 
         [[nodiscard]] int get_width() const { return m_width; }
         [[nodiscard]] int get_height() const { return m_height; }
         [[nodiscard]] int get_channels() const { return m_channels; }
+        [[nodiscard]] uint32_t get_mip_levels() const;
         [[nodiscard]] std::shared_ptr<Image> get_image() const { return m_image; }
         [[nodiscard]] std::shared_ptr<ImageView> get_image_view() const { return m_image_view; }
+        [[nodiscard]] UploadTicket get_upload_ticket() const { return m_upload_ticket; }
     private:
         void create_image(Device& device, size_t size, const void* data);
+        void create_compressed_image(Device& device, const CompressedTexture& compressed);
 
         int m_width;
         int m_height;
@@ -30,5 +40,6 @@ namespace Comet {
         Format m_format;
         std::shared_ptr<Image> m_image;
         std::shared_ptr<ImageView> m_image_view;
+        UploadTicket m_upload_ticket;
     };
 }
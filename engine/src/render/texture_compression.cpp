@@ -0,0 +1,621 @@
+#include "texture_compression.h"
+
+#include "common/logger.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace Comet {
+    namespace {
+        constexpr uint32_t BLOCK_TEXELS = COMPRESSION_BLOCK_EXTENT * COMPRESSION_BLOCK_EXTENT;
+        constexpr std::size_t RGBA8_TEXEL_SIZE = 4;
+
+        using Texel = std::array<int, 4>;
+
+        int squared_distance(const Texel& a, const Texel& b, const int channels) {
+            int distance = 0;
+            for(int channel = 0; channel < channels; ++channel) {
+                const int delta = a[channel] - b[channel];
+                distance += delta * delta;
+            }
+            return distance;
+        }
+
+        // Endpoints of the block's principal axis over the first `channels`
+        // channels: the mean plus the texels with the smallest and largest
+        // projection onto the dominant eigenvector of the covariance.
+        std::pair<Texel, Texel> principal_endpoints(const uint8_t* rgba, const int channels) {
+            std::array<float, 4> mean{};
+            for(uint32_t texel = 0; texel < BLOCK_TEXELS; ++texel) {
+                for(int channel = 0; channel < channels; ++channel) {
+                    mean[channel] += rgba[texel * RGBA8_TEXEL_SIZE + channel];
+                }
+            }
+            for(float& value : mean) {
+                value /= BLOCK_TEXELS;
+            }
+
+            std::array<std::array<float, 4>, 4> covariance{};
+            for(uint32_t texel = 0; texel < BLOCK_TEXELS; ++texel) {
+                for(int row = 0; row < channels; ++row) {
+                    const float a = rgba[texel * RGBA8_TEXEL_SIZE + row] - mean[row];
+                    for(int column = 0; column < channels; ++column) {
+                        covariance[row][column] += a * (rgba[texel * RGBA8_TEXEL_SIZE + column] - mean[column]);
+                    }
+                }
+            }
+
+            // A few power iterations are plenty for a 4x4 block.
+            std::array<float, 4> axis{1.0f, 1.0f, 1.0f, 1.0f};
+            for(int iteration = 0; iteration < 8; ++iteration) {
+                std::array<float, 4> next{};
+                float length = 0.0f;
+                for(int row = 0; row < channels; ++row) {
+                    for(int column = 0; column < channels; ++column) {
+                        next[row] += covariance[row][column] * axis[column];
+                    }
+                    length = std::max(length, std::abs(next[row]));
+                }
+                if(length == 0.0f) {
+                    break;
+                }
+                for(int channel = 0; channel < channels; ++channel) {
+                    axis[channel] = next[channel] / length;
+                }
+            }
+
+            float lowest = std::numeric_limits<float>::max();
+            float highest = std::numeric_limits<float>::lowest();
+            for(uint32_t texel = 0; texel < BLOCK_TEXELS; ++texel) {
+                float projection = 0.0f;
+                for(int channel = 0; channel < channels; ++channel) {
+                    projection += (rgba[texel * RGBA8_TEXEL_SIZE + channel] - mean[channel]) * axis[channel];
+                }
+                lowest = std::min(lowest, projection);
+                highest = std::max(highest, projection);
+            }
+
+            float axis_length_squared = 0.0f;
+            for(int channel = 0; channel < channels; ++channel) {
+                axis_length_squared += axis[channel] * axis[channel];
+            }
+            Texel low{};
+            Texel high{};
+            for(int channel = 0; channel < channels; ++channel) {
+                const float direction = axis_length_squared > 0.0f ? axis[channel] / axis_length_squared : 0.0f;
+                low[channel] = std::clamp(static_cast<int>(std::lround(mean[channel] + lowest * direction)), 0, 255);
+                high[channel] = std::clamp(static_cast<int>(std::lround(mean[channel] + highest * direction)), 0, 255);
+            }
+            return {low, high};
+        }
+
+        // BC1 colour block
+
+        uint16_t pack_565(const Texel& color) {
+            const int r = (color[0] * 31 + 127) / 255;
+            const int g = (color[1] * 63 + 127) / 255;
+            const int b = (color[2] * 31 + 127) / 255;
+            return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+        }
+
+        Texel unpack_565(const uint16_t packed) {
+            const int r = (packed >> 11) & 0x1F;
+            const int g = (packed >> 5) & 0x3F;
+            const int b = packed & 0x1F;
+            return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 255};
+        }
+
+        std::array<Texel, 4> bc1_palette(const uint16_t color0, const uint16_t color1, const bool four_color) {
+            const Texel c0 = unpack_565(color0);
+            const Texel c1 = unpack_565(color1);
+            std::array<Texel, 4> palette{c0, c1, {}, {}};
+            for(int channel = 0; channel < 3; ++channel) {
+                if(four_color) {
+                    palette[2][channel] = (2 * c0[channel] + c1[channel] + 1) / 3;
+                    palette[3][channel] = (c0[channel] + 2 * c1[channel] + 1) / 3;
+                } else {
+                    palette[2][channel] = (c0[channel] + c1[channel]) / 2;
+                    palette[3][channel] = 0;
+                }
+            }
+            palette[2][3] = 255;
+            palette[3][3] = four_color ? 255 : 0;
+            return palette;
+        }
+
+        void encode_bc1_block(const uint8_t* rgba, uint8_t* block) {
+            const auto [low, high] = principal_endpoints(rgba, 3);
+            uint16_t color0 = pack_565(high);
+            uint16_t color1 = pack_565(low);
+            // color0 > color1 selects the opaque four-colour mode.
+            if(color0 < color1) {
+                std::swap(color0, color1);
+            }
+
+            uint32_t indices = 0;
+            if(color0 != color1) {
+                const auto palette = bc1_palette(color0, color1, true);
+                for(uint32_t texel = 0; texel < BLOCK_TEXELS; ++texel) {
+                    const Texel color{rgba[texel * 4], rgba[texel * 4 + 1], rgba[texel * 4 + 2], 255};
+                    uint32_t best = 0;
+                    int best_distance = std::numeric_limits<int>::max();
+                    for(uint32_t entry = 0; entry < 4; ++entry) {
+                        const int distance = squared_distance(color, palette[entry], 3);
+                        if(distance < best_distance) {
+                            best_distance = distance;
+                            best = entry;
+                        }
+                    }
+                    indices |= best << (2 * texel);
+                }
+            }
+
+            std::memcpy(block, &color0, sizeof(color0));
+            std::memcpy(block + 2, &color1, sizeof(color1));
+            std::memcpy(block + 4, &indices, sizeof(indices));
+        }
+
+        // `force_four_color` matches BC2/BC3, whose colour block ignores the
+        // endpoint order.
+        void decode_bc1_block(const uint8_t* block, uint8_t* rgba, const bool force_four_color) {
+            uint16_t color0 = 0;
+            uint16_t color1 = 0;
+            uint32_t indices = 0;
+            std::memcpy(&color0, block, sizeof(color0));
+            std::memcpy(&color1, block + 2, sizeof(color1));
+            std::memcpy(&indices, block + 4, sizeof(indices));
+            const auto palette = bc1_palette(color0, color1, force_four_color || color0 > color1);
+            for(uint32_t texel = 0; texel < BLOCK_TEXELS; ++texel) {
+                const Texel& color = palette[(indices >> (2 * texel)) & 0x3];
+                for(int channel = 0; channel < 4; ++channel) {
+                    rgba[texel * 4 + channel] = static_cast<uint8_t>(color[channel]);
+                }
+            }
+        }
+
+        // BC4 single-channel block, used for BC3 alpha and both BC5 channels
+
+        std::array<int, 8> bc4_palette(const int value0, const int value1) {
+            std::array<int, 8> palette{value0, value1};
+            if(value0 > value1) {
+                for(int step = 1; step < 7; ++step) {
+                    palette[step + 1] = ((7 - step) * value0 + step * value1 + 3) / 7;
+                }
+            } else {
+                for(int step = 1; step < 5; ++step) {
+                    palette[step + 1] = ((5 - step) * value0 + step * value1 + 2) / 5;
+                }
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+            return palette;
+        }
+
+        void encode_bc4_block(const uint8_t* rgba, const int channel, uint8_t* block) {
+            int lowest = 255;
+            int highest = 0;
+            for(uint32_t texel = 0; texel < BLOCK_TEXELS; ++texel) {
+                lowest = std::min<int>(lowest, rgba[texel * 4 + channel]);
+                highest = std::max<int>(highest, rgba[texel * 4 + channel]);
+            }
+
+            uint64_t indices = 0;
+            if(highest != lowest) {
+                // value0 > value1 selects the eight-value mode.
+                const auto palette = bc4_palette(highest, lowest);
+                for(uint32_t texel = 0; texel < BLOCK_TEXELS; ++texel) {
+                    const int value = rgba[texel * 4 + channel];
+                    uint64_t best = 0;
+                    int best_distance = std::numeric_limits<int>::max();
+                    for(uint64_t entry = 0; entry < 8; ++entry) {
+                        const int distance = std::abs(value - palette[entry]);
+                        if(distance < best_distance) {
+                            best_distance = distance;
+                            best = entry;
+                        }
+                    }
+                    indices |= best << (3 * texel);
+                }
+            }
+
+            block[0] = static_cast<uint8_t>(highest);
+            block[1] = static_cast<uint8_t>(lowest);
+            for(int byte = 0; byte < 6; ++byte) {
+                block[2 + byte] = static_cast<uint8_t>(indices >> (8 * byte));
+            }
+        }
+
+        void decode_bc4_block(const uint8_t* block, const int channel, uint8_t* rgba) {
+            const auto palette = bc4_palette(block[0], block[1]);
+            uint64_t indices = 0;
+            for(int byte = 0; byte < 6; ++byte) {
+                indices |= static_cast<uint64_t>(block[2 + byte]) << (8 * byte);
+            }
+            for(uint32_t texel = 0; texel < BLOCK_TEXELS; ++texel) {
+                rgba[texel * 4 + channel] = static_cast<uint8_t>(palette[(indices >> (3 * texel)) & 0x7]);
+            }
+        }
+
+        // BC7 mode 6: one subset, RGBA 7.7.7.7 endpoints with a unique
+        // p-bit each and 4-bit indices.
+
+        constexpr std::array<int, 16> BC7_WEIGHTS_4{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        constexpr uint8_t BC7_MODE_6 = 1u << 6;
+
+        class BlockBits {
+        public:
+            explicit BlockBits(uint8_t* block) : m_block(block) {}
+
+            void write(const uint32_t value, const uint32_t count) {
+                for(uint32_t bit = 0; bit < count; ++bit, ++m_position) {
+                    if((value >> bit) & 1u) {
+                        m_block[m_position / 8] |= static_cast<uint8_t>(1u << (m_position % 8));
+                    }
+                }
+            }
+
+            [[nodiscard]] uint32_t read(const uint32_t count) {
+                uint32_t value = 0;
+                for(uint32_t bit = 0; bit < count; ++bit, ++m_position) {
+                    value |= static_cast<uint32_t>((m_block[m_position / 8] >> (m_position % 8)) & 1u) << bit;
+                }
+                return value;
+            }
+
+        private:
+            uint8_t* m_block;
+            uint32_t m_position = 0;
+        };
+
+        Texel bc7_interpolate(const Texel& endpoint0, const Texel& endpoint1, const int weight) {
+            Texel color{};
+            for(int channel = 0; channel < 4; ++channel) {
+                color[channel] = ((64 - weight) * endpoint0[channel] + weight * endpoint1[channel] + 32) >> 6;
+            }
+            return color;
+        }
+
+        // Picks the p-bit that reconstructs `endpoint` best and returns the
+        // 7-bit channel values.
+        Texel quantize_bc7_endpoint(const Texel& endpoint, uint32_t& p_bit) {
+            Texel best{};
+            int best_error = std::numeric_limits<int>::max();
+            for(uint32_t candidate = 0; candidate < 2; ++candidate) {
+                Texel quantized{};
+                int error = 0;
+                for(int channel = 0; channel < 4; ++channel) {
+                    const int value = std::clamp((endpoint[channel] - static_cast<int>(candidate) + 1) / 2, 0, 127);
+                    quantized[channel] = value;
+                    const int delta = endpoint[channel] - (value * 2 + static_cast<int>(candidate));
+                    error += delta * delta;
+                }
+                if(error < best_error) {
+                    best_error = error;
+                    best = quantized;
+                    p_bit = candidate;
+                }
+            }
+            return best;
+        }
+
+        Texel expand_bc7_endpoint(const Texel& quantized, const uint32_t p_bit) {
+            Texel endpoint{};
+            for(int channel = 0; channel < 4; ++channel) {
+                endpoint[channel] = (quantized[channel] << 1) | static_cast<int>(p_bit);
+            }
+            return endpoint;
+        }
+
+        void encode_bc7_block(const uint8_t* rgba, uint8_t* block) {
+            const auto [low, high] = principal_endpoints(rgba, 4);
+            std::array<uint32_t, 2> p_bits{};
+            std::array<Texel, 2> quantized{
+                quantize_bc7_endpoint(low, p_bits[0]),
+                quantize_bc7_endpoint(high, p_bits[1])
+            };
+            std::array<Texel, 2> endpoints{
+                expand_bc7_endpoint(quantized[0], p_bits[0]),
+                expand_bc7_endpoint(quantized[1], p_bits[1])
+            };
+
+            std::array<Texel, 16> palette{};
+            for(std::size_t entry = 0; entry < palette.size(); ++entry) {
+                palette[entry] = bc7_interpolate(endpoints[0], endpoints[1], BC7_WEIGHTS_4[entry]);
+            }
+            std::array<uint32_t, BLOCK_TEXELS> indices{};
+            for(uint32_t texel = 0; texel < BLOCK_TEXELS; ++texel) {
+                const Texel color{rgba[texel * 4], rgba[texel * 4 + 1], rgba[texel * 4 + 2], rgba[texel * 4 + 3]};
+                int best_distance = std::numeric_limits<int>::max();
+                for(uint32_t entry = 0; entry < palette.size(); ++entry) {
+                    const int distance = squared_distance(color, palette[entry], 4);
+                    if(distance < best_distance) {
+                        best_distance = distance;
+                        indices[texel] = entry;
+                    }
+                }
+            }
+
+            // The anchor texel stores only three index bits, so its index
+            // must be in the lower half; swapping the endpoints mirrors it.
+            if(indices[0] >= 8) {
+                std::swap(quantized[0], quantized[1]);
+                std::swap(p_bits[0], p_bits[1]);
+                for(uint32_t& index : indices) {
+                    index = 15 - index;
+                }
+            }
+
+            std::memset(block, 0, 16);
+            BlockBits bits(block);
+            bits.write(BC7_MODE_6, 7);
+            for(int channel = 0; channel < 4; ++channel) {
+                bits.write(static_cast<uint32_t>(quantized[0][channel]), 7);
+                bits.write(static_cast<uint32_t>(quantized[1][channel]), 7);
+            }
+            bits.write(p_bits[0], 1);
+            bits.write(p_bits[1], 1);
+            for(uint32_t texel = 0; texel < BLOCK_TEXELS; ++texel) {
+                bits.write(indices[texel], texel == 0 ? 3 : 4);
+            }
+        }
+
+        bool decode_bc7_block(const uint8_t* block, uint8_t* rgba) {
+            // The mode is the position of the lowest set bit.
+            if((block[0] & 0x7F) != BC7_MODE_6) {
+                return false;
+            }
+            std::array<uint8_t, 16> copy{};
+            std::memcpy(copy.data(), block, copy.size());
+            BlockBits bits(copy.data());
+            (void)bits.read(7);
+
+            std::array<Texel, 2> quantized{};
+            for(int channel = 0; channel < 4; ++channel) {
+                quantized[0][channel] = static_cast<int>(bits.read(7));
+                quantized[1][channel] = static_cast<int>(bits.read(7));
+            }
+            const uint32_t p_bit0 = bits.read(1);
+            const uint32_t p_bit1 = bits.read(1);
+            const Texel endpoint0 = expand_bc7_endpoint(quantized[0], p_bit0);
+            const Texel endpoint1 = expand_bc7_endpoint(quantized[1], p_bit1);
+            for(uint32_t texel = 0; texel < BLOCK_TEXELS; ++texel) {
+                const uint32_t index = bits.read(texel == 0 ? 3 : 4);
+                const Texel color = bc7_interpolate(endpoint0, endpoint1, BC7_WEIGHTS_4[index]);
+                for(int channel = 0; channel < 4; ++channel) {
+                    rgba[texel * 4 + channel] = static_cast<uint8_t>(color[channel]);
+                }
+            }
+            return true;
+        }
+
+        // Copies the 4x4 block at (block_x, block_y), repeating the last row
+        // and column of levels smaller than a block.
+        void gather_block(const uint8_t* level, const uint32_t width, const uint32_t height,
+                          const uint32_t block_x, const uint32_t block_y, uint8_t* rgba) {
+            for(uint32_t y = 0; y < COMPRESSION_BLOCK_EXTENT; ++y) {
+                const uint32_t source_y = std::min(block_y * COMPRESSION_BLOCK_EXTENT + y, height - 1);
+                for(uint32_t x = 0; x < COMPRESSION_BLOCK_EXTENT; ++x) {
+                    const uint32_t source_x = std::min(block_x * COMPRESSION_BLOCK_EXTENT + x, width - 1);
+                    std::memcpy(rgba + (y * COMPRESSION_BLOCK_EXTENT + x) * RGBA8_TEXEL_SIZE,
+                        level + (static_cast<std::size_t>(source_y) * width + source_x) * RGBA8_TEXEL_SIZE,
+                        RGBA8_TEXEL_SIZE);
+                }
+            }
+        }
+
+        constexpr char CTEX_MAGIC[4] = {'C', 'T', 'E', 'X'};
+        constexpr uint32_t CTEX_VERSION = 1;
+
+        struct CompressedTextureHeader {
+            char magic[4];
+            uint32_t version;
+            uint32_t compression;
+            uint32_t srgb;
+            uint32_t width;
+            uint32_t height;
+            uint32_t mip_levels;
+            uint32_t reserved;
+            uint64_t data_size;
+        };
+    }
+
+    std::vector<MipLevel> CompressedTexture::describe_levels() const {
+        return describe_mip_chain(width, height, mip_levels, compressed_block_size(compression),
+            COMPRESSION_BLOCK_EXTENT);
+    }
+
+    std::size_t compressed_block_size(const TextureCompression compression) {
+        return compression == TextureCompression::BC1 ? 8 : 16;
+    }
+
+    void encode_block(const TextureCompression compression, const uint8_t* rgba, uint8_t* block) {
+        switch(compression) {
+            case TextureCompression::BC1:
+                encode_bc1_block(rgba, block);
+                break;
+            case TextureCompression::BC3:
+                encode_bc4_block(rgba, 3, block);
+                encode_bc1_block(rgba, block + 8);
+                break;
+            case TextureCompression::BC5:
+                encode_bc4_block(rgba, 0, block);
+                encode_bc4_block(rgba, 1, block + 8);
+                break;
+            case TextureCompression::BC7:
+                encode_bc7_block(rgba, block);
+                break;
+        }
+    }
+
+    bool decode_block(const TextureCompression compression, const uint8_t* block, uint8_t* rgba) {
+        switch(compression) {
+            case TextureCompression::BC1:
+                decode_bc1_block(block, rgba, false);
+                return true;
+            case TextureCompression::BC3:
+                decode_bc1_block(block + 8, rgba, true);
+                decode_bc4_block(block, 3, rgba);
+                return true;
+            case TextureCompression::BC5:
+                decode_bc4_block(block, 0, rgba);
+                decode_bc4_block(block + 8, 1, rgba);
+                for(uint32_t texel = 0; texel < BLOCK_TEXELS; ++texel) {
+                    rgba[texel * 4 + 2] = 0;
+                    rgba[texel * 4 + 3] = 255;
+                }
+                return true;
+            case TextureCompression::BC7:
+                return decode_bc7_block(block, rgba);
+        }
+        return false;
+    }
+
+    CompressedTexture compress_texture(const uint8_t* pixels, const uint32_t width, const uint32_t height,
+                                       const TextureCompression compression, const bool srgb,
+                                       const bool generate_mips) {
+        CompressedTexture texture;
+        texture.compression = compression;
+        texture.srgb = srgb;
+        texture.width = width;
+        texture.height = height;
+        if(!pixels || width == 0 || height == 0) {
+            LOG_ERROR("Cannot compress an empty {}x{} texture", width, height);
+            return texture;
+        }
+
+        texture.mip_levels = generate_mips ? compute_mip_level_count(width, height) : 1;
+        const auto source = build_rgba8_mip_chain(pixels, width, height, texture.mip_levels, srgb);
+        const auto source_levels = describe_mip_chain(width, height, texture.mip_levels, RGBA8_TEXEL_SIZE);
+        const auto levels = texture.describe_levels();
+        texture.data.resize(levels.back().offset + levels.back().size);
+
+        const std::size_t block_size = compressed_block_size(compression);
+        std::array<uint8_t, BLOCK_TEXELS * RGBA8_TEXEL_SIZE> rgba{};
+        for(std::size_t level = 0; level < levels.size(); ++level) {
+            const MipLevel& mip = levels[level];
+            const uint32_t blocks_wide = (mip.width + COMPRESSION_BLOCK_EXTENT - 1) / COMPRESSION_BLOCK_EXTENT;
+            const uint32_t blocks_high = (mip.height + COMPRESSION_BLOCK_EXTENT - 1) / COMPRESSION_BLOCK_EXTENT;
+            uint8_t* destination = texture.data.data() + mip.offset;
+            for(uint32_t block_y = 0; block_y < blocks_high; ++block_y) {
+                for(uint32_t block_x = 0; block_x < blocks_wide; ++block_x) {
+                    gather_block(source.data() + source_levels[level].offset, mip.width, mip.height,
+                        block_x, block_y, rgba.data());
+                    encode_block(compression, rgba.data(), destination);
+                    destination += block_size;
+                }
+            }
+        }
+        return texture;
+    }
+
+    std::vector<uint8_t> decompress_texture(const CompressedTexture& texture) {
+        if(texture.mip_levels == 0) {
+            return {};
+        }
+        const auto levels = texture.describe_levels();
+        if(texture.data.size() != levels.back().offset + levels.back().size) {
+            LOG_ERROR("Compressed texture holds {} bytes, expected {}",
+                texture.data.size(), levels.back().offset + levels.back().size);
+            return {};
+        }
+
+        const auto target_levels = describe_mip_chain(
+            texture.width, texture.height, texture.mip_levels, RGBA8_TEXEL_SIZE);
+        std::vector<uint8_t> pixels(target_levels.back().offset + target_levels.back().size);
+        const std::size_t block_size = compressed_block_size(texture.compression);
+        std::array<uint8_t, BLOCK_TEXELS * RGBA8_TEXEL_SIZE> rgba{};
+        for(std::size_t level = 0; level < levels.size(); ++level) {
+            const MipLevel& mip = levels[level];
+            const uint32_t blocks_wide = (mip.width + COMPRESSION_BLOCK_EXTENT - 1) / COMPRESSION_BLOCK_EXTENT;
+            const uint32_t blocks_high = (mip.height + COMPRESSION_BLOCK_EXTENT - 1) / COMPRESSION_BLOCK_EXTENT;
+            const uint8_t* source = texture.data.data() + mip.offset;
+            uint8_t* target = pixels.data() + target_levels[level].offset;
+            for(uint32_t block_y = 0; block_y < blocks_high; ++block_y) {
+                for(uint32_t block_x = 0; block_x < blocks_wide; ++block_x) {
+                    if(!decode_block(texture.compression, source, rgba.data())) {
+                        LOG_ERROR("Unsupported block in level {} of a compressed texture", level);
+                        return {};
+                    }
+                    source += block_size;
+                    for(uint32_t y = 0; y < COMPRESSION_BLOCK_EXTENT; ++y) {
+                        const uint32_t target_y = block_y * COMPRESSION_BLOCK_EXTENT + y;
+                        if(target_y >= mip.height) {
+                            break;
+                        }
+                        const uint32_t first_x = block_x * COMPRESSION_BLOCK_EXTENT;
+                        const uint32_t copied = std::min(COMPRESSION_BLOCK_EXTENT, mip.width - first_x);
+                        std::memcpy(target + (static_cast<std::size_t>(target_y) * mip.width + first_x) * RGBA8_TEXEL_SIZE,
+                            rgba.data() + y * COMPRESSION_BLOCK_EXTENT * RGBA8_TEXEL_SIZE,
+                            copied * RGBA8_TEXEL_SIZE);
+                    }
+                }
+            }
+        }
+        return pixels;
+    }
+
+    bool save_compressed_texture(const std::string& path, const CompressedTexture& texture) {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        if(!output.is_open()) {
+            LOG_ERROR("Failed to open compressed texture for writing: {}", path);
+            return false;
+        }
+        CompressedTextureHeader header{};
+        std::memcpy(header.magic, CTEX_MAGIC, sizeof(CTEX_MAGIC));
+        header.version = CTEX_VERSION;
+        header.compression = static_cast<uint32_t>(texture.compression);
+        header.srgb = texture.srgb ? 1 : 0;
+        header.width = texture.width;
+        header.height = texture.height;
+        header.mip_levels = texture.mip_levels;
+        header.data_size = texture.data.size();
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char*>(texture.data.data()),
+            static_cast<std::streamsize>(texture.data.size()));
+        if(!output) {
+            LOG_ERROR("Failed to write compressed texture: {}", path);
+            return false;
+        }
+        return true;
+    }
+
+    bool load_compressed_texture(const std::string& path, CompressedTexture& texture) {
+        std::ifstream input(path, std::ios::binary);
+        if(!input.is_open()) {
+            LOG_ERROR("Compressed texture file not found: {}", path);
+            return false;
+        }
+        CompressedTextureHeader header{};
+        input.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if(!input || std::memcmp(header.magic, CTEX_MAGIC, sizeof(CTEX_MAGIC)) != 0
+           || header.version != CTEX_VERSION
+           || header.compression > static_cast<uint32_t>(TextureCompression::BC7)) {
+            LOG_ERROR("Not a compressed texture file: {}", path);
+            return false;
+        }
+
+        CompressedTexture loaded;
+        loaded.compression = static_cast<TextureCompression>(header.compression);
+        loaded.srgb = header.srgb != 0;
+        loaded.width = header.width;
+        loaded.height = header.height;
+        loaded.mip_levels = header.mip_levels;
+        const auto levels = loaded.describe_levels();
+        if(levels.empty() || header.data_size != levels.back().offset + levels.back().size) {
+            LOG_ERROR("Compressed texture {} has an inconsistent size", path);
+            return false;
+        }
+        loaded.data.resize(header.data_size);
+        input.read(reinterpret_cast<char*>(loaded.data.data()), static_cast<std::streamsize>(loaded.data.size()));
+        if(!input) {
+            LOG_ERROR("Failed to read compressed texture: {}", path);
+            return false;
+        }
+        texture = std::move(loaded);
+        return true;
+    }
+}
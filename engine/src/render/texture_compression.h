@@ -0,0 +1,62 @@
+#pragma once
+
+#include "common/export.h"
+#include "core/mip_chain.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Comet {
+    enum class TextureCompression : uint8_t {
+        BC1, // RGB, 8 bytes per block
+        BC3, // RGBA with interpolated alpha, 16 bytes per block
+        BC5, // two channels (normal maps), 16 bytes per block
+        BC7, // RGBA, 16 bytes per block
+    };
+
+    // Block-compressed mip chain, laid out like describe_mip_chain() with
+    // 4x4 blocks, largest level first.
+    struct CompressedTexture {
+        TextureCompression compression = TextureCompression::BC7;
+        bool srgb = false;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t mip_levels = 0;
+        std::vector<uint8_t> data;
+
+        [[nodiscard]] std::vector<MipLevel> describe_levels() const;
+    };
+
+    inline constexpr uint32_t COMPRESSION_BLOCK_EXTENT = 4;
+
+    [[nodiscard]] COMET_API std::size_t compressed_block_size(TextureCompression compression);
+
+    // Encodes one 4x4 block of RGBA8 texels (row-major, 64 bytes). BC1
+    // ignores alpha, BC5 keeps red and green. The BC7 encoder only emits
+    // mode 6 (one RGBA subset with 4-bit indices), which trades peak quality
+    // for a simple, fast cook step.
+    COMET_API void encode_block(TextureCompression compression, const uint8_t* rgba, uint8_t* block);
+
+    // Inverse of encode_block for the blocks it produces. BC7 blocks in
+    // modes other than 6 are not decoded and return false.
+    COMET_API bool decode_block(TextureCompression compression, const uint8_t* block, uint8_t* rgba);
+
+    // Cook step: compresses an RGBA8 image, building the full mip chain
+    // first when `generate_mips` is set; sRGB chains are filtered in
+    // linear space.
+    [[nodiscard]] COMET_API CompressedTexture compress_texture(const uint8_t* pixels, uint32_t width,
+                                                               uint32_t height, TextureCompression compression,
+                                                               bool srgb, bool generate_mips);
+
+    // Expands every level back to RGBA8 for devices without BC support,
+    // laid out like describe_mip_chain(width, height, mip_levels, 4).
+    // Returns an empty vector when a block cannot be decoded.
+    [[nodiscard]] COMET_API std::vector<uint8_t> decompress_texture(const CompressedTexture& texture);
+
+    // Cooked texture files (.ctex): a small header followed by the chain.
+    COMET_API bool save_compressed_texture(const std::string& path, const CompressedTexture& texture);
+
+    [[nodiscard]] COMET_API bool load_compressed_texture(const std::string& path, CompressedTexture& texture);
+}
@@ -0,0 +1,178 @@
+#include "texture_loader.h"
+
+#include <stb_image.h>
+
+#include "common/logger.h"
+#include "common/profiler.h"
+#include "core/texel_swizzle.h"
+#include "graphics/device.h"
+#include "graphics/upload_service.h"
+#include "texture.h"
+#include "texture_compression.h"
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+
+namespace Comet {
+    namespace {
+        // Texel bytes turned into textures per update(); keeps a burst of
+        // finished decodes from stalling one frame. At least one image is
+        // always taken so large textures still make progress.
+        constexpr std::size_t UPDATE_UPLOAD_BUDGET = 32 * 1024 * 1024;
+    }
+
+    struct TextureLoader::DecodedImage {
+        std::shared_ptr<AsyncTexture> target;
+        Format format = Format::UNDEFINED;
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> pixels;
+        std::optional<CompressedTexture> compressed;
+        bool failed = false;
+
+        [[nodiscard]] std::size_t get_size() const {
+            return compressed ? compressed->data.size() : pixels.size();
+        }
+    };
+
+    AsyncTexture::AsyncTexture(std::string path, std::shared_ptr<Texture> placeholder)
+        : m_path(std::move(path)), m_placeholder(std::move(placeholder)) {}
+
+    void AsyncTexture::on_ready(ReadyCallback callback) {
+        if(m_ready) {
+            callback(m_texture);
+        } else if(!m_failed) {
+            m_callbacks.push_back(std::move(callback));
+        }
+    }
+
+    void AsyncTexture::resolve(std::shared_ptr<Texture> texture) {
+        if(!texture) {
+            m_failed = true;
+            m_callbacks.clear();
+            return;
+        }
+        m_texture = std::move(texture);
+        m_ready = true;
+        auto callbacks = std::move(m_callbacks);
+        m_callbacks.clear();
+        for(auto& callback: callbacks) {
+            callback(m_texture);
+        }
+    }
+
+    TextureLoader::TextureLoader(Device& device, const uint32_t thread_count)
+        : m_device(device),
+          m_placeholder(std::make_shared<Texture>(device, 1, 1, Math::Vec4u(255, 255, 255, 255))),
+          m_decoders(thread_count) {
+        LOG_INFO("Texture loader using {} decode thread(s)", m_decoders.thread_count());
+    }
+
+    TextureLoader::~TextureLoader() = default;
+
+    std::shared_ptr<AsyncTexture> TextureLoader::load(const std::string& path, const Format format) {
+        auto target = std::make_shared<AsyncTexture>(path, m_placeholder);
+        ++m_pending_count;
+        m_decoders.submit([this, target, format] { decode(target, format); });
+        return target;
+    }
+
+    std::shared_ptr<AsyncTexture> TextureLoader::wrap(const std::string& path,
+                                                      std::shared_ptr<Texture> texture) const {
+        auto target = std::make_shared<AsyncTexture>(path, m_placeholder);
+        target->resolve(std::move(texture));
+        return target;
+    }
+
+    void TextureLoader::decode(const std::shared_ptr<AsyncTexture>& target, const Format format) {
+        PROFILE_SCOPE("TextureLoader::decode");
+        auto image = std::make_unique<DecodedImage>();
+        image->target = target;
+        image->format = format;
+
+        const std::string& path = target->get_path();
+        if(path.ends_with(".ctex")) {
+            CompressedTexture compressed;
+            if(load_compressed_texture(path, compressed)) {
+                image->width = static_cast<int>(compressed.width);
+                image->height = static_cast<int>(compressed.height);
+                image->compressed = std::move(compressed);
+            } else {
+                image->failed = true;
+            }
+        } else {
+            int channels = 0;
+            uint8_t* data = stbi_load(path.c_str(), &image->width, &image->height, &channels, STBI_rgb_alpha);
+            if(data) {
+                const std::size_t texel_count = static_cast<std::size_t>(image->width) * image->height;
+                image->pixels.resize(texel_count * 4);
+                if(Graphics::is_bgra8_format(format)) {
+                    swizzle_rgba8_to_bgra8(data, image->pixels.data(), texel_count);
+                } else {
+                    std::copy_n(data, image->pixels.size(), image->pixels.data());
+                }
+                stbi_image_free(data);
+            } else {
+                LOG_ERROR("Failed to decode texture {}: {}", path, stbi_failure_reason());
+                image->failed = true;
+            }
+        }
+
+        std::lock_guard lock(m_decoded_mutex);
+        m_decoded.push_back(std::move(image));
+    }
+
+    void TextureLoader::update() {
+        PROFILE_SCOPE("TextureLoader::update");
+        auto& upload_service = m_device.get_upload_service();
+
+        // Resolve first so a texture created below is never handed out in
+        // the frame that submits its upload.
+        std::erase_if(m_uploading, [&](PendingUpload& upload) {
+            if(!upload_service.is_complete(upload.texture->get_upload_ticket())) {
+                return false;
+            }
+            upload.target->resolve(std::move(upload.texture));
+            --m_pending_count;
+            return true;
+        });
+
+        std::vector<std::unique_ptr<DecodedImage>> decoded;
+        {
+            std::lock_guard lock(m_decoded_mutex);
+            std::size_t taken_bytes = 0;
+            std::size_t taken = 0;
+            while(taken < m_decoded.size()
+                  && (taken == 0 || taken_bytes + m_decoded[taken]->get_size() <= UPDATE_UPLOAD_BUDGET)) {
+                taken_bytes += m_decoded[taken]->get_size();
+                ++taken;
+            }
+            decoded.assign(std::make_move_iterator(m_decoded.begin()),
+                std::make_move_iterator(m_decoded.begin() + static_cast<std::ptrdiff_t>(taken)));
+            m_decoded.erase(m_decoded.begin(), m_decoded.begin() + static_cast<std::ptrdiff_t>(taken));
+        }
+
+        for(auto& image: decoded) {
+            if(image->failed) {
+                image->target->resolve(nullptr);
+                --m_pending_count;
+                continue;
+            }
+            std::shared_ptr<Texture> texture;
+            if(image->compressed) {
+                texture = std::make_shared<Texture>(m_device, *image->compressed);
+            } else {
+                texture = std::make_shared<Texture>(
+                    m_device, image->width, image->height, image->pixels.data(), image->format);
+            }
+            if(!texture->get_image_view()) {
+                image->target->resolve(nullptr);
+                --m_pending_count;
+                continue;
+            }
+            m_uploading.push_back({std::move(image->target), std::move(texture)});
+        }
+        PROFILE_COUNTER("TextureLoader::pending", static_cast<int64_t>(m_pending_count));
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "common/export.h"
+#include "core/task_queue.h"
+#include "graphics/enums.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Comet {
+    class Device;
+    class Texture;
+
+    // Texture being loaded by a TextureLoader. Until its upload has
+    // completed, get() returns the loader's placeholder so materials can
+    // bind something immediately. Only touched from the thread calling
+    // TextureLoader::update().
+    class COMET_API AsyncTexture {
+    public:
+        using ReadyCallback = std::function<void(const std::shared_ptr<Texture>&)>;
+
+        AsyncTexture(std::string path, std::shared_ptr<Texture> placeholder);
+
+        [[nodiscard]] const std::shared_ptr<Texture>& get() const { return m_ready ? m_texture : m_placeholder; }
+        [[nodiscard]] bool is_ready() const { return m_ready; }
+        [[nodiscard]] bool has_failed() const { return m_failed; }
+        [[nodiscard]] const std::string& get_path() const { return m_path; }
+
+        // Runs `callback` with the resident texture, immediately when it is
+        // already ready. Never runs for a failed load.
+        void on_ready(ReadyCallback callback);
+
+    private:
+        friend class TextureLoader;
+
+        void resolve(std::shared_ptr<Texture> texture);
+
+        std::string m_path;
+        std::shared_ptr<Texture> m_placeholder;
+        std::shared_ptr<Texture> m_texture;
+        std::vector<ReadyCallback> m_callbacks;
+        bool m_ready = false;
+        bool m_failed = false;
+    };
+
+    // Decodes image files on a TaskQueue and uploads them from update().
+    // Workers run stb_image (or read cooked .ctex files) and swizzle to the
+    // target channel order; update() creates the textures, so all uploads
+    // of one frame share an UploadService batch, and hands them out once
+    // their upload tickets have completed.
+    class COMET_API TextureLoader {
+    public:
+        // A thread count of zero leaves one hardware thread for the caller.
+        TextureLoader(Device& device, uint32_t thread_count);
+
+        ~TextureLoader();
+
+        TextureLoader(const TextureLoader&) = delete;
+
+        TextureLoader& operator=(const TextureLoader&) = delete;
+
+        TextureLoader(TextureLoader&&) noexcept = delete;
+
+        TextureLoader& operator=(TextureLoader&&) noexcept = delete;
+
+        [[nodiscard]] std::shared_ptr<AsyncTexture> load(const std::string& path,
+                                                         Format format = Format::B8G8R8A8_UNORM);
+
+        // Handle for a texture that is already resident.
+        [[nodiscard]] std::shared_ptr<AsyncTexture> wrap(const std::string& path,
+                                                         std::shared_ptr<Texture> texture) const;
+
+        // Creates textures for decoded images, up to a per-call byte budget,
+        // and resolves handles whose uploads have completed. Call once per
+        // frame before recording starts.
+        void update();
+
+        [[nodiscard]] const std::shared_ptr<Texture>& get_placeholder() const { return m_placeholder; }
+
+        // Loads that have not resolved or failed yet.
+        [[nodiscard]] std::size_t get_pending_count() const { return m_pending_count; }
+
+    private:
+        struct DecodedImage;
+
+        struct PendingUpload {
+            std::shared_ptr<AsyncTexture> target;
+            std::shared_ptr<Texture> texture;
+        };
+
+        void decode(const std::shared_ptr<AsyncTexture>& target, Format format);
+
+        Device& m_device;
+        std::shared_ptr<Texture> m_placeholder;
+        std::size_t m_pending_count = 0;
+        std::vector<PendingUpload> m_uploading;
+
+        std::mutex m_decoded_mutex;
+        std::vector<std::unique_ptr<DecodedImage>> m_decoded;
+
+        // Declared last so workers are joined before the state they write.
+        TaskQueue m_decoders;
+    };
+}
@@ -77,6 +77,9 @@ namespace Comet {
         std::function<void(Entity&)> remove_component_callback;
         std::function<void*(Entity&)> mutable_component_accessor;
         std::function<const void*(const Entity&)> const_component_accessor;
+        // Publishes the component's on_update signal after an edit made
+        // through get_component.
+        std::function<void(Entity&)> patch_component_callback;
 
         [[nodiscard]] bool has_component(const Entity& entity) const {
             return has_component_callback && has_component_callback(entity);
@@ -110,6 +113,12 @@ namespace Comet {
                 : nullptr;
         }
 
+        void notify_changed(Entity& entity) const {
+            if(has_component(entity) && patch_component_callback) {
+                patch_component_callback(entity);
+            }
+        }
+
         [[nodiscard]] const PropertyDescriptor* find_property(
             const std::string_view property_id) const {
             for(const PropertyDescriptor& property: properties) {
@@ -224,6 +233,9 @@ namespace Comet {
             },
             .const_component_accessor = [](const Entity& entity) -> const void* {
                 return &entity.get_component<Component>();
+            },
+            .patch_component_callback = [](Entity& entity) {
+                entity.patch_component<Component>();
             }
         };
     }
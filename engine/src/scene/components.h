@@ -5,7 +5,9 @@
 #include "scene/entity_id.h"
 #include "scene/entity_uuid.h"
 
+#include <cstddef>
 #include <string>
+#include <entt.hpp>
 
 namespace Comet {
     struct IdComponent {
@@ -37,6 +39,15 @@ namespace Comet {
 
     struct RelationshipComponent {
         EntityId parent = INVALID_ENTITY_ID;
+
+        // Runtime links maintained by Scene. Siblings form a doubly linked
+        // list in insertion order; roots are chained the same way.
+        entt::entity parent_handle = entt::null;
+        entt::entity first_child = entt::null;
+        entt::entity last_child = entt::null;
+        entt::entity previous_sibling = entt::null;
+        entt::entity next_sibling = entt::null;
+        std::size_t child_count = 0;
     };
 
     struct WorldTransformComponent {
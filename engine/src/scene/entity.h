@@ -18,9 +18,16 @@ namespace Comet {
         template<typename T, typename... Args>
         T& add_component(Args&&... args);
 
+        // Plain access: writes through the returned reference are not
+        // observed. Use patch_component for changes the scene must see.
         template<typename T>
         T& get_component();
 
+        // Applies each func to the component, then publishes its on_update
+        // signal so the scene and its observers pick up the change.
+        template<typename T, typename... Func>
+        T& patch_component(Func&&... func);
+
         template<typename T>
         [[nodiscard]] bool has_component() const;
 
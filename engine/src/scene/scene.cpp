@@ -1,12 +1,38 @@
 #include "scene/scene.h"
 
 #include "common/logger.h"
+#include "core/thread_pool.h"
 
-#include <algorithm>
-#include <unordered_map>
 #include <unordered_set>
 
 namespace Comet {
+    Scene::Scene() {
+        m_registry.on_construct<IdComponent>()
+            .connect<&Scene::on_id_constructed>(*this);
+        m_registry.on_destroy<IdComponent>()
+            .connect<&Scene::on_id_destroyed>(*this);
+        m_registry.on_construct<UuidComponent>()
+            .connect<&Scene::on_uuid_constructed>(*this);
+        m_registry.on_destroy<UuidComponent>()
+            .connect<&Scene::on_uuid_destroyed>(*this);
+
+        m_registry.on_construct<TransformComponent>()
+            .connect<&Scene::on_transform_changed>(*this);
+        m_registry.on_update<TransformComponent>()
+            .connect<&Scene::on_transform_changed>(*this);
+        m_registry.on_destroy<TransformComponent>()
+            .connect<&Scene::on_transform_changed>(*this);
+
+        m_registry.on_construct<RelationshipComponent>()
+            .connect<&Scene::on_relationship_constructed>(*this);
+        m_registry.on_update<RelationshipComponent>()
+            .connect<&Scene::on_relationship_updated>(*this);
+        m_registry.on_destroy<RelationshipComponent>()
+            .connect<&Scene::on_relationship_destroyed>(*this);
+    }
+
+    Scene::~Scene() = default;
+
     Entity Scene::create_entity(const std::string& name) {
         EntityUuid uuid;
         do {
@@ -34,40 +60,145 @@ namespace Comet {
         return entity;
     }
 
-    void Scene::destroy_entity(const Entity entity) {
-        if(!is_valid(entity)) {
-            return;
+    std::vector<Entity> Scene::create_entities(
+        const std::size_t count, const std::span<const std::string> names) {
+        // Random v4 UUIDs only need checking against the scene, as
+        // create_entity does; a collision within the batch is not a concern.
+        std::vector<EntityUuid> uuids;
+        uuids.reserve(count);
+        while(uuids.size() < count) {
+            const EntityUuid uuid = EntityUuid::generate();
+            if(!find_entity(uuid)) {
+                uuids.push_back(uuid);
+            }
         }
+        return emplace_entities(uuids, names, true);
+    }
 
-        std::unordered_set<EntityId> destroying;
-        const auto destroy_subtree = [this, &destroying](
-            const Entity current,
-            const auto& destroy_subtree_ref) -> void {
-            if(!is_valid(current) || !destroying.insert(current.get_id()).second) {
-                return;
+    std::vector<Entity> Scene::create_entities_with_uuids(
+        const std::span<const EntityUuid> uuids, const std::span<const std::string> names,
+        std::size_t* failed_index) {
+        std::unordered_set<EntityUuid> unique_uuids;
+        unique_uuids.reserve(uuids.size());
+        for(std::size_t index = 0; index < uuids.size(); ++index) {
+            const EntityUuid uuid = uuids[index];
+            if(!uuid || find_entity(uuid) || !unique_uuids.insert(uuid).second) {
+                if(failed_index) {
+                    *failed_index = index;
+                }
+                return {};
             }
+        }
+        return emplace_entities(uuids, names, false);
+    }
+
+    std::vector<Entity> Scene::emplace_entities(
+        const std::span<const EntityUuid> uuids, const std::span<const std::string> names,
+        const bool replace_empty_names) {
+        const std::size_t count = uuids.size();
+        const std::size_t total = entity_count() + count;
+        m_entities_by_id.reserve(total);
+        m_entities_by_uuid.reserve(total);
+        m_registry.storage<entt::entity>().reserve(total);
+        m_registry.storage<IdComponent>().reserve(total);
+        m_registry.storage<UuidComponent>().reserve(total);
+        m_registry.storage<NameComponent>().reserve(total);
+        m_registry.storage<TransformComponent>().reserve(total);
+        m_registry.storage<RelationshipComponent>().reserve(total);
+        m_registry.storage<WorldTransformComponent>().reserve(total);
+
+        std::vector<entt::entity> handles(count);
+        m_registry.create(handles.begin(), handles.end());
+
+        std::vector<IdComponent> ids;
+        std::vector<UuidComponent> uuid_components;
+        std::vector<NameComponent> name_components;
+        ids.reserve(count);
+        uuid_components.reserve(count);
+        name_components.reserve(count);
+        for(std::size_t index = 0; index < count; ++index) {
+            ids.push_back({m_next_entity_id++});
+            uuid_components.push_back({uuids[index]});
+            const bool has_name = index < names.size()
+                && (!replace_empty_names || !names[index].empty());
+            name_components.push_back({has_name ? names[index] : "Entity"});
+        }
+
+        m_registry.insert<IdComponent>(handles.begin(), handles.end(), ids.begin());
+        m_registry.insert<UuidComponent>(handles.begin(), handles.end(), uuid_components.begin());
+        m_registry.insert<NameComponent>(handles.begin(), handles.end(), name_components.begin());
+        m_registry.insert<TransformComponent>(handles.begin(), handles.end());
+        m_registry.insert<RelationshipComponent>(handles.begin(), handles.end());
+        m_registry.insert<WorldTransformComponent>(handles.begin(), handles.end());
 
-            for(const Entity child: get_children(current)) {
-                destroy_subtree_ref(child, destroy_subtree_ref);
+        std::vector<Entity> entities;
+        entities.reserve(count);
+        for(const entt::entity handle: handles) {
+            entities.push_back(Entity(handle, this));
+        }
+        return entities;
+    }
+
+    void Scene::destroy_entity(const Entity entity) {
+        destroy_entities(std::span(&entity, 1));
+    }
+
+    void Scene::destroy_entities(const std::span<const Entity> entities) {
+        apply_pending_relationships();
+
+        // Collect each subtree in pre-order, then destroy back to front so
+        // every child is unlinked before its parent goes away. Entities
+        // listed twice, or inside another listed subtree, are skipped once
+        // they are no longer valid.
+        std::vector<entt::entity> subtrees;
+        for(const Entity entity: entities) {
+            if(!is_valid(entity)) {
+                continue;
             }
-            m_registry.destroy(current.m_handle);
-        };
-        destroy_subtree(entity, destroy_subtree);
+
+            std::size_t index = subtrees.size();
+            subtrees.push_back(entity.m_handle);
+            for(; index < subtrees.size(); ++index) {
+                const auto* relationship =
+                    m_registry.try_get<RelationshipComponent>(subtrees[index]);
+                if(!relationship) {
+                    continue;
+                }
+                for(entt::entity child = relationship->first_child; child != entt::null;
+                    child = m_registry.get<RelationshipComponent>(child).next_sibling) {
+                    subtrees.push_back(child);
+                }
+            }
+        }
+
+        for(auto it = subtrees.rbegin(); it != subtrees.rend(); ++it) {
+            if(m_registry.valid(*it)) {
+                m_registry.destroy(*it);
+            }
+        }
     }
 
     bool Scene::set_parent(const Entity child, const Entity parent) {
-        if(!is_valid(child) || !is_valid(parent)
-           || child == parent || has_cycle(child, parent)) {
+        if(!is_valid(child) || !is_valid(parent) || child == parent) {
             return false;
         }
 
+        apply_pending_relationships();
+        if(has_cycle(child, parent)) {
+            return false;
+        }
+
+        m_registry.get_or_emplace<RelationshipComponent>(parent.m_handle);
         auto& relationship =
             m_registry.get_or_emplace<RelationshipComponent>(child.m_handle);
-        if(relationship.parent == parent.get_id()) {
+        relationship.parent = parent.get_id();
+        if(relationship.parent_handle == parent.m_handle) {
             return true;
         }
 
-        relationship.parent = parent.get_id();
+        unlink_child(child.m_handle);
+        link_child(child.m_handle, parent.m_handle);
+        mark_transform_dirty(child.m_handle);
         return true;
     }
 
@@ -76,13 +207,17 @@ namespace Comet {
             return false;
         }
 
+        apply_pending_relationships();
         auto& relationship =
             m_registry.get_or_emplace<RelationshipComponent>(child.m_handle);
-        if(relationship.parent == INVALID_ENTITY_ID) {
+        relationship.parent = INVALID_ENTITY_ID;
+        if(relationship.parent_handle == entt::null) {
             return true;
         }
 
-        relationship.parent = INVALID_ENTITY_ID;
+        unlink_child(child.m_handle);
+        link_child(child.m_handle, entt::null);
+        mark_transform_dirty(child.m_handle);
         return true;
     }
 
@@ -91,123 +226,307 @@ namespace Comet {
             return {};
         }
 
-        return find_entity(entity.get_component<RelationshipComponent>().parent);
+        apply_pending_relationships();
+        const entt::entity parent =
+            m_registry.get<RelationshipComponent>(entity.m_handle).parent_handle;
+        return parent != entt::null ? Entity(parent, this) : Entity();
     }
 
     std::vector<Entity> Scene::get_children(const Entity entity) {
         std::vector<Entity> children;
-        if(!is_valid(entity)) {
+        if(!is_valid(entity) || !entity.has_component<RelationshipComponent>()) {
             return children;
         }
 
-        const EntityId parent_id = entity.get_id();
-        const auto view = m_registry.view<IdComponent, RelationshipComponent>();
-        for(const entt::entity handle: view) {
-            if(view.get<RelationshipComponent>(handle).parent == parent_id) {
-                children.push_back(Entity(handle, this));
-            }
+        apply_pending_relationships();
+        const auto& relationship = m_registry.get<RelationshipComponent>(entity.m_handle);
+        children.reserve(relationship.child_count);
+        for(entt::entity child = relationship.first_child; child != entt::null;
+            child = m_registry.get<RelationshipComponent>(child).next_sibling) {
+            children.push_back(Entity(child, this));
         }
-        std::ranges::sort(children, {}, &Entity::get_id);
         return children;
     }
 
     std::vector<Entity> Scene::get_root_entities() {
+        apply_pending_relationships();
+
         std::vector<Entity> roots;
-        for(const Entity entity: get_entities()) {
-            if(!get_parent(entity)) {
-                roots.push_back(entity);
-            }
+        roots.reserve(m_root_count);
+        for(entt::entity root = m_first_root; root != entt::null;
+            root = m_registry.get<RelationshipComponent>(root).next_sibling) {
+            roots.push_back(Entity(root, this));
         }
-        std::ranges::sort(roots, {}, &Entity::get_id);
         return roots;
     }
 
     bool Scene::has_cycle(const Entity child, const Entity parent) {
-        std::unordered_set<EntityId> visited;
-        Entity ancestor = parent;
-        while(ancestor) {
-            if(ancestor == child || !visited.insert(ancestor.get_id()).second) {
+        return is_ancestor(child.m_handle, parent.m_handle);
+    }
+
+    void Scene::on_id_constructed(entt::registry& registry, const entt::entity handle) {
+        m_entities_by_id.insert_or_assign(registry.get<IdComponent>(handle).id, handle);
+        m_transform_layout_dirty = true;
+    }
+
+    void Scene::on_id_destroyed(entt::registry& registry, const entt::entity handle) {
+        const auto entry = m_entities_by_id.find(registry.get<IdComponent>(handle).id);
+        if(entry != m_entities_by_id.end() && entry->second == handle) {
+            m_entities_by_id.erase(entry);
+        }
+        m_transform_layout_dirty = true;
+    }
+
+    void Scene::on_uuid_constructed(entt::registry& registry, const entt::entity handle) {
+        m_entities_by_uuid.insert_or_assign(registry.get<UuidComponent>(handle).uuid, handle);
+    }
+
+    void Scene::on_uuid_destroyed(entt::registry& registry, const entt::entity handle) {
+        const auto entry = m_entities_by_uuid.find(registry.get<UuidComponent>(handle).uuid);
+        if(entry != m_entities_by_uuid.end() && entry->second == handle) {
+            m_entities_by_uuid.erase(entry);
+        }
+    }
+
+    void Scene::on_transform_changed(entt::registry&, const entt::entity handle) {
+        mark_transform_dirty(handle);
+    }
+
+    void Scene::on_relationship_constructed(
+        entt::registry& registry, const entt::entity handle) {
+        link_child(handle, entt::null);
+        mark_transform_dirty(handle);
+        if(registry.get<RelationshipComponent>(handle).parent != INVALID_ENTITY_ID) {
+            m_pending_relationships.push_back(handle);
+        }
+    }
+
+    void Scene::on_relationship_updated(entt::registry&, const entt::entity handle) {
+        m_pending_relationships.push_back(handle);
+    }
+
+    void Scene::on_relationship_destroyed(
+        entt::registry& registry, const entt::entity handle) {
+        unlink_child(handle);
+
+        // Children outliving their parent's relationship become roots.
+        auto& relationship = registry.get<RelationshipComponent>(handle);
+        while(relationship.first_child != entt::null) {
+            const entt::entity child = relationship.first_child;
+            unlink_child(child);
+            link_child(child, entt::null);
+            registry.get<RelationshipComponent>(child).parent = INVALID_ENTITY_ID;
+            mark_transform_dirty(child);
+        }
+    }
+
+    void Scene::link_child(const entt::entity handle, const entt::entity parent) {
+        entt::entity* first = &m_first_root;
+        entt::entity* last = &m_last_root;
+        std::size_t* count = &m_root_count;
+        if(parent != entt::null) {
+            auto& parent_relationship = m_registry.get<RelationshipComponent>(parent);
+            first = &parent_relationship.first_child;
+            last = &parent_relationship.last_child;
+            count = &parent_relationship.child_count;
+        }
+
+        auto& relationship = m_registry.get<RelationshipComponent>(handle);
+        relationship.parent_handle = parent;
+        relationship.previous_sibling = *last;
+        relationship.next_sibling = entt::null;
+        if(*last != entt::null) {
+            m_registry.get<RelationshipComponent>(*last).next_sibling = handle;
+        } else {
+            *first = handle;
+        }
+        *last = handle;
+        ++*count;
+        m_transform_layout_dirty = true;
+    }
+
+    void Scene::unlink_child(const entt::entity handle) {
+        auto& relationship = m_registry.get<RelationshipComponent>(handle);
+        entt::entity* first = &m_first_root;
+        entt::entity* last = &m_last_root;
+        std::size_t* count = &m_root_count;
+        if(relationship.parent_handle != entt::null) {
+            auto& parent_relationship =
+                m_registry.get<RelationshipComponent>(relationship.parent_handle);
+            first = &parent_relationship.first_child;
+            last = &parent_relationship.last_child;
+            count = &parent_relationship.child_count;
+        }
+
+        if(relationship.previous_sibling != entt::null) {
+            m_registry.get<RelationshipComponent>(relationship.previous_sibling).next_sibling =
+                relationship.next_sibling;
+        } else {
+            *first = relationship.next_sibling;
+        }
+        if(relationship.next_sibling != entt::null) {
+            m_registry.get<RelationshipComponent>(relationship.next_sibling).previous_sibling =
+                relationship.previous_sibling;
+        } else {
+            *last = relationship.previous_sibling;
+        }
+        --*count;
+
+        relationship.parent_handle = entt::null;
+        relationship.previous_sibling = entt::null;
+        relationship.next_sibling = entt::null;
+        m_transform_layout_dirty = true;
+    }
+
+    bool Scene::is_ancestor(const entt::entity ancestor, const entt::entity handle) const {
+        for(entt::entity current = handle; current != entt::null;) {
+            if(current == ancestor) {
                 return true;
             }
-            ancestor = get_parent(ancestor);
+            const auto* relationship = m_registry.try_get<RelationshipComponent>(current);
+            current = relationship ? relationship->parent_handle : entt::null;
         }
         return false;
     }
 
-    void Scene::update_world_transforms() {
-        std::unordered_map<EntityId, entt::entity> handles;
-        const auto id_view = m_registry.view<IdComponent>();
-        handles.reserve(entity_count());
-        for(const entt::entity handle: id_view) {
-            handles.emplace(id_view.get<IdComponent>(handle).id, handle);
-        }
-
-        std::unordered_map<EntityId, std::vector<entt::entity>> children;
-        std::vector<entt::entity> roots;
-        roots.reserve(handles.size());
-        for(const auto& [id, handle]: handles) {
-            const auto* relationship = m_registry.try_get<RelationshipComponent>(handle);
-            const EntityId parent_id = relationship
-                ? relationship->parent
-                : INVALID_ENTITY_ID;
-            if(parent_id != INVALID_ENTITY_ID && parent_id != id
-               && handles.contains(parent_id)) {
-                children[parent_id].push_back(handle);
-            } else {
-                roots.push_back(handle);
+    void Scene::apply_pending_relationships() {
+        for(const entt::entity handle: m_pending_relationships) {
+            if(!m_registry.valid(handle) || !m_registry.all_of<RelationshipComponent>(handle)) {
+                continue;
             }
-        }
 
-        std::unordered_set<EntityId> visited;
-        visited.reserve(handles.size());
+            auto& relationship = m_registry.get<RelationshipComponent>(handle);
+            entt::entity parent = entt::null;
+            if(const auto entry = m_entities_by_id.find(relationship.parent);
+               entry != m_entities_by_id.end() && entry->second != handle
+               && m_registry.all_of<RelationshipComponent>(entry->second)) {
+                parent = entry->second;
+            }
+            if(parent == relationship.parent_handle) {
+                continue;
+            }
 
-        const auto update_subtree = [this, &children, &visited](
-            const entt::entity handle,
-            const Math::Mat4& parent_world,
-            const auto& update_subtree_ref) -> void {
-            const EntityId id = m_registry.get<IdComponent>(handle).id;
-            if(!visited.insert(id).second) {
-                return;
+            if(parent != entt::null && is_ancestor(handle, parent)) {
+                LOG_WARN("Ignoring parent edit that would create a hierarchy cycle");
+                const auto* current_id = relationship.parent_handle != entt::null
+                    ? m_registry.try_get<IdComponent>(relationship.parent_handle)
+                    : nullptr;
+                relationship.parent = current_id ? current_id->id : INVALID_ENTITY_ID;
+                continue;
             }
 
-            const auto* transform = m_registry.try_get<TransformComponent>(handle);
-            auto& world_transform =
-                m_registry.get_or_emplace<WorldTransformComponent>(handle);
-
-            const Math::Mat4 local_matrix = transform
-                ? transform->to_matrix()
-                : Math::Mat4(1.0f);
-            const Math::Mat4 camera_local_matrix = transform
-                ? Math::compose_trs(
-                    transform->translation,
-                    transform->rotation,
-                    Math::Vec3(1.0f))
-                : Math::Mat4(1.0f);
-            world_transform.world_matrix = parent_world * local_matrix;
-            world_transform.camera_world_matrix =
-                parent_world * camera_local_matrix;
-
-            if(const auto child_handles = children.find(id);
-               child_handles != children.end()) {
-                for(const entt::entity child_handle: child_handles->second) {
-                    update_subtree_ref(
-                        child_handle,
-                        world_transform.world_matrix,
-                        update_subtree_ref);
+            unlink_child(handle);
+            link_child(handle, parent);
+            mark_transform_dirty(handle);
+        }
+        m_pending_relationships.clear();
+    }
+
+    void Scene::mark_transform_dirty(const entt::entity handle) {
+        const auto index = static_cast<std::size_t>(entt::to_entity(handle));
+        if(index >= m_transform_dirty_flags.size()) {
+            m_transform_dirty_flags.resize(index + 1, 0);
+        }
+        if(m_transform_dirty_flags[index] == 0) {
+            m_transform_dirty_flags[index] = 1;
+            m_dirty_transforms.push_back(handle);
+        }
+    }
+
+    bool Scene::is_transform_dirty(const entt::entity handle) const {
+        const auto index = static_cast<std::size_t>(entt::to_entity(handle));
+        return index < m_transform_dirty_flags.size()
+               && m_transform_dirty_flags[index] != 0;
+    }
+
+    void Scene::rebuild_transform_hierarchy() {
+        m_transform_hierarchy.clear();
+        m_transform_hierarchy.reserve(m_registry.view<IdComponent>().size());
+
+        // Walking the forest breadth-first keeps each depth level contiguous.
+        std::vector<std::pair<entt::entity, std::uint32_t>> level;
+        std::vector<std::pair<entt::entity, std::uint32_t>> next_level;
+        for(entt::entity root = m_first_root; root != entt::null;
+            root = m_registry.get<RelationshipComponent>(root).next_sibling) {
+            level.emplace_back(root, TransformHierarchy::INVALID_INDEX);
+        }
+        for(const entt::entity handle:
+            m_registry.view<IdComponent>(entt::exclude<RelationshipComponent>)) {
+            level.emplace_back(handle, TransformHierarchy::INVALID_INDEX);
+        }
+
+        while(!level.empty()) {
+            next_level.clear();
+            for(const auto& [handle, parent]: level) {
+                const std::uint32_t index = m_transform_hierarchy.push(
+                    handle, parent, m_registry.try_get<TransformComponent>(handle));
+
+                const auto* relationship = m_registry.try_get<RelationshipComponent>(handle);
+                if(!relationship) {
+                    continue;
+                }
+                for(entt::entity child = relationship->first_child; child != entt::null;
+                    child = m_registry.get<RelationshipComponent>(child).next_sibling) {
+                    next_level.emplace_back(child, index);
                 }
             }
-        };
+            level.swap(next_level);
+        }
+        m_transform_layout_dirty = false;
+    }
 
-        for(const entt::entity root: roots) {
-            update_subtree(root, Math::Mat4(1.0f), update_subtree);
+    void Scene::update_world_transforms() {
+        apply_pending_relationships();
+        if(m_transform_layout_dirty) {
+            rebuild_transform_hierarchy();
+        } else if(m_dirty_transforms.empty()) {
+            return;
         }
-        for(const auto& [id, handle]: handles) {
-            if(!visited.contains(id)) {
-                update_subtree(handle, Math::Mat4(1.0f), update_subtree);
+
+        for(const entt::entity handle: m_dirty_transforms) {
+            m_transform_dirty_flags[static_cast<std::size_t>(entt::to_entity(handle))] = 0;
+            const std::uint32_t index = m_transform_hierarchy.index_of(handle);
+            if(index != TransformHierarchy::INVALID_INDEX && m_registry.valid(handle)) {
+                m_transform_hierarchy.set_local(
+                    index, m_registry.try_get<TransformComponent>(handle));
+            }
+        }
+        m_dirty_transforms.clear();
+
+        m_transform_hierarchy.update(m_transform_workers.get());
+        // Written through patch so observers such as SceneExtractor see
+        // on_update for every recomposed entity.
+        for(const std::uint32_t index: m_transform_hierarchy.updated_indices()) {
+            const entt::entity handle = m_transform_hierarchy.entity(index);
+            const auto write = [&](WorldTransformComponent& world_transform) {
+                world_transform.world_matrix = m_transform_hierarchy.world_matrix(index);
+                world_transform.camera_world_matrix =
+                    m_transform_hierarchy.camera_world_matrix(index);
+            };
+            if(m_registry.all_of<WorldTransformComponent>(handle)) {
+                m_registry.patch<WorldTransformComponent>(handle, write);
+            } else {
+                write(m_registry.emplace<WorldTransformComponent>(handle));
             }
         }
     }
 
+    void Scene::set_transform_thread_count(const std::uint32_t count) {
+        if(count == 1) {
+            m_transform_workers.reset();
+            return;
+        }
+
+        m_transform_workers = std::make_unique<ThreadPool>(count);
+        if(m_transform_workers->thread_count() == 1) {
+            m_transform_workers.reset();
+        }
+    }
+
+    std::uint32_t Scene::get_transform_thread_count() const {
+        return m_transform_workers ? m_transform_workers->thread_count() : 1;
+    }
+
     const Math::Mat4& Scene::get_world_matrix(const Entity entity) {
         if(!is_valid(entity)) {
             LOG_FATAL("Cannot get world matrix for an invalid entity");
@@ -222,14 +541,12 @@ namespace Comet {
             return {};
         }
 
-        const auto view = m_registry.view<IdComponent>();
-        for(const entt::entity handle: view) {
-            if(view.get<IdComponent>(handle).id == id) {
-                return {handle, this};
-            }
+        const auto entry = m_entities_by_id.find(id);
+        if(entry == m_entities_by_id.end()) {
+            return {};
         }
 
-        return {};
+        return {entry->second, this};
     }
 
     Entity Scene::find_entity(const EntityUuid uuid) {
@@ -237,14 +554,12 @@ namespace Comet {
             return {};
         }
 
-        const auto view = m_registry.view<UuidComponent>();
-        for(const entt::entity handle: view) {
-            if(view.get<UuidComponent>(handle).uuid == uuid) {
-                return {handle, this};
-            }
+        const auto entry = m_entities_by_uuid.find(uuid);
+        if(entry == m_entities_by_uuid.end()) {
+            return {};
         }
 
-        return {};
+        return {entry->second, this};
     }
 
     std::vector<Entity> Scene::get_entities() {
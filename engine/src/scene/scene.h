@@ -1,22 +1,28 @@
 #pragma once
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "common/export.h"
 #include "scene/entity.h"
+#include "scene/transform_hierarchy.h"
 #include <entt.hpp>
 
 namespace Comet {
     class SceneExtractor;
     class SceneSerializer;
+    class ThreadPool;
 
     class COMET_API Scene {
     public:
-        Scene() = default;
+        Scene();
 
-        ~Scene() = default;
+        ~Scene();
 
         Scene(const Scene&) = delete;
 
@@ -31,8 +37,26 @@ namespace Comet {
         [[nodiscard]] Entity create_entity_with_uuid(
             EntityUuid uuid, const std::string& name = "Entity");
 
+        // Batch counterparts of create_entity/create_entity_with_uuid. Entity
+        // i is named names[i], falling back to "Entity" for missing or empty
+        // names, and the entities receive contiguous EntityIds.
+        std::vector<Entity> create_entities(
+            std::size_t count, std::span<const std::string> names = {});
+
+        // Unlike create_entities, empty names are kept so that loaded scenes
+        // round-trip. Creates nothing and returns an empty list if any UUID
+        // is invalid, repeated, or already used in the scene; its index is
+        // then written to failed_index when given.
+        [[nodiscard]] std::vector<Entity> create_entities_with_uuids(
+            std::span<const EntityUuid> uuids, std::span<const std::string> names = {},
+            std::size_t* failed_index = nullptr);
+
         void destroy_entity(Entity entity);
 
+        // Destroys each entity together with its subtree. Invalid entities
+        // and entities already covered by another subtree are ignored.
+        void destroy_entities(std::span<const Entity> entities);
+
         [[nodiscard]] bool set_parent(Entity child, Entity parent);
 
         [[nodiscard]] bool clear_parent(Entity child);
@@ -45,6 +69,12 @@ namespace Comet {
 
         void update_world_transforms();
 
+        // Number of threads recomposing world transforms; 0 uses every
+        // hardware thread and 1 keeps the update on the calling thread.
+        void set_transform_thread_count(std::uint32_t count);
+
+        [[nodiscard]] std::uint32_t get_transform_thread_count() const;
+
         [[nodiscard]] const Math::Mat4& get_world_matrix(Entity entity);
 
         [[nodiscard]] Entity find_entity(EntityId id);
@@ -62,10 +92,86 @@ namespace Comet {
         friend class SceneExtractor;
         friend class SceneSerializer;
 
+        // Owning groups for the shapes walked every frame. Owned components
+        // are packed at the front of their storages in matching order.
+        using RenderableGroup = decltype(std::declval<entt::registry&>()
+            .group<WorldTransformComponent, MeshRendererComponent>(
+                entt::get<IdComponent, TransformComponent>));
+        using CameraGroup = decltype(std::declval<entt::registry&>()
+            .group<CameraComponent>(
+                entt::get<IdComponent, TransformComponent, WorldTransformComponent>));
+
         [[nodiscard]] bool has_cycle(Entity child, Entity parent);
 
+        // Creates one entity per UUID without validating them. Missing names
+        // become "Entity", and so do empty ones if replace_empty_names is set.
+        std::vector<Entity> emplace_entities(std::span<const EntityUuid> uuids,
+                                             std::span<const std::string> names,
+                                             bool replace_empty_names);
+
+        void on_id_constructed(entt::registry& registry, entt::entity handle);
+
+        void on_id_destroyed(entt::registry& registry, entt::entity handle);
+
+        void on_uuid_constructed(entt::registry& registry, entt::entity handle);
+
+        void on_uuid_destroyed(entt::registry& registry, entt::entity handle);
+
+        void on_transform_changed(entt::registry& registry, entt::entity handle);
+
+        void on_relationship_constructed(entt::registry& registry, entt::entity handle);
+
+        void on_relationship_updated(entt::registry& registry, entt::entity handle);
+
+        void on_relationship_destroyed(entt::registry& registry, entt::entity handle);
+
+        void link_child(entt::entity handle, entt::entity parent);
+
+        void unlink_child(entt::entity handle);
+
+        [[nodiscard]] bool is_ancestor(entt::entity ancestor, entt::entity handle) const;
+
+        void apply_pending_relationships();
+
+        void mark_transform_dirty(entt::entity handle);
+
+        [[nodiscard]] bool is_transform_dirty(entt::entity handle) const;
+
+        void rebuild_transform_hierarchy();
+
         EntityId m_next_entity_id = 1;
         entt::registry m_registry;
+
+        // Declared up front so storages are arranged from the first entity.
+        RenderableGroup m_renderables = m_registry.group<WorldTransformComponent, MeshRendererComponent>(
+            entt::get<IdComponent, TransformComponent>);
+        CameraGroup m_cameras = m_registry.group<CameraComponent>(
+            entt::get<IdComponent, TransformComponent, WorldTransformComponent>);
+
+        // Lookup indices kept in sync by the IdComponent/UuidComponent signals.
+        std::unordered_map<EntityId, entt::entity> m_entities_by_id;
+        std::unordered_map<EntityUuid, entt::entity> m_entities_by_uuid;
+
+        // Root entities chained through RelationshipComponent sibling links.
+        entt::entity m_first_root = entt::null;
+        entt::entity m_last_root = entt::null;
+        std::size_t m_root_count = 0;
+
+        // Entities whose RelationshipComponent was patched. A caller may
+        // patch before writing through the returned reference, so the links
+        // are reconciled lazily before the hierarchy is next read.
+        std::vector<entt::entity> m_pending_relationships;
+
+        // Depth-ordered copy of the hierarchy used to recompose world
+        // matrices. Rebuilt after any structural change.
+        TransformHierarchy m_transform_hierarchy;
+        bool m_transform_layout_dirty = false;
+        std::unique_ptr<ThreadPool> m_transform_workers;
+
+        // Entities whose local transform changed since the last update. The
+        // flags are indexed by entt::to_entity and deduplicate the list.
+        std::vector<entt::entity> m_dirty_transforms;
+        std::vector<std::uint8_t> m_transform_dirty_flags;
     };
 
     template<typename T, typename... Args>
@@ -78,6 +184,11 @@ namespace Comet {
         return m_scene->m_registry.get<T>(m_handle);
     }
 
+    template<typename T, typename... Func>
+    T& Entity::patch_component(Func&&... func) {
+        return m_scene->m_registry.patch<T>(m_handle, std::forward<Func>(func)...);
+    }
+
     template<typename T>
     const T& Entity::get_component() const {
         return m_scene->m_registry.get<T>(m_handle);
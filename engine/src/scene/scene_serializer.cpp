@@ -654,18 +654,30 @@ namespace Comet {
         }
         validate_records(records, source);
 
+        std::vector<EntityUuid> uuids;
+        std::vector<std::string> names;
+        uuids.reserve(records.size());
+        names.reserve(records.size());
+        for(const EntityRecord& record: records) {
+            uuids.push_back(record.uuid);
+            names.push_back(record.name);
+        }
+
         auto scene = std::make_unique<Scene>();
+        std::size_t failed_index = 0;
+        const std::vector<Entity> created =
+                scene->create_entities_with_uuids(uuids, names, &failed_index);
+        if(created.size() != records.size()) {
+            throw scene_error(
+                source, entity_location(failed_index) + ".uuid",
+                "failed to create entity " + records[failed_index].uuid.to_string());
+        }
+
         std::unordered_map<EntityUuid, Entity> loaded_entities;
         loaded_entities.reserve(records.size());
-        for(const EntityRecord& record: records) {
-            Entity entity = scene->create_entity_with_uuid(
-                record.uuid, record.name);
-            if(!entity) {
-                throw scene_error(
-                    source, record.uuid.to_string(),
-                    "failed to create entity");
-            }
-            entity.get_component<NameComponent>().name = record.name;
+        for(std::size_t index = 0; index < records.size(); ++index) {
+            const EntityRecord& record = records[index];
+            Entity entity = created[index];
             for(const ComponentDescriptor& component_descriptor:
                 m_component_registry.components()) {
                 if(!component_descriptor.serializable) {
@@ -713,6 +725,7 @@ namespace Comet {
                         source,
                         component_location + "." + property.descriptor->id);
                 }
+                component_descriptor.notify_changed(entity);
             }
             loaded_entities.emplace(record.uuid, entity);
         }
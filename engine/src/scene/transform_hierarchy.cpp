@@ -0,0 +1,192 @@
+#include "scene/transform_hierarchy.h"
+
+#include "common/logger.h"
+#include "core/math_simd.h"
+#include "core/thread_pool.h"
+
+#include <algorithm>
+#include <array>
+
+namespace Comet {
+    void TransformHierarchy::clear() {
+        m_entities.clear();
+        m_parents.clear();
+        m_depths.clear();
+        m_translations.clear();
+        m_rotations.clear();
+        m_scales.clear();
+        m_world_matrices.clear();
+        m_camera_world_matrices.clear();
+        m_dirty.clear();
+        m_level_offsets.clear();
+        m_first_dirty = INVALID_INDEX;
+        std::ranges::fill(m_index_by_entity, INVALID_INDEX);
+        m_updated_indices.clear();
+    }
+
+    void TransformHierarchy::reserve(const std::size_t count) {
+        m_entities.reserve(count);
+        m_parents.reserve(count);
+        m_depths.reserve(count);
+        m_translations.reserve(count);
+        m_rotations.reserve(count);
+        m_scales.reserve(count);
+        m_world_matrices.reserve(count);
+        m_camera_world_matrices.reserve(count);
+        m_dirty.reserve(count);
+    }
+
+    std::uint32_t TransformHierarchy::push(
+        const entt::entity handle, const std::uint32_t parent,
+        const TransformComponent* local) {
+        const auto index = static_cast<std::uint32_t>(m_entities.size());
+        const std::uint32_t depth = parent != INVALID_INDEX ? m_depths[parent] + 1 : 0;
+        if(!m_depths.empty() && depth < m_depths.back()) {
+            LOG_FATAL("Transform hierarchy entries must be pushed in depth order");
+        }
+
+        if(m_level_offsets.empty()) {
+            m_level_offsets.push_back(0);
+        }
+        if(depth == level_count()) {
+            m_level_offsets.push_back(index);
+        }
+        m_level_offsets.back() = index + 1;
+
+        m_entities.push_back(handle);
+        m_parents.push_back(parent);
+        m_depths.push_back(depth);
+        m_translations.push_back(local ? local->translation : Math::Vec3(0.0f));
+        m_rotations.push_back(local ? local->rotation : Math::Vec3(0.0f));
+        m_scales.push_back(local ? local->scale : Math::Vec3(1.0f));
+        m_world_matrices.emplace_back(1.0f);
+        m_camera_world_matrices.emplace_back(1.0f);
+        m_dirty.push_back(1);
+        m_first_dirty = std::min(m_first_dirty, index);
+
+        const auto slot = static_cast<std::size_t>(entt::to_entity(handle));
+        if(slot >= m_index_by_entity.size()) {
+            m_index_by_entity.resize(slot + 1, INVALID_INDEX);
+        }
+        m_index_by_entity[slot] = index;
+        return index;
+    }
+
+    void TransformHierarchy::set_local(
+        const std::uint32_t index, const TransformComponent* local) {
+        m_translations[index] = local ? local->translation : Math::Vec3(0.0f);
+        m_rotations[index] = local ? local->rotation : Math::Vec3(0.0f);
+        m_scales[index] = local ? local->scale : Math::Vec3(1.0f);
+        m_dirty[index] = 1;
+        m_first_dirty = std::min(m_first_dirty, index);
+    }
+
+    void TransformHierarchy::mark_all_dirty() {
+        std::ranges::fill(m_dirty, std::uint8_t{1});
+        m_first_dirty = m_entities.empty() ? INVALID_INDEX : 0;
+    }
+
+    void TransformHierarchy::update(ThreadPool* workers) {
+        m_updated_indices.clear();
+        if(m_first_dirty == INVALID_INDEX) {
+            return;
+        }
+
+        // Entries within a level only read their parents, which live in
+        // earlier levels, so each level can be split freely as long as the
+        // levels are processed in order.
+        const bool parallel = workers && workers->thread_count() > 1;
+        for(std::size_t level = 0; level < level_count(); ++level) {
+            const auto [level_begin, level_end] = level_range(level);
+            const std::uint32_t first = std::max(level_begin, m_first_dirty);
+            if(first >= level_end) {
+                continue;
+            }
+
+            if(parallel) {
+                workers->parallel_for(
+                    level_end - first,
+                    PARALLEL_CHUNK_SIZE,
+                    [this, first](const std::size_t begin, const std::size_t end) {
+                        update_range(first + static_cast<std::uint32_t>(begin),
+                                     first + static_cast<std::uint32_t>(end));
+                    });
+            } else {
+                update_range(first, level_end);
+            }
+        }
+
+        const auto count = static_cast<std::uint32_t>(m_entities.size());
+        for(std::uint32_t index = m_first_dirty; index < count; ++index) {
+            if(m_dirty[index] != 0) {
+                m_dirty[index] = 0;
+                m_updated_indices.push_back(index);
+            }
+        }
+        m_first_dirty = INVALID_INDEX;
+    }
+
+    std::uint32_t TransformHierarchy::index_of(const entt::entity handle) const {
+        const auto slot = static_cast<std::size_t>(entt::to_entity(handle));
+        if(slot >= m_index_by_entity.size()) {
+            return INVALID_INDEX;
+        }
+
+        const std::uint32_t index = m_index_by_entity[slot];
+        return index != INVALID_INDEX && m_entities[index] == handle
+            ? index
+            : INVALID_INDEX;
+    }
+
+    void TransformHierarchy::update_range(const std::uint32_t begin, const std::uint32_t end) {
+        // Dirty entries are gathered into small batches for the TRS kernel.
+        // Only the unscaled local matrix is composed; scaling its columns
+        // afterwards yields the full world matrix.
+        std::array<std::uint32_t, COMPOSE_BATCH_SIZE> indices;
+        std::array<Math::Vec3, COMPOSE_BATCH_SIZE> translations;
+        std::array<Math::Vec3, COMPOSE_BATCH_SIZE> rotations;
+        std::array<Math::Mat4, COMPOSE_BATCH_SIZE> locals;
+        std::size_t batch_size = 0;
+
+        const auto flush = [&]() {
+            Math::compose_trs_batch(
+                translations.data(), rotations.data(), nullptr, locals.data(), batch_size);
+            for(std::size_t entry = 0; entry < batch_size; ++entry) {
+                const std::uint32_t index = indices[entry];
+                const std::uint32_t parent = m_parents[index];
+                Math::Mat4& camera_world = m_camera_world_matrices[index];
+                camera_world = parent != INVALID_INDEX
+                    ? m_world_matrices[parent] * locals[entry]
+                    : locals[entry];
+
+                const Math::Vec3& scale = m_scales[index];
+                Math::Mat4& world = m_world_matrices[index];
+                world[0] = camera_world[0] * scale.x;
+                world[1] = camera_world[1] * scale.y;
+                world[2] = camera_world[2] * scale.z;
+                world[3] = camera_world[3];
+            }
+            batch_size = 0;
+        };
+
+        for(std::uint32_t index = begin; index < end; ++index) {
+            if(m_dirty[index] == 0) {
+                const std::uint32_t parent = m_parents[index];
+                if(parent == INVALID_INDEX || m_dirty[parent] == 0) {
+                    continue;
+                }
+                m_dirty[index] = 1;
+            }
+
+            indices[batch_size] = index;
+            translations[batch_size] = m_translations[index];
+            rotations[batch_size] = m_rotations[index];
+            if(++batch_size == COMPOSE_BATCH_SIZE) {
+                flush();
+            }
+        }
+        if(batch_size > 0) {
+            flush();
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "common/export.h"
+#include "core/math_utils.h"
+#include "scene/components.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <entt.hpp>
+
+namespace Comet {
+    class ThreadPool;
+
+    // Flattened transform hierarchy. Entries are stored breadth-first, so
+    // every parent precedes its children and each depth level occupies a
+    // contiguous range; world matrices are recomposed in one linear pass.
+    class COMET_API TransformHierarchy {
+    public:
+        static constexpr std::uint32_t INVALID_INDEX =
+            std::numeric_limits<std::uint32_t>::max();
+
+        void clear();
+
+        void reserve(std::size_t count);
+
+        // Appends an entity below `parent`, which must already be stored.
+        // Entries must be pushed in non-decreasing depth order.
+        std::uint32_t push(entt::entity handle, std::uint32_t parent,
+                           const TransformComponent* local);
+
+        // Copies a new local TRS and schedules the entry for recomposition.
+        // A missing transform is treated as identity.
+        void set_local(std::uint32_t index, const TransformComponent* local);
+
+        void mark_all_dirty();
+
+        // Recomposes dirty entries and their descendants. The recomposed
+        // indices are available from updated_indices() until the next call.
+        // With a multi-threaded pool each depth level is split across the
+        // workers; the results are identical to the serial pass.
+        void update(ThreadPool* workers = nullptr);
+
+        [[nodiscard]] std::uint32_t index_of(entt::entity handle) const;
+
+        [[nodiscard]] std::size_t size() const { return m_entities.size(); }
+
+        [[nodiscard]] entt::entity entity(const std::uint32_t index) const {
+            return m_entities[index];
+        }
+
+        [[nodiscard]] std::uint32_t parent(const std::uint32_t index) const {
+            return m_parents[index];
+        }
+
+        [[nodiscard]] const Math::Mat4& world_matrix(const std::uint32_t index) const {
+            return m_world_matrices[index];
+        }
+
+        [[nodiscard]] const Math::Mat4& camera_world_matrix(const std::uint32_t index) const {
+            return m_camera_world_matrices[index];
+        }
+
+        [[nodiscard]] std::size_t level_count() const {
+            return m_level_offsets.empty() ? 0 : m_level_offsets.size() - 1;
+        }
+
+        // Index range [first, second) holding the entries at `level`.
+        [[nodiscard]] std::pair<std::uint32_t, std::uint32_t> level_range(
+            std::size_t level) const {
+            return {m_level_offsets[level], m_level_offsets[level + 1]};
+        }
+
+        [[nodiscard]] const std::vector<std::uint32_t>& updated_indices() const {
+            return m_updated_indices;
+        }
+
+    private:
+        // Entries handed to a worker at a time; smaller levels stay serial.
+        static constexpr std::size_t PARALLEL_CHUNK_SIZE = 2048;
+        // Dirty entries composed per call to the batched TRS kernel.
+        static constexpr std::size_t COMPOSE_BATCH_SIZE = 64;
+
+        // Recomposes the dirty entries in [begin, end), which must lie in a
+        // single depth level, propagating dirtiness from their parents.
+        void update_range(std::uint32_t begin, std::uint32_t end);
+
+        std::vector<entt::entity> m_entities;
+        std::vector<std::uint32_t> m_parents;
+        std::vector<std::uint32_t> m_depths;
+        std::vector<Math::Vec3> m_translations;
+        std::vector<Math::Vec3> m_rotations;
+        std::vector<Math::Vec3> m_scales;
+        std::vector<Math::Mat4> m_world_matrices;
+        std::vector<Math::Mat4> m_camera_world_matrices;
+        std::vector<std::uint8_t> m_dirty;
+        std::vector<std::uint32_t> m_level_offsets;
+        std::uint32_t m_first_dirty = INVALID_INDEX;
+
+        // Entry index per entt::to_entity slot.
+        std::vector<std::uint32_t> m_index_by_entity;
+        std::vector<std::uint32_t> m_updated_indices;
+    };
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "core/bounds.h"
+#include "../test_utils.h"
+
+#include <cmath>
+#include <vector>
+
+namespace Comet::Tests {
+
+namespace {
+    // Camera at the origin looking down -Z with a 90 degree square frustum.
+    Math::Frustum MakeTestFrustum() {
+        const Math::Mat4 view = Math::look_at(
+            Math::Vec3(0.0f), Math::Vec3(0.0f, 0.0f, -1.0f), Math::Vec3(0.0f, 1.0f, 0.0f));
+        const Math::Mat4 projection = Math::perspective(90.0f, 1.0f, 0.1f, 100.0f);
+        return Math::make_frustum(projection * view);
+    }
+
+    Math::BoundingVolume MakeUnitCubeBounds() {
+        std::vector<Math::Vertex> corners;
+        for(int index = 0; index < 8; ++index) {
+            corners.push_back({
+                Math::Vec3(index & 1 ? 0.5f : -0.5f, index & 2 ? 0.5f : -0.5f, index & 4 ? 0.5f : -0.5f),
+                Math::Vec2(0.0f),
+                Math::Vec3(0.0f)
+            });
+        }
+        return Math::compute_bounds(corners);
+    }
+
+    Math::Mat4 Translation(const Math::Vec3& translation) {
+        return Math::translate(Math::Mat4(1.0f), translation);
+    }
+}
+
+TEST(BoundsTest, ComputesBoxAndEnclosingSphere) {
+    const std::vector<Math::Vertex> vertices = {
+        {Math::Vec3(-1.0f, 0.0f, 2.0f), Math::Vec2(0.0f), Math::Vec3(0.0f)},
+        {Math::Vec3(3.0f, -2.0f, 4.0f), Math::Vec2(0.0f), Math::Vec3(0.0f)},
+        {Math::Vec3(1.0f, 2.0f, 3.0f), Math::Vec2(0.0f), Math::Vec3(0.0f)}
+    };
+
+    const Math::BoundingVolume bounds = Math::compute_bounds(vertices);
+
+    EXPECT_EQ(bounds.aabb.min, Math::Vec3(-1.0f, -2.0f, 2.0f));
+    EXPECT_EQ(bounds.aabb.max, Math::Vec3(3.0f, 2.0f, 4.0f));
+    EXPECT_EQ(bounds.sphere.center, Math::Vec3(1.0f, 0.0f, 3.0f));
+    for(const Math::Vertex& vertex: vertices) {
+        EXPECT_LE(Math::length(vertex.position - bounds.sphere.center),
+                  bounds.sphere.radius + 1e-5f);
+    }
+    EXPECT_NEAR(bounds.sphere.radius, std::sqrt(9.0f), 1e-5f);
+}
+
+TEST(BoundsTest, EmptyVertexListHasEmptyBounds) {
+    const Math::BoundingVolume bounds = Math::compute_bounds({});
+
+    EXPECT_EQ(bounds.aabb.min, Math::Vec3(0.0f));
+    EXPECT_EQ(bounds.aabb.max, Math::Vec3(0.0f));
+    EXPECT_EQ(bounds.sphere.radius, 0.0f);
+}
+
+TEST(BoundsTest, FrustumKeepsVisibleAndStraddlingBounds) {
+    const Math::Frustum frustum = MakeTestFrustum();
+    const Math::BoundingVolume bounds = MakeUnitCubeBounds();
+
+    EXPECT_TRUE(Math::intersects(frustum, bounds, Translation(Math::Vec3(0.0f, 0.0f, -5.0f))));
+    // Centre outside the left plane, but the cube still reaches into view.
+    EXPECT_TRUE(Math::intersects(frustum, bounds, Translation(Math::Vec3(-5.3f, 0.0f, -5.0f))));
+    // Straddling the near plane.
+    EXPECT_TRUE(Math::intersects(frustum, bounds, Translation(Math::Vec3(0.0f, 0.0f, 0.0f))));
+}
+
+TEST(BoundsTest, FrustumRejectsBoundsOutsideAnyPlane) {
+    const Math::Frustum frustum = MakeTestFrustum();
+    const Math::BoundingVolume bounds = MakeUnitCubeBounds();
+
+    EXPECT_FALSE(Math::intersects(frustum, bounds, Translation(Math::Vec3(0.0f, 0.0f, 5.0f))));
+    EXPECT_FALSE(Math::intersects(frustum, bounds, Translation(Math::Vec3(-20.0f, 0.0f, -5.0f))));
+    EXPECT_FALSE(Math::intersects(frustum, bounds, Translation(Math::Vec3(0.0f, 20.0f, -5.0f))));
+    EXPECT_FALSE(Math::intersects(frustum, bounds, Translation(Math::Vec3(0.0f, 0.0f, -200.0f))));
+}
+
+TEST(BoundsTest, FrustumTestAccountsForModelScale) {
+    const Math::Frustum frustum = MakeTestFrustum();
+    const Math::BoundingVolume bounds = MakeUnitCubeBounds();
+    const Math::Mat4 offset = Translation(Math::Vec3(-12.0f, 0.0f, -5.0f));
+
+    EXPECT_FALSE(Math::intersects(frustum, bounds, offset));
+    EXPECT_TRUE(Math::intersects(
+        frustum, bounds, Math::scale(offset, Math::Vec3(20.0f, 1.0f, 1.0f))));
+}
+
+TEST(BoundsTest, BoxRejectsWhatTheSphereCannot) {
+    const Math::Frustum frustum = MakeTestFrustum();
+    // A long thin rod beside the view: its sphere crosses the left plane
+    // but the rod itself stays outside.
+    const std::vector<Math::Vertex> vertices = {
+        {Math::Vec3(0.0f, 0.0f, -10.0f), Math::Vec2(0.0f), Math::Vec3(0.0f)},
+        {Math::Vec3(0.0f, 0.0f, 10.0f), Math::Vec2(0.0f), Math::Vec3(0.0f)}
+    };
+    const Math::BoundingVolume rod = Math::compute_bounds(vertices);
+
+    EXPECT_FALSE(Math::intersects(frustum, rod, Translation(Math::Vec3(-12.0f, 0.0f, 0.0f))));
+}
+
+} // namespace Comet::Tests
@@ -61,11 +61,13 @@ vulkan:
   present_mode: mailbox
   swapchain_image_count: 4
   msaa_samples: 8
+  pipeline_cache_dir: "build/pipeline_cache"
 render:
   max_frames_in_flight: 3
   clear_color: [0.9, 0.7, 0.5, 0.3]
   enable_vsync: true
   max_anisotropy: 16
+  frame_uniform_buffer_kb: 64
 window:
   width: 901
   height: 517
@@ -76,6 +78,10 @@ debug:
   log_level: warn
   enable_file_logging: true
   enable_validation: false
+threading:
+  transform_threads: 6
+  texture_decode_threads: 3
+  pipeline_compile_threads: 2
 )");
 
     const Config config = ConfigLoader{}.load(file.path());
@@ -95,12 +101,18 @@ debug:
     EXPECT_EQ(config.vulkan.present_mode, PresentMode::Mailbox);
     EXPECT_EQ(config.vulkan.swapchain_image_count, 4u);
     EXPECT_EQ(config.vulkan.msaa_samples, SampleCount::Count8);
+    EXPECT_EQ(config.vulkan.pipeline_cache_dir, "build/pipeline_cache");
     EXPECT_FALSE(config.vulkan.enable_validation);
 
     EXPECT_EQ(config.render.max_frames_in_flight, 3u);
     EXPECT_TRUE(config.render.enable_vsync);
     EXPECT_FLOAT_EQ(config.render.max_anisotropy, 16.0f);
+    EXPECT_EQ(config.render.frame_uniform_buffer_kb, 64u);
     EXPECT_EQ(config.render.clear_color, (std::array<float, 4>{0.9f, 0.7f, 0.5f, 0.3f}));
+
+    EXPECT_EQ(config.threading.transform_threads, 6u);
+    EXPECT_EQ(config.threading.texture_decode_threads, 3u);
+    EXPECT_EQ(config.threading.pipeline_compile_threads, 2u);
 }
 
 TEST(ConfigTest, UsesDefaultsForMissingFields) {
@@ -113,6 +125,9 @@ TEST(ConfigTest, UsesDefaultsForMissingFields) {
     EXPECT_EQ(config.log.level, Config::Log{}.level);
     EXPECT_EQ(config.render.clear_color, Config::Render{}.clear_color);
     EXPECT_FLOAT_EQ(config.render.max_anisotropy, Config::Render{}.max_anisotropy);
+    EXPECT_EQ(config.threading.transform_threads, Config::Threading{}.transform_threads);
+    EXPECT_EQ(config.threading.texture_decode_threads, Config::Threading{}.texture_decode_threads);
+    EXPECT_EQ(config.threading.pipeline_compile_threads, Config::Threading{}.pipeline_compile_threads);
 }
 
 TEST(ConfigTest, ExplicitValidationSettingOverridesBuildDefault) {
@@ -158,6 +173,12 @@ TEST(ConfigTest, RejectsInvalidAnisotropy) {
     EXPECT_THROW(static_cast<void>(ConfigLoader{}.load(file.path())), std::runtime_error);
 }
 
+TEST(ConfigTest, RejectsEmptyFrameUniformBuffer) {
+    const TemporaryConfigFile file("render:\n  frame_uniform_buffer_kb: 0\n");
+
+    EXPECT_THROW(static_cast<void>(ConfigLoader{}.load(file.path())), std::runtime_error);
+}
+
 TEST(ConfigTest, RejectsUnknownVulkanEnumName) {
     const TemporaryConfigFile file("vulkan:\n  present_mode: fastest\n");
 
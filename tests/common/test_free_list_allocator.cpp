@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include "core/free_list_allocator.h"
+
+namespace Comet::Tests {
+
+TEST(FreeListAllocatorTest, AllocatesFromTheFrontUntilFull) {
+    FreeListAllocator allocator(100);
+
+    EXPECT_EQ(allocator.allocate(40), 0u);
+    EXPECT_EQ(allocator.allocate(60), 40u);
+    EXPECT_FALSE(allocator.allocate(1).has_value());
+    EXPECT_EQ(allocator.get_used(), 100u);
+    EXPECT_EQ(allocator.get_free_range_count(), 0u);
+}
+
+TEST(FreeListAllocatorTest, PicksTheSmallestRangeThatFits) {
+    FreeListAllocator allocator(100);
+    const auto a = allocator.allocate(30);
+    const auto b = allocator.allocate(10);
+    const auto c = allocator.allocate(20);
+    ASSERT_TRUE(a && b && c);
+    allocator.free(*a, 30);
+    allocator.free(*c, 20);
+
+    // Free ranges: [0, 30) and [40, 100); the first is the tighter fit.
+    EXPECT_EQ(allocator.allocate(25), 0u);
+    EXPECT_EQ(allocator.allocate(50), 40u);
+}
+
+TEST(FreeListAllocatorTest, CoalescesNeighbouringRanges) {
+    FreeListAllocator allocator(90);
+    const auto a = allocator.allocate(30);
+    const auto b = allocator.allocate(30);
+    const auto c = allocator.allocate(30);
+    ASSERT_TRUE(a && b && c);
+
+    allocator.free(*a, 30);
+    allocator.free(*c, 30);
+    EXPECT_EQ(allocator.get_free_range_count(), 2u);
+    EXPECT_EQ(allocator.get_largest_free_range(), 30u);
+
+    allocator.free(*b, 30);
+    EXPECT_EQ(allocator.get_free_range_count(), 1u);
+    EXPECT_EQ(allocator.get_largest_free_range(), 90u);
+    EXPECT_EQ(allocator.get_used(), 0u);
+}
+
+TEST(FreeListAllocatorTest, IgnoresDoubleFree) {
+    FreeListAllocator allocator(64);
+    const auto a = allocator.allocate(16);
+    ASSERT_TRUE(a.has_value());
+
+    allocator.free(*a, 16);
+    allocator.free(*a, 16);
+    EXPECT_EQ(allocator.get_used(), 0u);
+    EXPECT_EQ(allocator.get_free_range_count(), 1u);
+}
+
+TEST(FreeListAllocatorTest, ResetPackedKeepsThePrefixAllocated) {
+    FreeListAllocator allocator(64);
+    allocator.reset_packed(128, 48);
+
+    EXPECT_EQ(allocator.get_capacity(), 128u);
+    EXPECT_EQ(allocator.get_used(), 48u);
+    EXPECT_EQ(allocator.allocate(80), 48u);
+    EXPECT_FALSE(allocator.allocate(1).has_value());
+}
+
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include "core/geometry_range_allocator.h"
+
+#include <vector>
+
+namespace Comet::Tests {
+
+TEST(GeometryRangeAllocatorTest, AllocatesVertexAndIndexRangesTogether) {
+    GeometryRangeAllocator allocator(100, 300);
+
+    const auto first = allocator.allocate(10, 30);
+    const auto second = allocator.allocate(20, 0);
+    ASSERT_TRUE(first && second);
+    EXPECT_EQ(allocator.get_range(*first).vertex_offset, 0u);
+    EXPECT_EQ(allocator.get_range(*first).first_index, 0u);
+    EXPECT_EQ(allocator.get_range(*second).vertex_offset, 10u);
+    EXPECT_EQ(allocator.get_range(*second).index_count, 0u);
+
+    const GeometryArenaStats stats = allocator.get_stats();
+    EXPECT_EQ(stats.allocation_count, 2u);
+    EXPECT_EQ(stats.vertex_used, 30u);
+    EXPECT_EQ(stats.index_used, 30u);
+}
+
+TEST(GeometryRangeAllocatorTest, FailedIndexAllocationReleasesTheVertexRange) {
+    GeometryRangeAllocator allocator(100, 10);
+
+    EXPECT_FALSE(allocator.allocate(10, 20).has_value());
+    EXPECT_FALSE(allocator.allocate(0, 5).has_value());
+    EXPECT_EQ(allocator.get_stats().vertex_used, 0u);
+    EXPECT_EQ(allocator.get_stats().allocation_count, 0u);
+}
+
+TEST(GeometryRangeAllocatorTest, FreedSlotsAndRangesAreReused) {
+    GeometryRangeAllocator allocator(100, 100);
+    const auto first = allocator.allocate(10, 10);
+    const auto second = allocator.allocate(10, 10);
+    ASSERT_TRUE(first && second);
+
+    allocator.free(*first);
+    EXPECT_FALSE(allocator.is_live(*first));
+    EXPECT_TRUE(allocator.is_live(*second));
+    // A second free of the same handle is rejected.
+    allocator.free(*first);
+    EXPECT_EQ(allocator.get_stats().allocation_count, 1u);
+
+    const auto third = allocator.allocate(5, 5);
+    ASSERT_TRUE(third);
+    EXPECT_EQ(third->index, first->index);
+    EXPECT_EQ(allocator.get_range(*third).vertex_offset, 0u);
+}
+
+TEST(GeometryRangeAllocatorTest, GrowthLeavesAQuarterFree) {
+    GeometryRangeAllocator allocator(64, 64);
+    ASSERT_TRUE(allocator.allocate(40, 10));
+
+    // 40 + 30 vertices exceed three quarters of 64 and of 128.
+    const GeometryCapacity grown = allocator.grown_capacity(30, 10);
+    EXPECT_EQ(grown.vertex, 128u);
+    EXPECT_EQ(grown.index, 64u);
+
+    const GeometryCapacity large = allocator.grown_capacity(200, 0);
+    EXPECT_EQ(large.vertex, 512u);
+}
+
+TEST(GeometryRangeAllocatorTest, RepackMovesLiveRangesToTheFront) {
+    GeometryRangeAllocator allocator(100, 100);
+    const auto first = allocator.allocate(10, 6);
+    const auto second = allocator.allocate(20, 0);
+    const auto third = allocator.allocate(30, 9);
+    ASSERT_TRUE(first && second && third);
+    allocator.free(*first);
+    EXPECT_EQ(allocator.get_stats().vertex_free_ranges, 2u);
+
+    std::vector<std::pair<GeometryRange, GeometryRange>> moves;
+    allocator.repack(200, 50, [&](const GeometryRange& from, const GeometryRange& to) {
+        moves.emplace_back(from, to);
+    });
+
+    ASSERT_EQ(moves.size(), 2u);
+    EXPECT_EQ(moves[0].first.vertex_offset, 10u);
+    EXPECT_EQ(moves[0].second.vertex_offset, 0u);
+    EXPECT_EQ(moves[1].first.vertex_offset, 30u);
+    EXPECT_EQ(moves[1].first.first_index, 6u);
+    EXPECT_EQ(moves[1].second.vertex_offset, 20u);
+    EXPECT_EQ(moves[1].second.first_index, 0u);
+
+    // Handles survive and resolve to the packed ranges.
+    EXPECT_EQ(allocator.get_range(*third).vertex_offset, 20u);
+    const GeometryArenaStats stats = allocator.get_stats();
+    EXPECT_EQ(stats.vertex_capacity, 200u);
+    EXPECT_EQ(stats.index_capacity, 50u);
+    EXPECT_EQ(stats.vertex_used, 50u);
+    EXPECT_EQ(stats.index_used, 9u);
+    EXPECT_EQ(stats.vertex_free_ranges, 1u);
+    EXPECT_EQ(stats.index_free_ranges, 1u);
+
+    const auto fourth = allocator.allocate(150, 41);
+    ASSERT_TRUE(fourth);
+    EXPECT_EQ(allocator.get_range(*fourth).vertex_offset, 50u);
+    EXPECT_EQ(allocator.get_range(*fourth).first_index, 9u);
+}
+
+}
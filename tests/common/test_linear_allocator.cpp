@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include "core/linear_allocator.h"
+
+namespace Comet::Tests {
+
+TEST(LinearAllocatorTest, AlignsEachAllocationWithinTheRange) {
+    LinearAllocator allocator(256, 1024);
+
+    EXPECT_EQ(allocator.allocate(8, 64), 256u);
+    EXPECT_EQ(allocator.allocate(8, 64), 320u);
+    EXPECT_EQ(allocator.allocate(4), 328u);
+    EXPECT_EQ(allocator.allocate(16, 256), 512u);
+    EXPECT_EQ(allocator.get_used(), 272u);
+}
+
+TEST(LinearAllocatorTest, RejectsAllocationsPastTheEnd) {
+    LinearAllocator allocator(0, 128);
+
+    EXPECT_EQ(allocator.allocate(100, 16), 0u);
+    EXPECT_FALSE(allocator.allocate(20, 16).has_value());
+    EXPECT_EQ(allocator.allocate(12, 4), 100u);
+    EXPECT_EQ(allocator.allocate(16, 16), 112u);
+    EXPECT_FALSE(allocator.allocate(1).has_value());
+}
+
+TEST(LinearAllocatorTest, RejectsNonPowerOfTwoAlignment) {
+    LinearAllocator allocator(0, 128);
+
+    EXPECT_FALSE(allocator.allocate(4, 0).has_value());
+    EXPECT_FALSE(allocator.allocate(4, 48).has_value());
+}
+
+TEST(LinearAllocatorTest, ResetRewindsOrMovesTheRange) {
+    LinearAllocator allocator(0, 64);
+    EXPECT_EQ(allocator.allocate(64), 0u);
+
+    allocator.reset();
+    EXPECT_EQ(allocator.get_used(), 0u);
+    EXPECT_EQ(allocator.allocate(32), 0u);
+
+    allocator.reset(512, 576);
+    EXPECT_EQ(allocator.allocate(32, 32), 512u);
+    EXPECT_EQ(allocator.get_capacity(), 64u);
+}
+
+} // namespace Comet::Tests
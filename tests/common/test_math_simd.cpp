@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "core/math_simd.h"
+#include "../test_utils.h"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace Comet::Tests {
+
+namespace {
+    struct TrsArrays {
+        std::vector<Math::Vec3> translations;
+        std::vector<Math::Vec3> rotations;
+        std::vector<Math::Vec3> scales;
+    };
+
+    TrsArrays MakeRandomTransforms(const std::size_t count, const float max_degrees) {
+        std::mt19937 generator(1234);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> angle(-max_degrees, max_degrees);
+        std::uniform_real_distribution<float> scale(0.1f, 4.0f);
+
+        TrsArrays arrays;
+        for(std::size_t index = 0; index < count; ++index) {
+            arrays.translations.emplace_back(position(generator), position(generator), position(generator));
+            arrays.rotations.emplace_back(angle(generator), angle(generator), angle(generator));
+            arrays.scales.emplace_back(scale(generator), scale(generator), scale(generator));
+        }
+        return arrays;
+    }
+}
+
+TEST(MathSimdTest, BatchMatchesComposeTrs) {
+    // An odd count exercises the padded tail of the vector loop.
+    const TrsArrays arrays = MakeRandomTransforms(1027, 180.0f);
+    std::vector<Math::Mat4> matrices(arrays.translations.size());
+
+    Math::compose_trs_batch(arrays.translations.data(), arrays.rotations.data(),
+                            arrays.scales.data(), matrices.data(), matrices.size());
+
+    for(std::size_t index = 0; index < matrices.size(); ++index) {
+        const Math::Mat4 expected = Math::compose_trs(
+            arrays.translations[index], arrays.rotations[index], arrays.scales[index]);
+        ASSERT_TRUE(TestUtils::Mat4Equal(matrices[index], expected, 1e-5f)) << "transform " << index;
+    }
+}
+
+TEST(MathSimdTest, BatchHandlesAnglesOutsideSignedCycle) {
+    const TrsArrays arrays = MakeRandomTransforms(64, 1440.0f);
+    std::vector<Math::Mat4> matrices(arrays.translations.size());
+
+    Math::compose_trs_batch(arrays.translations.data(), arrays.rotations.data(),
+                            arrays.scales.data(), matrices.data(), matrices.size());
+
+    for(std::size_t index = 0; index < matrices.size(); ++index) {
+        const Math::Mat4 expected = Math::compose_trs(
+            arrays.translations[index], arrays.rotations[index], arrays.scales[index]);
+        ASSERT_TRUE(TestUtils::Mat4Equal(matrices[index], expected, 1e-4f)) << "transform " << index;
+    }
+}
+
+TEST(MathSimdTest, NullScaleComposesUnitScale) {
+    const TrsArrays arrays = MakeRandomTransforms(9, 180.0f);
+    std::vector<Math::Mat4> matrices(arrays.translations.size());
+
+    Math::compose_trs_batch(arrays.translations.data(), arrays.rotations.data(),
+                            nullptr, matrices.data(), matrices.size());
+
+    for(std::size_t index = 0; index < matrices.size(); ++index) {
+        const Math::Mat4 expected = Math::compose_trs(
+            arrays.translations[index], arrays.rotations[index], Math::Vec3(1.0f));
+        EXPECT_TRUE(TestUtils::Mat4Equal(matrices[index], expected, 1e-5f));
+    }
+}
+
+TEST(MathSimdTest, ResultsDoNotDependOnBatchSplit) {
+    const TrsArrays arrays = MakeRandomTransforms(37, 180.0f);
+    std::vector<Math::Mat4> whole(arrays.translations.size());
+    std::vector<Math::Mat4> split(arrays.translations.size());
+
+    Math::compose_trs_batch(arrays.translations.data(), arrays.rotations.data(),
+                            arrays.scales.data(), whole.data(), whole.size());
+    for(std::size_t index = 0; index < split.size(); ++index) {
+        Math::compose_trs_batch(&arrays.translations[index], &arrays.rotations[index],
+                                &arrays.scales[index], &split[index], 1);
+    }
+
+    EXPECT_EQ(whole, split);
+}
+
+} // namespace Comet::Tests
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "core/mip_chain.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Comet::Tests {
+
+namespace {
+    std::vector<uint8_t> make_pattern(const uint32_t width, const uint32_t height) {
+        std::vector<uint8_t> pixels(static_cast<std::size_t>(width) * height * 4);
+        for(std::size_t i = 0; i < pixels.size(); ++i) {
+            pixels[i] = static_cast<uint8_t>((i * 37 + i / 7) & 0xFF);
+        }
+        return pixels;
+    }
+
+    uint8_t reference_texel(const std::vector<uint8_t>& pixels, const uint32_t width, const uint32_t height,
+                            const uint32_t x, const uint32_t y, const uint32_t channel) {
+        const auto at = [&](const uint32_t sx, const uint32_t sy) -> uint32_t {
+            return pixels[(static_cast<std::size_t>(std::min(sy, height - 1)) * width
+                           + std::min(sx, width - 1)) * 4 + channel];
+        };
+        const uint32_t sum = at(2 * x, 2 * y) + at(2 * x + 1, 2 * y)
+            + at(2 * x, 2 * y + 1) + at(2 * x + 1, 2 * y + 1);
+        return static_cast<uint8_t>((sum + 2) / 4);
+    }
+}
+
+TEST(MipChainTest, CountsLevelsDownToOneTexel) {
+    EXPECT_EQ(compute_mip_level_count(1, 1), 1u);
+    EXPECT_EQ(compute_mip_level_count(256, 256), 9u);
+    EXPECT_EQ(compute_mip_level_count(300, 20), 9u);
+    EXPECT_EQ(compute_mip_level_count(0, 0), 0u);
+}
+
+TEST(MipChainTest, DescribesTightlyPackedLevels) {
+    const auto levels = describe_mip_chain(5, 3, 3, 4);
+
+    ASSERT_EQ(levels.size(), 3u);
+    EXPECT_EQ(levels[0].size, 60u);
+    EXPECT_EQ(levels[1].width, 2u);
+    EXPECT_EQ(levels[1].height, 1u);
+    EXPECT_EQ(levels[1].offset, 60u);
+    EXPECT_EQ(levels[2].width, 1u);
+    EXPECT_EQ(levels[2].offset, 68u);
+}
+
+TEST(MipChainTest, DownsampleMatchesScalarBoxFilter) {
+    for(const auto [width, height]: {std::pair(16u, 8u), std::pair(19u, 7u), std::pair(1u, 6u), std::pair(10u, 1u)}) {
+        const auto pixels = make_pattern(width, height);
+        const uint32_t target_width = std::max(1u, width / 2);
+        const uint32_t target_height = std::max(1u, height / 2);
+        std::vector<uint8_t> result(static_cast<std::size_t>(target_width) * target_height * 4);
+
+        downsample_rgba8_box(pixels.data(), width, height, result.data());
+
+        for(uint32_t y = 0; y < target_height; ++y) {
+            for(uint32_t x = 0; x < target_width; ++x) {
+                for(uint32_t channel = 0; channel < 4; ++channel) {
+                    ASSERT_EQ(result[(y * target_width + x) * 4 + channel],
+                              reference_texel(pixels, width, height, x, y, channel))
+                        << width << "x" << height << " at " << x << "," << y;
+                }
+            }
+        }
+    }
+}
+
+TEST(MipChainTest, BuildsChainEndingInTheAverageTexel) {
+    std::vector<uint8_t> pixels(8 * 8 * 4);
+    for(std::size_t i = 0; i < pixels.size(); i += 4) {
+        const uint8_t value = (i / 4) % 2 == 0 ? 0 : 200;
+        pixels[i] = value;
+        pixels[i + 1] = 50;
+        pixels[i + 2] = 255;
+        pixels[i + 3] = 255;
+    }
+
+    const auto chain = build_rgba8_mip_chain(pixels.data(), 8, 8, compute_mip_level_count(8, 8));
+    const auto levels = describe_mip_chain(8, 8, 4, 4);
+
+    ASSERT_EQ(chain.size(), levels.back().offset + levels.back().size);
+    const uint8_t* last = chain.data() + levels.back().offset;
+    EXPECT_EQ(last[0], 100);
+    EXPECT_EQ(last[1], 50);
+    EXPECT_EQ(last[2], 255);
+    EXPECT_EQ(last[3], 255);
+}
+
+TEST(MipChainTest, SrgbDownsampleAveragesColourInLinearSpace) {
+    // Black and white columns: the linear mean 0.5 encodes to 188, not the
+    // 128 a byte average gives. Alpha stays a plain average.
+    std::vector<uint8_t> pixels(2 * 2 * 4);
+    for(std::size_t texel = 0; texel < 4; ++texel) {
+        const uint8_t value = texel % 2 == 0 ? 0 : 255;
+        std::fill_n(pixels.begin() + static_cast<std::ptrdiff_t>(texel * 4), 4, value);
+    }
+    std::array<uint8_t, 4> texel{};
+
+    downsample_srgba8_box(pixels.data(), 2, 2, texel.data());
+
+    EXPECT_EQ(texel[0], 188);
+    EXPECT_EQ(texel[1], 188);
+    EXPECT_EQ(texel[2], 188);
+    EXPECT_EQ(texel[3], 128);
+
+    // Every code survives a uniform image unchanged.
+    for(uint32_t code = 0; code < 256; ++code) {
+        std::vector<uint8_t> uniform(2 * 2 * 4, static_cast<uint8_t>(code));
+        downsample_srgba8_box(uniform.data(), 2, 2, texel.data());
+        ASSERT_EQ(texel[0], code);
+    }
+
+    const auto chain = build_rgba8_mip_chain(pixels.data(), 2, 2, 2, true);
+    EXPECT_EQ(chain[16], 188);
+}
+
+}
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include "core/stable_hash.h"
+
+#include <string>
+
+namespace Comet::Tests {
+
+TEST(StableHasherTest, MatchesReferenceFnv1a) {
+    // FNV-1a 64 test vectors.
+    EXPECT_EQ(StableHasher().get(), 0xcbf29ce484222325ull);
+    EXPECT_EQ(StableHasher().add_bytes("a", 1).get(), 0xaf63dc4c8601ec8cull);
+    EXPECT_EQ(StableHasher().add_bytes("foobar", 6).get(), 0x85944171f73967e8ull);
+}
+
+TEST(StableHasherTest, DependsOnValuesNotStorage) {
+    const std::string first = "cube_texture_frag";
+    const std::string second(first.begin(), first.end());
+
+    EXPECT_EQ(StableHasher().add(first).add(7u).get(), StableHasher().add(second).add(7u).get());
+    EXPECT_NE(StableHasher().add(first).add(7u).get(), StableHasher().add(first).add(8u).get());
+}
+
+TEST(StableHasherTest, StringsAreLengthPrefixed) {
+    EXPECT_NE(StableHasher().add("ab").add("c").get(), StableHasher().add("a").add("bc").get());
+}
+
+TEST(StableHasherTest, SeedIsHashedAsLeadingField) {
+    const uint64_t base = StableHasher().add("base").get();
+
+    EXPECT_EQ(StableHasher(base).add(1).get(), StableHasher().add(base).add(1).get());
+    EXPECT_NE(StableHasher(base).add(1).get(), StableHasher().add(1).get());
+}
+
+} // namespace Comet::Tests
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "core/staging_block_allocator.h"
+
+namespace Comet::Tests {
+
+TEST(StagingBlockAllocatorTest, FillsTheCurrentBlockWithAlignedOffsets) {
+    StagingBlockAllocator allocator(256, 2, 16);
+
+    const auto first = allocator.allocate(10, 1);
+    const auto second = allocator.allocate(20, 1);
+    ASSERT_TRUE(first && second);
+    EXPECT_EQ(first->block, 0u);
+    EXPECT_EQ(first->offset, 0u);
+    EXPECT_EQ(second->block, 0u);
+    EXPECT_EQ(second->offset, 16u);
+    EXPECT_EQ(allocator.get_block_count(), 1u);
+    EXPECT_EQ(allocator.get_stats().in_flight_bytes, 36u);
+    EXPECT_EQ(allocator.get_stats().avoided_allocations, 1u);
+}
+
+TEST(StagingBlockAllocatorTest, OpensBlocksUpToTheLimit) {
+    StagingBlockAllocator allocator(100, 2, 16);
+
+    ASSERT_EQ(allocator.allocate(80, 1)->block, 0u);
+    ASSERT_EQ(allocator.allocate(80, 2)->block, 1u);
+    EXPECT_FALSE(allocator.allocate(80, 3).has_value());
+    EXPECT_EQ(allocator.get_block_count(), 2u);
+    EXPECT_EQ(allocator.get_stats().block_count, 2u);
+}
+
+TEST(StagingBlockAllocatorTest, RecyclesBlocksOnceTheirLastBatchCompletes) {
+    StagingBlockAllocator allocator(100, 2, 16);
+    ASSERT_TRUE(allocator.allocate(80, 1));
+    ASSERT_TRUE(allocator.allocate(80, 2));
+    ASSERT_TRUE(allocator.allocate(10, 3));
+
+    // Block 0 only served batch 1; block 1 was last used by batch 3.
+    EXPECT_EQ(allocator.recycle(2), 0u);
+    EXPECT_EQ(allocator.get_stats().in_flight_bytes, 90u);
+
+    const auto reused = allocator.allocate(90, 4);
+    ASSERT_TRUE(reused);
+    EXPECT_EQ(reused->block, 0u);
+    EXPECT_EQ(reused->offset, 0u);
+    EXPECT_EQ(allocator.get_block_count(), 2u);
+
+    EXPECT_EQ(allocator.recycle(4), 0u);
+    EXPECT_EQ(allocator.get_stats().in_flight_bytes, 0u);
+    EXPECT_EQ(allocator.get_stats().peak_in_flight_bytes, 180u);
+}
+
+TEST(StagingBlockAllocatorTest, OversizedRequestsAreLeftToTheCaller) {
+    StagingBlockAllocator allocator(64, 4, 16);
+
+    EXPECT_FALSE(allocator.allocate(65, 1).has_value());
+    EXPECT_EQ(allocator.get_block_count(), 0u);
+
+    allocator.add_dedicated(65, 1);
+    allocator.add_dedicated(500, 2);
+    EXPECT_EQ(allocator.get_stats().dedicated_allocations, 2u);
+    EXPECT_EQ(allocator.get_stats().in_flight_bytes, 565u);
+
+    EXPECT_EQ(allocator.recycle(0), 0u);
+    EXPECT_EQ(allocator.recycle(1), 1u);
+    EXPECT_EQ(allocator.get_stats().in_flight_bytes, 500u);
+    EXPECT_EQ(allocator.recycle(5), 1u);
+    EXPECT_EQ(allocator.get_stats().in_flight_bytes, 0u);
+}
+
+}
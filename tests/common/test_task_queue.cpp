@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "core/task_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Comet::Tests {
+
+TEST(TaskQueueTest, RunsEveryTaskOnWorkerThreads) {
+    TaskQueue queue(3);
+    ASSERT_EQ(queue.thread_count(), 3u);
+
+    const std::thread::id caller = std::this_thread::get_id();
+    std::atomic<int> runs = 0;
+    std::atomic<bool> ran_on_caller = false;
+    for(int index = 0; index < 200; ++index) {
+        queue.submit([&] {
+            if(std::this_thread::get_id() == caller) {
+                ran_on_caller = true;
+            }
+            ++runs;
+        });
+    }
+    queue.wait_idle();
+
+    EXPECT_EQ(runs.load(), 200);
+    EXPECT_FALSE(ran_on_caller.load());
+    EXPECT_EQ(queue.get_pending_count(), 0u);
+}
+
+TEST(TaskQueueTest, SingleWorkerPreservesSubmissionOrder) {
+    TaskQueue queue(1);
+    std::mutex mutex;
+    std::vector<int> order;
+    for(int index = 0; index < 32; ++index) {
+        queue.submit([&, index] {
+            std::lock_guard lock(mutex);
+            order.push_back(index);
+        });
+    }
+    queue.wait_idle();
+
+    ASSERT_EQ(order.size(), 32u);
+    for(int index = 0; index < 32; ++index) {
+        EXPECT_EQ(order[index], index);
+    }
+}
+
+TEST(TaskQueueTest, DestructionDropsTasksNotYetStarted) {
+    std::atomic<int> runs = 0;
+    std::atomic<bool> started = false;
+    std::atomic<bool> release = false;
+    std::thread releaser;
+    {
+        TaskQueue queue(1);
+        queue.submit([&] {
+            started = true;
+            while(!release.load()) {
+                std::this_thread::yield();
+            }
+            ++runs;
+        });
+        for(int index = 0; index < 8; ++index) {
+            queue.submit([&] { ++runs; });
+        }
+        while(!started.load()) {
+            std::this_thread::yield();
+        }
+        // Let the destructor begin before the running task finishes.
+        releaser = std::thread([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            release = true;
+        });
+    }
+    releaser.join();
+
+    EXPECT_EQ(runs.load(), 1);
+}
+
+} // namespace Comet::Tests
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include "core/texel_swizzle.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Comet::Tests {
+
+TEST(TexelSwizzleTest, SwapsRedAndBlueForEveryTexel) {
+    // odd count exercises both the vector loop and the scalar tail
+    constexpr std::size_t texel_count = 37;
+    std::vector<uint8_t> rgba(texel_count * 4);
+    for(std::size_t i = 0; i < rgba.size(); ++i) {
+        rgba[i] = static_cast<uint8_t>(i * 13 + 5);
+    }
+    std::vector<uint8_t> bgra(rgba.size());
+
+    swizzle_rgba8_to_bgra8(rgba.data(), bgra.data(), texel_count);
+
+    for(std::size_t texel = 0; texel < texel_count; ++texel) {
+        EXPECT_EQ(bgra[texel * 4 + 0], rgba[texel * 4 + 2]);
+        EXPECT_EQ(bgra[texel * 4 + 1], rgba[texel * 4 + 1]);
+        EXPECT_EQ(bgra[texel * 4 + 2], rgba[texel * 4 + 0]);
+        EXPECT_EQ(bgra[texel * 4 + 3], rgba[texel * 4 + 3]);
+    }
+}
+
+TEST(TexelSwizzleTest, InPlaceSwizzleRoundTrips) {
+    std::vector<uint8_t> pixels(23 * 4);
+    for(std::size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<uint8_t>(i * 7);
+    }
+    const auto original = pixels;
+
+    swizzle_rgba8_to_bgra8(pixels.data(), pixels.data(), 23);
+    EXPECT_NE(pixels, original);
+    swizzle_rgba8_to_bgra8(pixels.data(), pixels.data(), 23);
+    EXPECT_EQ(pixels, original);
+}
+
+} // namespace Comet::Tests
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "core/thread_pool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Comet::Tests {
+
+TEST(ThreadPoolTest, ParallelForCoversEveryIndexOnce) {
+    ThreadPool pool(4);
+    ASSERT_EQ(pool.thread_count(), 4u);
+
+    std::vector<int> visits(10007, 0);
+    for(int round = 0; round < 8; ++round) {
+        pool.parallel_for(visits.size(), 16, [&](const std::size_t begin, const std::size_t end) {
+            for(std::size_t index = begin; index < end; ++index) {
+                ++visits[index];
+            }
+        });
+    }
+
+    for(const int count: visits) {
+        ASSERT_EQ(count, 8);
+    }
+}
+
+TEST(ThreadPoolTest, SmallRangesRunOnCallingThread) {
+    ThreadPool pool(4);
+    std::atomic<int> calls = 0;
+
+    pool.parallel_for(8, 64, [&](const std::size_t begin, const std::size_t end) {
+        EXPECT_EQ(begin, 0u);
+        EXPECT_EQ(end, 8u);
+        ++calls;
+    });
+    pool.parallel_for(0, 1, [&](std::size_t, std::size_t) { ++calls; });
+
+    EXPECT_EQ(calls.load(), 1);
+}
+
+TEST(ThreadPoolTest, ZeroUsesHardwareThreads) {
+    const ThreadPool pool(0);
+
+    EXPECT_GE(pool.thread_count(), 1u);
+}
+
+} // namespace Comet::Tests
@@ -44,8 +44,10 @@ namespace CometEditor::Tests {
         selection.select_entity(entity.get_id());
 
         Comet::Entity selected_entity = selection.get_selected_entity();
-        selected_entity.get_component<Comet::NameComponent>().name = "After";
-        selected_entity.get_component<Comet::TransformComponent>().translation.x = 2.0f;
+        selected_entity.patch_component<Comet::NameComponent>(
+            [](Comet::NameComponent& name) { name.name = "After"; });
+        selected_entity.patch_component<Comet::TransformComponent>(
+            [](Comet::TransformComponent& transform) { transform.translation.x = 2.0f; });
 
         const Comet::Entity stored_entity = scene.find_entity(entity.get_id());
         EXPECT_EQ(stored_entity.get_component<Comet::NameComponent>().name, "After");
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "graphics/deletion_queue.h"
+
+#include <memory>
+#include <vector>
+
+namespace Comet::Tests {
+    TEST(DeletionQueueTest, DestroysOnlyOnceTheReleasingFrameCompleted) {
+        DeletionQueue queue;
+        std::vector<int> destroyed;
+
+        queue.set_current_frame(1);
+        queue.push([&destroyed] { destroyed.push_back(1); });
+        queue.set_current_frame(2);
+        queue.push([&destroyed] { destroyed.push_back(2); });
+        queue.push([&destroyed] { destroyed.push_back(3); });
+
+        EXPECT_EQ(queue.collect(0), 0u);
+        EXPECT_TRUE(destroyed.empty());
+
+        EXPECT_EQ(queue.collect(1), 1u);
+        EXPECT_EQ(destroyed, (std::vector<int>{1}));
+
+        EXPECT_EQ(queue.collect(3), 2u);
+        EXPECT_EQ(destroyed, (std::vector<int>{1, 2, 3}));
+        EXPECT_EQ(queue.get_pending_count(), 0u);
+    }
+
+    TEST(DeletionQueueTest, RetiredResourceOutlivesItsLastOwner) {
+        DeletionQueue queue;
+        queue.set_current_frame(4);
+
+        auto resource = std::make_shared<int>(7);
+        const std::weak_ptr<int> observer = resource;
+        queue.retire(std::move(resource));
+        EXPECT_FALSE(observer.expired());
+
+        static_cast<void>(queue.collect(3));
+        EXPECT_FALSE(observer.expired());
+        static_cast<void>(queue.collect(4));
+        EXPECT_TRUE(observer.expired());
+    }
+
+    TEST(DeletionQueueTest, CurrentFrameNeverMovesBackwards) {
+        DeletionQueue queue;
+        queue.set_current_frame(5);
+        queue.set_current_frame(3);
+        EXPECT_EQ(queue.get_current_frame(), 5u);
+    }
+
+    TEST(DeletionQueueTest, FlushRunsEverythingIncludingNestedReleases) {
+        DeletionQueue queue;
+        queue.set_current_frame(10);
+        int destroyed = 0;
+        queue.push([&queue, &destroyed] {
+            ++destroyed;
+            queue.push([&destroyed] { ++destroyed; });
+        });
+
+        EXPECT_EQ(queue.flush(), 2u);
+        EXPECT_EQ(destroyed, 2);
+        EXPECT_EQ(queue.get_pending_count(), 0u);
+    }
+
+    TEST(DeletionQueueTest, DestructorRunsPendingDeleters) {
+        bool destroyed = false;
+        {
+            DeletionQueue queue;
+            queue.set_current_frame(1);
+            queue.push([&destroyed] { destroyed = true; });
+        }
+        EXPECT_TRUE(destroyed);
+    }
+}
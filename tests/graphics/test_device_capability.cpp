@@ -19,7 +19,9 @@ namespace Comet::Tests {
                 .requested_present_mode_supported = true,
                 .color_format_supported = true,
                 .depth_format_supported = true,
-                .synchronization2_supported = true
+                .synchronization2_supported = true,
+                .dynamic_rendering_supported = true,
+                .timeline_semaphore_supported = true
             };
         }
 
@@ -54,6 +56,8 @@ namespace Comet::Tests {
         candidate.color_format_supported = false;
         candidate.depth_format_supported = false;
         candidate.synchronization2_supported = false;
+        candidate.dynamic_rendering_supported = false;
+        candidate.timeline_semaphore_supported = false;
 
         const auto evaluation = evaluate_device_candidate(
             candidate, DeviceCapabilityRequest{});
@@ -66,6 +70,8 @@ namespace Comet::Tests {
         EXPECT_TRUE(contains_reason(evaluation, "color format"));
         EXPECT_TRUE(contains_reason(evaluation, "depth format"));
         EXPECT_TRUE(contains_reason(evaluation, "synchronization2"));
+        EXPECT_TRUE(contains_reason(evaluation, "dynamicRendering"));
+        EXPECT_TRUE(contains_reason(evaluation, "timelineSemaphore"));
     }
 
     TEST(DeviceCandidateEvaluationTest, ScoresPreferredCapabilitiesDeterministically) {
@@ -103,6 +109,20 @@ namespace Comet::Tests {
         EXPECT_FALSE(disabled.notes.empty());
     }
 
+    TEST(DeviceCandidateEvaluationTest, EnablesOptionalBCTextureCompression) {
+        auto candidate = make_suitable_candidate();
+        candidate.texture_compression_bc_supported = true;
+        const auto enabled = evaluate_device_candidate(candidate, DeviceCapabilityRequest{});
+        EXPECT_TRUE(enabled.is_suitable());
+        EXPECT_TRUE(enabled.enabled_features.textureCompressionBC);
+
+        candidate.texture_compression_bc_supported = false;
+        const auto fallback = evaluate_device_candidate(candidate, DeviceCapabilityRequest{});
+        EXPECT_TRUE(fallback.is_suitable());
+        EXPECT_FALSE(fallback.enabled_features.textureCompressionBC);
+        EXPECT_FALSE(fallback.notes.empty());
+    }
+
     TEST(DeviceCandidateEvaluationTest, EnablesRequiredSynchronization2Feature) {
         const auto evaluation = evaluate_device_candidate(
             make_suitable_candidate(), DeviceCapabilityRequest{});
@@ -110,4 +130,20 @@ namespace Comet::Tests {
         ASSERT_TRUE(evaluation.is_suitable());
         EXPECT_TRUE(evaluation.enabled_vulkan13_features.synchronization2);
     }
+
+    TEST(DeviceCandidateEvaluationTest, EnablesRequiredDynamicRenderingFeature) {
+        const auto evaluation = evaluate_device_candidate(
+            make_suitable_candidate(), DeviceCapabilityRequest{});
+
+        ASSERT_TRUE(evaluation.is_suitable());
+        EXPECT_TRUE(evaluation.enabled_vulkan13_features.dynamicRendering);
+    }
+
+    TEST(DeviceCandidateEvaluationTest, EnablesRequiredTimelineSemaphoreFeature) {
+        const auto evaluation = evaluate_device_candidate(
+            make_suitable_candidate(), DeviceCapabilityRequest{});
+
+        ASSERT_TRUE(evaluation.is_suitable());
+        EXPECT_TRUE(evaluation.enabled_vulkan12_features.timelineSemaphore);
+    }
 }
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "graphics/device.h"
+#include "graphics/queue.h"
+#include "render/frame_manager.h"
+#include "render/render_context.h"
+#include "../test_config.h"
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace Comet::Tests {
+    namespace {
+        // Frames are submitted without work, so only the timeline
+        // signal of each submission is exercised.
+        class FrameManagerTest : public ::testing::Test {
+        protected:
+            void SetUp() override {
+                SKIP_IF_NO_GRAPHICS();
+                SKIP_IF_NO_VULKAN();
+                if(!glfwInit() || !glfwVulkanSupported()) {
+                    GTEST_SKIP() << "GLFW cannot create Vulkan surfaces here";
+                }
+                const Config::Window window_config{.width = 64, .height = 64, .title = "FrameManagerTest"};
+                m_window.emplace(window_config);
+                if(!m_window->get()) {
+                    GTEST_SKIP() << "Window creation failed";
+                }
+                m_render_context = std::make_unique<RenderContext>(
+                    *m_window, Config::Vulkan{}, Config::Render{});
+            }
+
+            void TearDown() override {
+                m_render_context.reset();
+                m_window.reset();
+            }
+
+            // Records and submits an empty frame signalling its frame number.
+            static void submit_frame(Device& device, FrameManager& frames) {
+                CommandBuffer& command_buffer = frames.get_current_command_buffer();
+                command_buffer.begin(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+                command_buffer.end();
+                const std::array signals = {
+                    QueueSemaphoreSubmit{
+                        frames.get_frame_timeline(),
+                        Flags<PipelineStage>(PipelineStage::AllCommands),
+                        frames.get_frame_number()
+                    }
+                };
+                device.get_graphics_queue(0).submit2(
+                    std::span<const QueueSemaphoreSubmit>(),
+                    std::span(&command_buffer, 1),
+                    std::span<const QueueSemaphoreSubmit>(signals),
+                    nullptr);
+                frames.end_frame();
+            }
+
+            std::optional<Window> m_window;
+            std::unique_ptr<RenderContext> m_render_context;
+        };
+    }
+
+    TEST_F(FrameManagerTest, NumbersFramesFromOneAndSignalsEachOnCompletion) {
+        Device& device = m_render_context->get_device();
+        FrameManager frames(device, 2);
+        EXPECT_EQ(frames.get_frame_number(), 1u);
+        EXPECT_EQ(frames.get_completed_frame(), 0u);
+
+        for(uint64_t frame = 1; frame <= 3; ++frame) {
+            frames.begin_frame();
+            EXPECT_EQ(frames.get_frame_number(), frame);
+            EXPECT_EQ(frames.get_current_frame_slot_index(), (frame - 1) % 2);
+            submit_frame(device, frames);
+            EXPECT_TRUE(frames.wait_for_frame(frame));
+            EXPECT_GE(frames.get_completed_frame(), frame);
+        }
+        EXPECT_EQ(frames.get_frame_number(), 4u);
+        // Finished frames do not block, even with a zero timeout.
+        EXPECT_TRUE(frames.wait_for_frame(1, 0));
+    }
+
+    TEST_F(FrameManagerTest, CollectsDeletionsOnceTheirFrameCompletes) {
+        Device& device = m_render_context->get_device();
+        DeletionQueue& deletion_queue = device.get_deletion_queue();
+        FrameManager frames(device, 2);
+        EXPECT_EQ(deletion_queue.get_current_frame(), 1u);
+
+        int destroyed = 0;
+        frames.begin_frame();
+        deletion_queue.push([&destroyed] { ++destroyed; });
+        submit_frame(device, frames);
+        EXPECT_EQ(deletion_queue.get_current_frame(), 2u);
+        EXPECT_EQ(destroyed, 0);
+
+        ASSERT_TRUE(frames.wait_for_frame(1));
+        frames.begin_frame();
+        EXPECT_EQ(destroyed, 1);
+
+        // Released while frame 2 is recorded, so frame 1 completing is not
+        // enough to destroy it.
+        deletion_queue.push([&destroyed] { ++destroyed; });
+        EXPECT_EQ(deletion_queue.collect(frames.get_completed_frame()), 0u);
+        submit_frame(device, frames);
+
+        ASSERT_TRUE(frames.wait_for_frame(2));
+        frames.begin_frame();
+        EXPECT_EQ(destroyed, 2);
+        EXPECT_EQ(deletion_queue.get_pending_count(), 0u);
+    }
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "graphics/pipeline_cache_file.h"
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Comet::Tests {
+    namespace {
+        PipelineCacheIdentity make_identity() {
+            PipelineCacheIdentity identity;
+            identity.vendor_id = 0x10DE;
+            identity.device_id = 0x2684;
+            identity.driver_version = 0x8A3C4000;
+            for(uint8_t i = 0; i < identity.cache_uuid.size(); ++i) {
+                identity.cache_uuid[i] = static_cast<uint8_t>(i * 11 + 3);
+            }
+            return identity;
+        }
+
+        // A blob laid out like vkGetPipelineCacheData output.
+        std::vector<uint8_t> make_blob(const PipelineCacheIdentity& identity, const std::size_t payload) {
+            std::vector<uint8_t> blob(32 + payload);
+            const uint32_t header[4] = {32, 1, identity.vendor_id, identity.device_id};
+            std::memcpy(blob.data(), header, sizeof(header));
+            std::memcpy(blob.data() + 16, identity.cache_uuid.data(), identity.cache_uuid.size());
+            for(std::size_t i = 32; i < blob.size(); ++i) {
+                blob[i] = static_cast<uint8_t>(i * 7);
+            }
+            return blob;
+        }
+
+        std::vector<uint8_t> unpack(const PipelineCacheIdentity& identity, const std::vector<uint8_t>& file,
+                                    std::string& rejection) {
+            return unpack_pipeline_cache(identity, file, rejection).value_or(std::vector<uint8_t>{});
+        }
+    }
+
+    TEST(PipelineCacheFileTest, RoundTripsBlobForSameDevice) {
+        const auto identity = make_identity();
+        const auto blob = make_blob(identity, 200);
+
+        std::string rejection;
+        const auto restored = unpack_pipeline_cache(identity, pack_pipeline_cache(identity, blob), rejection);
+
+        ASSERT_TRUE(restored.has_value()) << rejection;
+        EXPECT_EQ(*restored, blob);
+    }
+
+    TEST(PipelineCacheFileTest, RejectsOtherDeviceOrDriver) {
+        const auto identity = make_identity();
+        const auto file = pack_pipeline_cache(identity, make_blob(identity, 64));
+        std::string rejection;
+
+        auto other_driver = identity;
+        other_driver.driver_version += 1;
+        EXPECT_TRUE(unpack(other_driver, file, rejection).empty());
+        EXPECT_NE(rejection.find("driver"), std::string::npos);
+
+        auto other_device = identity;
+        other_device.device_id += 1;
+        EXPECT_TRUE(unpack(other_device, file, rejection).empty());
+
+        auto other_uuid = identity;
+        other_uuid.cache_uuid[5] ^= 0xFF;
+        EXPECT_TRUE(unpack(other_uuid, file, rejection).empty());
+    }
+
+    TEST(PipelineCacheFileTest, RejectsTruncatedCorruptOrMismatchedBlobs) {
+        const auto identity = make_identity();
+        const auto file = pack_pipeline_cache(identity, make_blob(identity, 64));
+        std::string rejection;
+
+        auto truncated = file;
+        truncated.resize(truncated.size() - 5);
+        EXPECT_TRUE(unpack(identity, truncated, rejection).empty());
+
+        auto corrupt = file;
+        corrupt.back() ^= 0x1;
+        EXPECT_TRUE(unpack(identity, corrupt, rejection).empty());
+
+        // A valid wrapper around a blob whose Vulkan header names another vendor.
+        auto foreign_identity = identity;
+        foreign_identity.vendor_id = 0x1002;
+        const auto foreign = pack_pipeline_cache(identity, make_blob(foreign_identity, 64));
+        EXPECT_TRUE(unpack(identity, foreign, rejection).empty());
+        EXPECT_NE(rejection.find("Vulkan"), std::string::npos);
+    }
+
+    TEST(PipelineCacheFileTest, WritesAtomicallyOverExistingFile) {
+        const auto directory = std::filesystem::temp_directory_path() / "comet_pipeline_cache_test";
+        std::filesystem::remove_all(directory);
+        const std::string path = (directory / "nested" / "pipeline_cache.bin").string();
+
+        const std::vector<uint8_t> first(100, 0xAB);
+        const std::vector<uint8_t> second(40, 0xCD);
+        ASSERT_TRUE(write_pipeline_cache_file(path, first));
+        ASSERT_TRUE(write_pipeline_cache_file(path, second));
+
+        const auto stored = read_pipeline_cache_file(path);
+        ASSERT_TRUE(stored.has_value());
+        EXPECT_EQ(*stored, second);
+        EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+        EXPECT_FALSE(read_pipeline_cache_file((directory / "missing.bin").string()).has_value());
+
+        std::filesystem::remove_all(directory);
+    }
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include "graphics/rendering_formats.h"
+
+namespace Comet::Tests {
+    namespace {
+        RenderingFormats make_formats() {
+            return RenderingFormats{
+                .color_formats = {Format::B8G8R8A8_UNORM},
+                .depth_format = Format::D32_SFLOAT,
+                .samples = SampleCount::Count4
+            };
+        }
+    }
+
+    TEST(RenderingFormatsTest, EqualFormatsShareCompatibilityHash) {
+        EXPECT_EQ(make_formats().get_compatibility_hash(), make_formats().get_compatibility_hash());
+    }
+
+    TEST(RenderingFormatsTest, CompatibilityHashCoversEveryFormat) {
+        const uint64_t base = make_formats().get_compatibility_hash();
+
+        RenderingFormats color = make_formats();
+        color.color_formats[0] = Format::R8G8B8A8_UNORM;
+        EXPECT_NE(color.get_compatibility_hash(), base);
+
+        RenderingFormats extra_color = make_formats();
+        extra_color.color_formats.push_back(Format::B8G8R8A8_UNORM);
+        EXPECT_NE(extra_color.get_compatibility_hash(), base);
+
+        RenderingFormats depth = make_formats();
+        depth.depth_format = Format::D24_UNORM_S8_UINT;
+        EXPECT_NE(depth.get_compatibility_hash(), base);
+
+        RenderingFormats samples = make_formats();
+        samples.samples = SampleCount::Count1;
+        EXPECT_NE(samples.get_compatibility_hash(), base);
+    }
+
+    TEST(RenderingFormatsTest, StencilFormatFollowsDepthFormat) {
+        RenderingFormats formats = make_formats();
+        EXPECT_EQ(formats.get_stencil_format(), Format::UNDEFINED);
+
+        formats.depth_format = Format::D24_UNORM_S8_UINT;
+        EXPECT_EQ(formats.get_stencil_format(), Format::D24_UNORM_S8_UINT);
+    }
+}
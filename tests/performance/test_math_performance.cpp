@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include "../../engine/src/core/math_utils.h"
+#include "../../engine/src/core/math_simd.h"
+#include <algorithm>
+#include <iostream>
 #include <vector>
 #include <random>
 
@@ -59,4 +62,42 @@ TEST_F(MathPerformanceTest, MatrixMultiplicationPerformance) {
     EXPECT_FALSE(result == Math::Mat4(0.0f)); // 确保结果不为零矩阵
 }
 
+TEST_F(MathPerformanceTest, BatchedTrsCompositionThroughput) {
+    // 用同一批平移、欧拉角与缩放比较逐个 compose_trs 与批量内核
+    std::vector<Math::Vec3> rotations;
+    std::vector<Math::Vec3> scales;
+    for (const auto& vec : test_vectors) {
+        rotations.push_back(vec * 1.8f);
+        scales.push_back(Math::Vec3(1.0f) + vec * 0.01f);
+    }
+    std::vector<Math::Mat4> scalar_results(test_vectors.size());
+    std::vector<Math::Mat4> batch_results(test_vectors.size());
+
+    constexpr int ROUNDS = 20;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (std::size_t i = 0; i < test_vectors.size(); ++i) {
+            scalar_results[i] = Math::compose_trs(test_vectors[i], rotations[i], scales[i]);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const auto scalar_duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        Math::compose_trs_batch(test_vectors.data(), rotations.data(), scales.data(),
+                                batch_results.data(), batch_results.size());
+    }
+    end = std::chrono::high_resolution_clock::now();
+    const auto batch_duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    const double transforms = static_cast<double>(test_vectors.size()) * ROUNDS;
+    std::cout << "compose_trs: " << transforms / std::max<long long>(scalar_duration.count(), 1)
+              << " M/s, compose_trs_batch (width " << Math::compose_trs_batch_width() << "): "
+              << transforms / std::max<long long>(batch_duration.count(), 1) << " M/s" << std::endl;
+
+    EXPECT_LT(batch_duration.count(), scalar_duration.count() + 1000);
+    EXPECT_FALSE(batch_results.back() == Math::Mat4(0.0f));
+}
+
 } // namespace Comet::Tests
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "render/scene_extractor.h"
+#include "scene/scene.h"
+#include "../test_utils.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+
+namespace Comet::Tests {
+
+TEST(ScenePerformanceTest, BulkEntityCreationIsNotQuadratic) {
+    constexpr std::size_t ENTITY_COUNT = 100000;
+    constexpr std::size_t CHUNK_SIZE = 10000;
+
+    Scene scene;
+    std::vector<double> chunk_times;
+    for(std::size_t created = 0; created < ENTITY_COUNT; created += CHUNK_SIZE) {
+        chunk_times.push_back(TestUtils::MeasureExecutionTime([&scene]() {
+            for(std::size_t index = 0; index < CHUNK_SIZE; ++index) {
+                static_cast<void>(scene.create_entity());
+            }
+        }));
+    }
+
+    double total = 0.0;
+    for(const double time: chunk_times) {
+        total += time;
+    }
+    std::cout << "Created " << ENTITY_COUNT << " entities in " << total
+              << " ms (first chunk " << chunk_times.front()
+              << " ms, last chunk " << chunk_times.back() << " ms)" << std::endl;
+
+    ASSERT_EQ(scene.entity_count(), ENTITY_COUNT);
+    // With a linear UUID scan the last chunk is ~19x slower than the first.
+    EXPECT_LT(chunk_times.back(), chunk_times.front() * 4.0 + 5.0);
+}
+
+TEST(ScenePerformanceTest, EntityLookupIsConstantTime) {
+    constexpr std::size_t ENTITY_COUNT = 100000;
+
+    Scene scene;
+    std::vector<EntityId> ids;
+    std::vector<EntityUuid> uuids;
+    ids.reserve(ENTITY_COUNT);
+    uuids.reserve(ENTITY_COUNT);
+    for(std::size_t index = 0; index < ENTITY_COUNT; ++index) {
+        const Entity entity = scene.create_entity();
+        ids.push_back(entity.get_id());
+        uuids.push_back(entity.get_uuid());
+    }
+
+    std::size_t found = 0;
+    const double elapsed = TestUtils::MeasureExecutionTime([&]() {
+        for(std::size_t index = 0; index < ENTITY_COUNT; ++index) {
+            found += static_cast<bool>(scene.find_entity(ids[index]));
+            found += static_cast<bool>(scene.find_entity(uuids[index]));
+        }
+    });
+    std::cout << "Resolved " << 2 * ENTITY_COUNT << " lookups in "
+              << elapsed << " ms" << std::endl;
+
+    EXPECT_EQ(found, 2 * ENTITY_COUNT);
+    EXPECT_LT(elapsed, 500.0);
+}
+
+TEST(ScenePerformanceTest, HierarchyQueriesScaleWithSubtreeSize) {
+    constexpr std::size_t ENTITY_COUNT = 100000;
+    constexpr std::size_t QUERY_COUNT = 10000;
+
+    Scene scene;
+    for(std::size_t index = 0; index < ENTITY_COUNT; ++index) {
+        static_cast<void>(scene.create_entity());
+    }
+    Entity parent = scene.create_entity("Parent");
+    Entity child = scene.create_entity("Child");
+    ASSERT_TRUE(scene.set_parent(child, parent));
+
+    std::size_t visited = 0;
+    const double query_time = TestUtils::MeasureExecutionTime([&]() {
+        for(std::size_t index = 0; index < QUERY_COUNT; ++index) {
+            visited += scene.get_children(parent).size();
+        }
+    });
+
+    std::vector<Entity> subtree_roots;
+    subtree_roots.reserve(QUERY_COUNT);
+    for(std::size_t index = 0; index < QUERY_COUNT; ++index) {
+        Entity subtree_root = scene.create_entity();
+        ASSERT_TRUE(scene.set_parent(scene.create_entity(), subtree_root));
+        subtree_roots.push_back(subtree_root);
+    }
+    const double destroy_time = TestUtils::MeasureExecutionTime([&]() {
+        for(const Entity subtree_root: subtree_roots) {
+            scene.destroy_entity(subtree_root);
+        }
+    });
+    std::cout << QUERY_COUNT << " child queries in " << query_time << " ms, "
+              << QUERY_COUNT << " subtree destructions in " << destroy_time
+              << " ms with " << ENTITY_COUNT << " unrelated entities" << std::endl;
+
+    EXPECT_EQ(visited, QUERY_COUNT);
+    EXPECT_EQ(scene.entity_count(), ENTITY_COUNT + 2);
+    // Scanning the scene per query would take seconds here.
+    EXPECT_LT(query_time, 200.0);
+    EXPECT_LT(destroy_time, 200.0);
+}
+
+TEST(ScenePerformanceTest, SteadyStateExtractionScalesWithChanges) {
+    constexpr std::size_t ENTITY_COUNT = 100000;
+
+    Scene scene;
+    std::vector<Entity> entities;
+    entities.reserve(ENTITY_COUNT);
+    for(std::size_t index = 0; index < ENTITY_COUNT; ++index) {
+        Entity entity = scene.create_entity();
+        entity.add_component<MeshRendererComponent>(AssetHandle(1), AssetHandle(2));
+        entities.push_back(entity);
+    }
+
+    SceneExtractor extractor(scene);
+    static_cast<void>(extractor.update());
+
+    const double full_time = TestUtils::MeasureExecutionTime([&scene]() {
+        static_cast<void>(SceneExtractor::extract(scene));
+    });
+    const double static_time = TestUtils::MeasureExecutionTime([&extractor]() {
+        for(int frame = 0; frame < 100; ++frame) {
+            EXPECT_TRUE(extractor.update().empty());
+        }
+    });
+    std::size_t modified = 0;
+    const double changed_time = TestUtils::MeasureExecutionTime([&]() {
+        for(std::size_t index = 0; index < 100; ++index) {
+            entities[index * 997].patch_component<TransformComponent>([](TransformComponent& transform) {
+                transform.translation.x += 1.0f;
+            });
+        }
+        modified = extractor.update().modified_items.size();
+    });
+    EXPECT_EQ(modified, 100u);
+    EXPECT_LT(static_time, full_time * 2.0 + 5.0);
+    EXPECT_LT(changed_time, full_time * 2.0 + 5.0);
+}
+
+TEST(ScenePerformanceTest, FullExtractionOf100kRenderables) {
+    constexpr std::size_t RENDERABLE_COUNT = 100000;
+    constexpr int ITERATIONS = 10;
+
+    // Interleave plain entities so renderables are not already contiguous.
+    Scene scene;
+    std::vector<Entity> entities = scene.create_entities(RENDERABLE_COUNT * 2);
+    for(std::size_t index = 0; index < entities.size(); index += 2) {
+        entities[index].add_component<MeshRendererComponent>(AssetHandle(index + 1), AssetHandle(1));
+    }
+    static_cast<void>(SceneExtractor::extract(scene));
+
+    std::size_t extracted = 0;
+    const double elapsed = TestUtils::MeasureExecutionTime([&]() {
+        for(int iteration = 0; iteration < ITERATIONS; ++iteration) {
+            extracted += SceneExtractor::extract(scene).render_items.size();
+        }
+    });
+    std::cout << "Extracted " << RENDERABLE_COUNT << " renderables in "
+              << elapsed / ITERATIONS << " ms" << std::endl;
+
+    EXPECT_EQ(extracted, RENDERABLE_COUNT * ITERATIONS);
+}
+
+TEST(ScenePerformanceTest, BatchCreationOutpacesPerEntityCreation) {
+    const std::size_t entity_count =
+        std::getenv("COMET_LARGE_BENCHMARKS") != nullptr ? 1000000 : 100000;
+
+    Scene looped_scene;
+    const double looped_time = TestUtils::MeasureExecutionTime([&]() {
+        for(std::size_t index = 0; index < entity_count; ++index) {
+            static_cast<void>(looped_scene.create_entity());
+        }
+    });
+
+    Scene batched_scene;
+    std::vector<Entity> entities;
+    const double batched_time = TestUtils::MeasureExecutionTime([&]() {
+        entities = batched_scene.create_entities(entity_count);
+    });
+    batched_scene.destroy_entities(entities);
+
+    ASSERT_EQ(entities.size(), entity_count);
+    EXPECT_EQ(batched_scene.entity_count(), 0u);
+    EXPECT_LT(batched_time, looped_time * 2.0 + 5.0);
+}
+
+} // namespace Comet::Tests
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "../../engine/src/core/mip_chain.h"
+#include "../../engine/src/core/texel_swizzle.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace Comet::Tests {
+
+namespace {
+    // 与 downsample_rgba8_box 结果一致的逐通道标量实现，作为吞吐对照
+    void downsample_scalar(const uint8_t* source, const uint32_t width, const uint32_t height, uint8_t* destination) {
+        const uint32_t target_width = std::max(1u, width / 2);
+        const uint32_t target_height = std::max(1u, height / 2);
+        for (uint32_t y = 0; y < target_height; ++y) {
+            for (uint32_t x = 0; x < target_width; ++x) {
+                for (uint32_t c = 0; c < 4; ++c) {
+                    const auto at = [&](const uint32_t sx, const uint32_t sy) -> uint32_t {
+                        return source[(std::min(sy, height - 1) * width + std::min(sx, width - 1)) * 4 + c];
+                    };
+                    const uint32_t sum = at(2 * x, 2 * y) + at(2 * x + 1, 2 * y)
+                        + at(2 * x, 2 * y + 1) + at(2 * x + 1, 2 * y + 1);
+                    destination[(y * target_width + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+    }
+}
+
+TEST(TexturePerformanceTest, MipChainGenerationThroughput) {
+    // 模拟纹理密集场景：16 张 1024x1024 RGBA8 贴图
+    constexpr uint32_t SIZE = 1024;
+    constexpr int TEXTURE_COUNT = 16;
+    std::vector<uint8_t> pixels(static_cast<std::size_t>(SIZE) * SIZE * 4);
+    for (std::size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<uint8_t>(i * 31);
+    }
+    std::vector<uint8_t> scalar_level(pixels.size() / 4);
+    std::vector<uint8_t> simd_level(pixels.size() / 4);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < TEXTURE_COUNT; ++i) {
+        downsample_scalar(pixels.data(), SIZE, SIZE, scalar_level.data());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const auto scalar_duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < TEXTURE_COUNT; ++i) {
+        downsample_rgba8_box(pixels.data(), SIZE, SIZE, simd_level.data());
+    }
+    end = std::chrono::high_resolution_clock::now();
+    const auto simd_duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    const uint32_t levels = compute_mip_level_count(SIZE, SIZE);
+    const auto chain = build_rgba8_mip_chain(pixels.data(), SIZE, SIZE, levels);
+
+    // 完整 mip 链只多占约 1/3 显存，而缩小采样时只读取接近屏幕尺寸的层级
+    const double megabytes = static_cast<double>(pixels.size()) * TEXTURE_COUNT / (1024.0 * 1024.0);
+    std::cout << "downsample scalar: " << megabytes * 1e6 / std::max<long long>(scalar_duration.count(), 1)
+              << " MB/s, box filter: " << megabytes * 1e6 / std::max<long long>(simd_duration.count(), 1)
+              << " MB/s, chain overhead: " << static_cast<double>(chain.size()) / pixels.size()
+              << "x" << std::endl;
+
+    EXPECT_EQ(simd_level, scalar_level);
+    EXPECT_LT(chain.size(), pixels.size() * 4 / 3 + 64);
+    EXPECT_LT(simd_duration.count(), scalar_duration.count() + 1000);
+}
+
+TEST(TexturePerformanceTest, RgbaToBgraSwizzleThroughput) {
+    // 解码线程把 stb_image 的 RGBA 输出转换为 BGRA 交换链格式
+    constexpr std::size_t TEXEL_COUNT = 2048 * 2048;
+    constexpr int ROUNDS = 8;
+    std::vector<uint8_t> pixels(TEXEL_COUNT * 4);
+    for (std::size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<uint8_t>(i * 17);
+    }
+    std::vector<uint8_t> scalar_result(pixels.size());
+    std::vector<uint8_t> simd_result(pixels.size());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (std::size_t texel = 0; texel < TEXEL_COUNT; ++texel) {
+            scalar_result[texel * 4 + 0] = pixels[texel * 4 + 2];
+            scalar_result[texel * 4 + 1] = pixels[texel * 4 + 1];
+            scalar_result[texel * 4 + 2] = pixels[texel * 4 + 0];
+            scalar_result[texel * 4 + 3] = pixels[texel * 4 + 3];
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const auto scalar_duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        swizzle_rgba8_to_bgra8(pixels.data(), simd_result.data(), TEXEL_COUNT);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    const auto simd_duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    const double megabytes = static_cast<double>(pixels.size()) * ROUNDS / (1024.0 * 1024.0);
+    std::cout << "swizzle scalar: " << megabytes * 1e6 / std::max<long long>(scalar_duration.count(), 1)
+              << " MB/s, simd: " << megabytes * 1e6 / std::max<long long>(simd_duration.count(), 1)
+              << " MB/s" << std::endl;
+
+    EXPECT_EQ(simd_result, scalar_result);
+}
+
+} // namespace Comet::Tests
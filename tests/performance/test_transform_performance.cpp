@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "scene/scene.h"
+#include "../test_utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace Comet::Tests {
+
+namespace {
+    // Builds binary trees whose depth cycles through 4..8 until the scene
+    // holds `entity_count` entities. Returns the tree roots.
+    std::vector<Entity> BuildForest(Scene& scene, const std::size_t entity_count) {
+        std::vector<Entity> roots;
+        std::vector<Entity> level;
+        std::vector<Entity> next_level;
+        std::size_t created = 0;
+        for(std::size_t tree = 0; created < entity_count; ++tree) {
+            const std::size_t depth = 4 + tree % 5;
+            Entity root = scene.create_entity();
+            root.patch_component<TransformComponent>([&](TransformComponent& transform) {
+                transform.translation = Math::Vec3(static_cast<float>(tree), 0.0f, 0.0f);
+            });
+            roots.push_back(root);
+            ++created;
+
+            level.assign(1, root);
+            for(std::size_t current_depth = 1;
+                current_depth < depth && created < entity_count; ++current_depth) {
+                next_level.clear();
+                for(const Entity parent: level) {
+                    for(int branch = 0; branch < 2 && created < entity_count; ++branch) {
+                        Entity child = scene.create_entity();
+                        child.patch_component<TransformComponent>(
+                            [&](TransformComponent& transform) {
+                                transform.translation = Math::Vec3(branch == 0 ? -1.0f : 1.0f, 1.0f, 0.0f);
+                                transform.rotation = Math::Vec3(0.0f, 15.0f, 0.0f);
+                            });
+                        static_cast<void>(scene.set_parent(child, parent));
+                        next_level.push_back(child);
+                        ++created;
+                    }
+                }
+                level.swap(next_level);
+            }
+        }
+        return roots;
+    }
+
+    // Reference implementation: recursive handle chasing, as the scene did
+    // before transforms were flattened.
+    void ComposeRecursive(Scene& scene, const Entity entity, const Math::Mat4& parent_world,
+                          std::vector<Math::Mat4>& output) {
+        const auto& transform = static_cast<const Entity&>(entity).get_component<TransformComponent>();
+        const Math::Mat4 world = parent_world * transform.to_matrix();
+        output.push_back(world);
+        for(const Entity child: scene.get_children(entity)) {
+            ComposeRecursive(scene, child, world, output);
+        }
+    }
+
+    void RunTransformBenchmark(const std::size_t entity_count) {
+        Scene scene;
+        const std::vector<Entity> roots = BuildForest(scene, entity_count);
+        scene.update_world_transforms();
+
+        std::vector<Math::Mat4> reference;
+        reference.reserve(entity_count);
+        const double recursive_time = TestUtils::MeasureExecutionTime([&]() {
+            for(const Entity root: roots) {
+                ComposeRecursive(scene, root, Math::Mat4(1.0f), reference);
+            }
+        });
+
+        // Touching every root makes the whole forest dirty.
+        const double flattened_time = TestUtils::MeasureExecutionTime([&]() {
+            for(Entity root: roots) {
+                root.patch_component<TransformComponent>([](TransformComponent& transform) {
+                    transform.translation.y += 1.0f;
+                });
+            }
+            scene.update_world_transforms();
+        });
+
+        std::cout << entity_count << " entities: recursive " << recursive_time
+                  << " ms, flattened " << flattened_time << " ms" << std::endl;
+
+        ASSERT_EQ(reference.size(), entity_count);
+        EXPECT_LT(flattened_time, recursive_time * 2.0 + 5.0);
+    }
+}
+
+TEST(TransformPerformanceTest, FlattenedUpdate10k) {
+    RunTransformBenchmark(10000);
+}
+
+TEST(TransformPerformanceTest, FlattenedUpdate100k) {
+    RunTransformBenchmark(100000);
+}
+
+TEST(TransformPerformanceTest, FlattenedUpdate1M) {
+    if(std::getenv("COMET_LARGE_BENCHMARKS") == nullptr) {
+        GTEST_SKIP() << "Set COMET_LARGE_BENCHMARKS to run the 1M entity benchmark";
+    }
+    RunTransformBenchmark(1000000);
+}
+
+TEST(TransformPerformanceTest, ParallelUpdateScaling) {
+    const std::size_t entity_count =
+        std::getenv("COMET_LARGE_BENCHMARKS") != nullptr ? 1000000 : 100000;
+    Scene scene;
+    const std::vector<Entity> roots = BuildForest(scene, entity_count);
+
+    for(const std::uint32_t thread_count: {1u, 2u, 4u, 8u, 16u}) {
+        scene.set_transform_thread_count(thread_count);
+        scene.update_world_transforms();
+
+        constexpr int FRAMES = 10;
+        const double elapsed = TestUtils::MeasureExecutionTime([&]() {
+            for(int frame = 0; frame < FRAMES; ++frame) {
+                for(Entity root: roots) {
+                    root.patch_component<TransformComponent>([](TransformComponent& transform) {
+                        transform.translation.y += 1.0f;
+                    });
+                }
+                scene.update_world_transforms();
+            }
+        });
+        std::cout << entity_count << " entities, " << thread_count << " threads: "
+                  << elapsed / FRAMES << " ms per update" << std::endl;
+    }
+}
+
+TEST(TransformPerformanceTest, PartialUpdateOnlyTouchesDirtySubtree) {
+    Scene scene;
+    const std::vector<Entity> roots = BuildForest(scene, 100000);
+    scene.update_world_transforms();
+
+    Entity moved = roots.front();
+    const double elapsed = TestUtils::MeasureExecutionTime([&]() {
+        for(int frame = 0; frame < 100; ++frame) {
+            moved.patch_component<TransformComponent>([](TransformComponent& transform) {
+                transform.translation.z += 1.0f;
+            });
+            scene.update_world_transforms();
+        }
+    });
+    std::cout << "100 single-subtree updates in " << elapsed << " ms" << std::endl;
+
+    EXPECT_LT(elapsed, 200.0);
+}
+
+} // namespace Comet::Tests
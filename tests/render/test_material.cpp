@@ -40,4 +40,70 @@ TEST(MaterialTest, StoresTextureProperty) {
     EXPECT_EQ(material.get_texture_property("missing"), nullptr);
 }
 
+TEST(MaterialTest, MutableConfigAccessBumpsVersion) {
+    Material material("versioned", MaterialConfig{});
+    const uint64_t initial_version = material.get_config_version();
+
+    static_cast<void>(material.get_config());
+    EXPECT_EQ(material.get_config_version(), initial_version);
+
+    material.get_config_mut().set_cull_mode(CullMode::None);
+    EXPECT_GT(material.get_config_version(), initial_version);
+}
+
+TEST(MaterialConfigTest, AppliesStateToPipelineConfig) {
+    MaterialConfig material_config;
+    material_config.set_cull_mode(CullMode::Front);
+    material_config.set_polygon_mode(PolygonMode::Line);
+    material_config.set_topology(Topology::LineList);
+    material_config.enable_depth_write(false);
+    material_config.set_depth_compare_op(CompareOp::LessEqual);
+    material_config.enable_alpha_blend();
+
+    PipelineConfig pipeline_config;
+    pipeline_config.rasterization_state.front_face = FrontFace::CW;
+    pipeline_config.set_multisample_state(SampleCount::Count4, false);
+    material_config.apply_to(pipeline_config);
+
+    EXPECT_EQ(pipeline_config.input_assembly_state.topology, Topology::LineList);
+    EXPECT_EQ(pipeline_config.rasterization_state.cull_mode, CullMode::Front);
+    EXPECT_EQ(pipeline_config.rasterization_state.polygon_mode, PolygonMode::Line);
+    EXPECT_TRUE(pipeline_config.depth_stencil_state.depth_test_enable);
+    EXPECT_FALSE(pipeline_config.depth_stencil_state.depth_write_enable);
+    EXPECT_EQ(pipeline_config.depth_stencil_state.depth_compare_op, CompareOp::LessEqual);
+    EXPECT_TRUE(pipeline_config.color_blend_state.blendEnable);
+    EXPECT_EQ(pipeline_config.color_blend_state.srcColorBlendFactor, vk::BlendFactor::eSrcAlpha);
+    EXPECT_EQ(pipeline_config.color_blend_state.dstColorBlendFactor, vk::BlendFactor::eOneMinusSrcAlpha);
+
+    // State the material does not describe is kept.
+    EXPECT_EQ(pipeline_config.rasterization_state.front_face, FrontFace::CW);
+    EXPECT_EQ(pipeline_config.multisample_state.rasterization_samples, SampleCount::Count4);
+}
+
+TEST(MaterialConfigTest, StateHashMatchesForIdenticalState) {
+    MaterialConfig first;
+    first.set_cull_mode(CullMode::None);
+    first.enable_alpha_blend();
+    MaterialConfig second;
+    second.enable_alpha_blend();
+    second.set_cull_mode(CullMode::None);
+
+    EXPECT_EQ(first.get_state_hash(), second.get_state_hash());
+
+    second.set_depth_compare_op(CompareOp::LessEqual);
+    EXPECT_NE(first.get_state_hash(), second.get_state_hash());
+}
+
+TEST(MaterialConfigTest, StateHashIgnoresBlendFactorsWhileBlendingIsDisabled) {
+    MaterialConfig opaque;
+    MaterialConfig additive;
+    additive.set_blend_factors(BlendFactor::One, BlendFactor::One);
+
+    EXPECT_EQ(opaque.get_state_hash(), additive.get_state_hash());
+
+    opaque.enable_alpha_blend();
+    additive.enable_alpha_blend();
+    EXPECT_NE(opaque.get_state_hash(), additive.get_state_hash());
+}
+
 } // namespace Comet::Tests
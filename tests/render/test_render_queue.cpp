@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+
+#include "render/render_queue.h"
+#include "../test_utils.h"
+
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace Comet::Tests {
+    namespace {
+        // The queue only compares mesh identity, so non-owning pointers
+        // into a local array stand in for uploaded meshes.
+        std::shared_ptr<Mesh> FakeMesh(std::array<std::byte, 4>& storage, const std::size_t index) {
+            return {std::shared_ptr<Mesh>{}, reinterpret_cast<Mesh*>(&storage[index])};
+        }
+
+        // The camera sits at the origin looking down -Z, so an item at
+        // distance d is placed at z = -d.
+        ResolvedRenderItem MakeItem(const std::shared_ptr<Mesh>& mesh,
+                                    const AssetHandle material_handle,
+                                    const float distance,
+                                    const bool alpha_blend = false) {
+            return {
+                .entity_id = 1,
+                .model_matrix = Math::translate(Math::Mat4(1.0f), Math::Vec3(0.0f, 0.0f, -distance)),
+                .mesh = mesh,
+                .material = {.material_handle = material_handle, .alpha_blend = alpha_blend}
+            };
+        }
+
+        float DistanceOf(const Math::Mat4& model_matrix) {
+            return -model_matrix[3].z;
+        }
+
+        const Math::Mat4 IDENTITY_VIEW = Math::Mat4(1.0f);
+    }
+
+    TEST(RenderQueueTest, EmptySubmissionProducesNoDraws) {
+        RenderQueue queue;
+
+        queue.build({}, IDENTITY_VIEW);
+
+        EXPECT_TRUE(queue.get_draws().empty());
+        EXPECT_TRUE(queue.get_instance_matrices().empty());
+    }
+
+    TEST(RenderQueueTest, DepthQuantisationIsMonotonic) {
+        EXPECT_EQ(RenderQueue::quantize_depth(-1.0f), 0u);
+        EXPECT_EQ(RenderQueue::quantize_depth(0.0f), 0u);
+
+        std::uint32_t previous = 0;
+        for(float depth = 0.01f; depth < 10000.0f; depth *= 1.5f) {
+            const std::uint32_t quantized = RenderQueue::quantize_depth(depth);
+            EXPECT_GT(quantized, previous);
+            EXPECT_LT(quantized, 1u << RenderQueue::DEPTH_BITS);
+            previous = quantized;
+        }
+    }
+
+    TEST(RenderQueueTest, BlendedKeysSortAfterOpaqueKeys) {
+        const std::uint64_t far_opaque = RenderQueue::make_opaque_key(0x7f, 0xffff, 0xffff, 0xffffff);
+        const std::uint64_t near_blended = RenderQueue::make_blended_key(0, 0, 0, 0);
+        const std::uint64_t far_blended = RenderQueue::make_blended_key(0, 0, 0, 1000);
+
+        EXPECT_LT(far_opaque, near_blended);
+        EXPECT_LT(far_blended, near_blended);
+    }
+
+    TEST(RenderQueueTest, GroupsItemsByMeshAndMaterial) {
+        std::array<std::byte, 4> storage{};
+        const auto crate = FakeMesh(storage, 0);
+        const auto barrel = FakeMesh(storage, 1);
+        const std::vector<ResolvedRenderItem> items = {
+            MakeItem(crate, AssetHandle(1), 1.0f),
+            MakeItem(barrel, AssetHandle(1), 2.0f),
+            MakeItem(crate, AssetHandle(1), 3.0f),
+            MakeItem(crate, AssetHandle(2), 4.0f),
+            MakeItem(crate, AssetHandle(1), 5.0f)
+        };
+
+        RenderQueue queue;
+        queue.build(items, IDENTITY_VIEW);
+
+        const auto& draws = queue.get_draws();
+        ASSERT_EQ(draws.size(), 3u);
+        EXPECT_EQ(draws[0].first_item->mesh, crate);
+        EXPECT_EQ(draws[0].first_item->material.material_handle, AssetHandle(1));
+        EXPECT_EQ(draws[0].first_instance, 0u);
+        EXPECT_EQ(draws[0].instance_count, 3u);
+        EXPECT_EQ(draws[1].first_item, &items[1]);
+        EXPECT_EQ(draws[1].first_instance, 3u);
+        EXPECT_EQ(draws[1].instance_count, 1u);
+        EXPECT_EQ(draws[2].first_item, &items[3]);
+        EXPECT_EQ(draws[2].first_instance, 4u);
+        EXPECT_EQ(draws[2].instance_count, 1u);
+
+        // Within the first draw instances run front to back.
+        const auto& matrices = queue.get_instance_matrices();
+        ASSERT_EQ(matrices.size(), items.size());
+        EXPECT_TRUE(TestUtils::Mat4Equal(matrices[0], items[0].model_matrix));
+        EXPECT_TRUE(TestUtils::Mat4Equal(matrices[1], items[2].model_matrix));
+        EXPECT_TRUE(TestUtils::Mat4Equal(matrices[2], items[4].model_matrix));
+    }
+
+    TEST(RenderQueueTest, MaterialsSharingPipelineStateSortTogether) {
+        std::array<std::byte, 4> storage{};
+        const auto crate = FakeMesh(storage, 0);
+        // Materials 1 and 3 share a pipeline; material 2, seen in between,
+        // uses another.
+        const std::vector<ResolvedRenderItem> items = {
+            MakeItem(crate, AssetHandle(1), 1.0f),
+            MakeItem(crate, AssetHandle(2), 2.0f),
+            MakeItem(crate, AssetHandle(3), 3.0f)
+        };
+        const auto pipeline_key = [](const MaterialBinding& material) -> std::uint64_t {
+            return material.material_handle == AssetHandle(2) ? 0xbeef : 0xcafe;
+        };
+
+        RenderQueue queue;
+        queue.build(items, IDENTITY_VIEW, pipeline_key);
+
+        const auto& draws = queue.get_draws();
+        ASSERT_EQ(draws.size(), 3u);
+        EXPECT_EQ(draws[0].first_item, &items[0]);
+        EXPECT_EQ(draws[1].first_item, &items[2]);
+        EXPECT_EQ(draws[2].first_item, &items[1]);
+
+        // Without pipeline keys materials keep their first-seen order.
+        queue.build(items, IDENTITY_VIEW);
+        ASSERT_EQ(queue.get_draws().size(), 3u);
+        EXPECT_EQ(queue.get_draws()[1].first_item, &items[1]);
+    }
+
+    TEST(RenderQueueTest, BlendedItemsFollowOpaqueBackToFront) {
+        std::array<std::byte, 4> storage{};
+        const auto crate = FakeMesh(storage, 0);
+        const auto glass = FakeMesh(storage, 1);
+        const std::vector<ResolvedRenderItem> items = {
+            MakeItem(glass, AssetHandle(3), 2.0f, true),
+            MakeItem(crate, AssetHandle(1), 9.0f),
+            MakeItem(glass, AssetHandle(3), 8.0f, true),
+            MakeItem(crate, AssetHandle(1), 1.0f),
+            MakeItem(glass, AssetHandle(3), 5.0f, true)
+        };
+
+        RenderQueue queue;
+        queue.build(items, IDENTITY_VIEW);
+
+        const auto& draws = queue.get_draws();
+        ASSERT_EQ(draws.size(), 2u);
+        EXPECT_FALSE(draws[0].alpha_blend);
+        EXPECT_EQ(draws[0].instance_count, 2u);
+        EXPECT_TRUE(draws[1].alpha_blend);
+        EXPECT_EQ(draws[1].first_instance, 2u);
+        EXPECT_EQ(draws[1].instance_count, 3u);
+
+        const auto& matrices = queue.get_instance_matrices();
+        ASSERT_EQ(matrices.size(), items.size());
+        EXPECT_FLOAT_EQ(DistanceOf(matrices[0]), 1.0f);
+        EXPECT_FLOAT_EQ(DistanceOf(matrices[1]), 9.0f);
+        EXPECT_FLOAT_EQ(DistanceOf(matrices[2]), 8.0f);
+        EXPECT_FLOAT_EQ(DistanceOf(matrices[3]), 5.0f);
+        EXPECT_FLOAT_EQ(DistanceOf(matrices[4]), 2.0f);
+    }
+
+    TEST(RenderQueueTest, DepthOrderFollowsTheViewMatrix) {
+        std::array<std::byte, 4> storage{};
+        const auto crate = FakeMesh(storage, 0);
+        const std::vector<ResolvedRenderItem> items = {
+            MakeItem(crate, AssetHandle(1), 1.0f),
+            MakeItem(crate, AssetHandle(1), 4.0f)
+        };
+        // Looking down +Z from z = -10 puts the second item nearest.
+        const Math::Mat4 view = Math::look_at(
+            Math::Vec3(0.0f, 0.0f, -10.0f), Math::Vec3(0.0f), Math::Vec3(0.0f, 1.0f, 0.0f));
+
+        RenderQueue queue;
+        queue.build(items, view);
+
+        const auto& matrices = queue.get_instance_matrices();
+        ASSERT_EQ(matrices.size(), 2u);
+        EXPECT_TRUE(TestUtils::Mat4Equal(matrices[0], items[1].model_matrix));
+        EXPECT_TRUE(TestUtils::Mat4Equal(matrices[1], items[0].model_matrix));
+    }
+
+    TEST(RenderQueueTest, RandomDepthsSortIntoMonotonicOrder) {
+        std::array<std::byte, 4> storage{};
+        const auto crate = FakeMesh(storage, 0);
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<float> distance(0.1f, 500.0f);
+        std::vector<ResolvedRenderItem> items;
+        for(int index = 0; index < 20000; ++index) {
+            items.push_back(MakeItem(crate, AssetHandle(1), distance(generator), index % 4 == 0));
+        }
+
+        RenderQueue queue;
+        queue.build(items, IDENTITY_VIEW);
+        queue.build(items, IDENTITY_VIEW);
+
+        const auto& draws = queue.get_draws();
+        ASSERT_EQ(draws.size(), 2u);
+        const auto& matrices = queue.get_instance_matrices();
+        ASSERT_EQ(matrices.size(), items.size());
+        const std::uint32_t blended_start = draws[1].first_instance;
+        EXPECT_EQ(blended_start, 15000u);
+        for(std::uint32_t index = 1; index < blended_start; ++index) {
+            ASSERT_LE(RenderQueue::quantize_depth(DistanceOf(matrices[index - 1])),
+                      RenderQueue::quantize_depth(DistanceOf(matrices[index])));
+        }
+        for(std::size_t index = blended_start + 1; index < matrices.size(); ++index) {
+            ASSERT_GE(RenderQueue::quantize_depth(DistanceOf(matrices[index - 1])),
+                      RenderQueue::quantize_depth(DistanceOf(matrices[index])));
+        }
+    }
+}
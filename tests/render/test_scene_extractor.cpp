@@ -5,6 +5,8 @@
 #include "../test_utils.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <vector>
 
 namespace Comet::Tests {
     TEST(SceneExtractorTest, EmptySceneProducesNoRenderItems) {
@@ -19,16 +21,20 @@ namespace Comet::Tests {
         Scene scene;
 
         Entity first = scene.create_entity("First");
-        auto& first_transform = first.get_component<TransformComponent>();
-        first_transform.translation = Math::Vec3(1.0f, 2.0f, 3.0f);
-        first_transform.rotation = Math::Vec3(10.0f, 20.0f, 30.0f);
-        first_transform.scale = Math::Vec3(2.0f, 2.0f, 2.0f);
+        const auto& first_transform = first.patch_component<TransformComponent>(
+            [](TransformComponent& transform) {
+                transform.translation = Math::Vec3(1.0f, 2.0f, 3.0f);
+                transform.rotation = Math::Vec3(10.0f, 20.0f, 30.0f);
+                transform.scale = Math::Vec3(2.0f, 2.0f, 2.0f);
+            });
         first.add_component<MeshRendererComponent>(AssetHandle(10), AssetHandle(20));
 
         Entity second = scene.create_entity("Second");
-        auto& second_transform = second.get_component<TransformComponent>();
-        second_transform.translation = Math::Vec3(-4.0f, 5.0f, 6.0f);
-        second_transform.rotation = Math::Vec3(0.0f, 90.0f, 0.0f);
+        const auto& second_transform = second.patch_component<TransformComponent>(
+            [](TransformComponent& transform) {
+                transform.translation = Math::Vec3(-4.0f, 5.0f, 6.0f);
+                transform.rotation = Math::Vec3(0.0f, 90.0f, 0.0f);
+            });
         second.add_component<MeshRendererComponent>(AssetHandle(30), AssetHandle(40));
 
         scene.create_entity("No MeshRenderer");
@@ -69,12 +75,14 @@ namespace Comet::Tests {
     TEST(SceneExtractorTest, ExtractsWorldMatrixForChildEntity) {
         Scene scene;
         Entity parent = scene.create_entity("Parent");
-        parent.get_component<TransformComponent>().translation =
-            Math::Vec3(2.0f, 0.0f, 0.0f);
+        parent.patch_component<TransformComponent>([](TransformComponent& transform) {
+            transform.translation = Math::Vec3(2.0f, 0.0f, 0.0f);
+        });
 
         Entity child = scene.create_entity("Child");
-        child.get_component<TransformComponent>().translation =
-            Math::Vec3(0.0f, 3.0f, 0.0f);
+        child.patch_component<TransformComponent>([](TransformComponent& transform) {
+            transform.translation = Math::Vec3(0.0f, 3.0f, 0.0f);
+        });
         child.add_component<MeshRendererComponent>(AssetHandle(10), AssetHandle(20));
         ASSERT_TRUE(scene.set_parent(child, parent));
 
@@ -92,10 +100,12 @@ namespace Comet::Tests {
     TEST(SceneExtractorTest, ExtractsCameraViewWithoutTransformScale) {
         Scene scene;
         Entity camera_entity = scene.create_entity("Main Camera");
-        auto& transform = camera_entity.get_component<TransformComponent>();
-        transform.translation = Math::Vec3(1.0f, 2.0f, 3.0f);
-        transform.rotation = Math::Vec3(10.0f, 20.0f, 30.0f);
-        transform.scale = Math::Vec3(2.0f, 3.0f, 4.0f);
+        const auto& camera_transform = camera_entity.patch_component<TransformComponent>(
+            [](TransformComponent& transform) {
+                transform.translation = Math::Vec3(1.0f, 2.0f, 3.0f);
+                transform.rotation = Math::Vec3(10.0f, 20.0f, 30.0f);
+                transform.scale = Math::Vec3(2.0f, 3.0f, 4.0f);
+            });
         auto& camera = camera_entity.add_component<CameraComponent>();
         camera.primary = true;
         camera.fov = 60.0f;
@@ -107,13 +117,14 @@ namespace Comet::Tests {
         missing_transform.remove_component<TransformComponent>();
 
         Entity camera_parent = scene.create_entity("Camera Parent");
-        auto& parent_transform =
-            camera_parent.get_component<TransformComponent>();
-        parent_transform.translation = Math::Vec3(5.0f, 0.0f, 0.0f);
-        parent_transform.rotation = Math::Vec3(0.0f, 15.0f, 0.0f);
+        const auto& parent_transform = camera_parent.patch_component<TransformComponent>(
+            [](TransformComponent& transform) {
+                transform.translation = Math::Vec3(5.0f, 0.0f, 0.0f);
+                transform.rotation = Math::Vec3(0.0f, 15.0f, 0.0f);
+            });
         ASSERT_TRUE(scene.set_parent(camera_entity, camera_parent));
 
-        TransformComponent camera_pose = transform;
+        TransformComponent camera_pose = camera_transform;
         camera_pose.scale = Math::Vec3(1.0f);
         const Math::Mat4 expected_view = Math::inverse(
             parent_transform.to_matrix() * camera_pose.to_matrix());
@@ -129,4 +140,121 @@ namespace Comet::Tests {
         EXPECT_FLOAT_EQ(extracted.near_clip, 0.2f);
         EXPECT_FLOAT_EQ(extracted.far_clip, 500.0f);
     }
+
+    namespace {
+        std::vector<RenderItem> LiveItems(const RenderScene& render_scene) {
+            std::vector<RenderItem> items;
+            for(const RenderItem& item: render_scene.render_items) {
+                if(item.entity_id != INVALID_ENTITY_ID) {
+                    items.push_back(item);
+                }
+            }
+            std::sort(items.begin(), items.end(), [](const RenderItem& a, const RenderItem& b) {
+                return a.entity_id < b.entity_id;
+            });
+            return items;
+        }
+
+        void ExpectSameItems(const RenderScene& incremental, const RenderScene& full) {
+            const std::vector<RenderItem> incremental_items = LiveItems(incremental);
+            const std::vector<RenderItem> full_items = LiveItems(full);
+            ASSERT_EQ(incremental_items.size(), full_items.size());
+            for(std::size_t index = 0; index < full_items.size(); ++index) {
+                EXPECT_EQ(incremental_items[index].entity_id, full_items[index].entity_id);
+                EXPECT_EQ(incremental_items[index].mesh_handle, full_items[index].mesh_handle);
+                EXPECT_EQ(incremental_items[index].material_handle, full_items[index].material_handle);
+                EXPECT_EQ(incremental_items[index].model_matrix, full_items[index].model_matrix);
+            }
+        }
+    }
+
+    TEST(SceneExtractorTest, IncrementalExtractionMatchesFullExtraction) {
+        Scene scene;
+        Entity parent = scene.create_entity("Parent");
+        parent.add_component<MeshRendererComponent>(AssetHandle(1), AssetHandle(2));
+        Entity child = scene.create_entity("Child");
+        child.add_component<MeshRendererComponent>(AssetHandle(3), AssetHandle(4));
+        child.patch_component<TransformComponent>([](TransformComponent& transform) {
+            transform.translation = Math::Vec3(0.0f, 1.0f, 0.0f);
+        });
+        ASSERT_TRUE(scene.set_parent(child, parent));
+        scene.create_entity("Empty");
+
+        SceneExtractor extractor(scene);
+        const RenderSceneChanges& initial = extractor.update();
+        EXPECT_EQ(initial.added_items.size(), 2u);
+        ExpectSameItems(extractor.get_render_scene(), SceneExtractor::extract(scene));
+
+        parent.patch_component<TransformComponent>([](TransformComponent& transform) {
+            transform.translation = Math::Vec3(3.0f, 0.0f, 0.0f);
+        });
+        Entity late = scene.create_entity("Late");
+        late.add_component<MeshRendererComponent>(AssetHandle(5), AssetHandle(6));
+        static_cast<void>(extractor.update());
+        ExpectSameItems(extractor.get_render_scene(), SceneExtractor::extract(scene));
+
+        scene.destroy_entity(parent);
+        static_cast<void>(extractor.update());
+        ExpectSameItems(extractor.get_render_scene(), SceneExtractor::extract(scene));
+
+        static_cast<void>(extractor.rebuild());
+        ExpectSameItems(extractor.get_render_scene(), SceneExtractor::extract(scene));
+    }
+
+    TEST(SceneExtractorTest, IncrementalExtractionReportsOnlyChangedSlots) {
+        Scene scene;
+        Entity moving = scene.create_entity("Moving");
+        moving.add_component<MeshRendererComponent>(AssetHandle(1), AssetHandle(2));
+        Entity still = scene.create_entity("Still");
+        still.add_component<MeshRendererComponent>(AssetHandle(3), AssetHandle(4));
+
+        SceneExtractor extractor(scene);
+        static_cast<void>(extractor.update());
+        EXPECT_TRUE(extractor.update().empty());
+
+        moving.patch_component<TransformComponent>([](TransformComponent& transform) {
+            transform.translation = Math::Vec3(1.0f, 0.0f, 0.0f);
+        });
+        const RenderSceneChanges& moved = extractor.update();
+        ASSERT_EQ(moved.modified_items.size(), 1u);
+        EXPECT_TRUE(moved.added_items.empty());
+        EXPECT_TRUE(moved.removed_items.empty());
+        const std::uint32_t moving_slot = moved.modified_items.front();
+        EXPECT_EQ(extractor.get_render_scene().render_items[moving_slot].entity_id, moving.get_id());
+
+        moving.remove_component<MeshRendererComponent>();
+        const RenderSceneChanges& removed = extractor.update();
+        EXPECT_EQ(removed.removed_items, std::vector<std::uint32_t>{moving_slot});
+        EXPECT_EQ(extractor.get_render_scene().render_items[moving_slot].entity_id,
+                  INVALID_ENTITY_ID);
+
+        // Freed slots are reused, and untouched entities keep theirs.
+        Entity added = scene.create_entity("Added");
+        added.add_component<MeshRendererComponent>(AssetHandle(5), AssetHandle(6));
+        const RenderSceneChanges& readded = extractor.update();
+        EXPECT_EQ(readded.added_items, std::vector<std::uint32_t>{moving_slot});
+        EXPECT_EQ(extractor.get_render_scene().render_items.size(), 2u);
+    }
+
+    TEST(SceneExtractorTest, IncrementalExtractionTracksCameraChanges) {
+        Scene scene;
+        Entity camera_entity = scene.create_entity("Camera");
+        camera_entity.add_component<CameraComponent>().primary = true;
+
+        SceneExtractor extractor(scene);
+        EXPECT_TRUE(extractor.update().cameras_changed);
+        EXPECT_FALSE(extractor.update().cameras_changed);
+
+        camera_entity.patch_component<CameraComponent>([](CameraComponent& camera) {
+            camera.fov = 70.0f;
+        });
+        EXPECT_TRUE(extractor.update().cameras_changed);
+        ASSERT_EQ(extractor.get_render_scene().cameras.size(), 1u);
+        EXPECT_FLOAT_EQ(extractor.get_render_scene().cameras.front().fov_degrees, 70.0f);
+
+        scene.destroy_entity(camera_entity);
+        EXPECT_TRUE(extractor.update().cameras_changed);
+        EXPECT_EQ(extractor.get_render_scene().cameras.front().entity_id, INVALID_ENTITY_ID);
+        EXPECT_FALSE(extractor.get_render_scene().cameras.front().primary);
+    }
 }
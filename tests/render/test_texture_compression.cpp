@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include "render/texture_compression.h"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Comet::Tests {
+    namespace {
+        // Smooth gradients with a little noise, roughly what albedo and
+        // normal maps look like inside a 4x4 block.
+        std::vector<uint8_t> make_gradient(const uint32_t width, const uint32_t height) {
+            std::vector<uint8_t> pixels(static_cast<std::size_t>(width) * height * 4);
+            for(uint32_t y = 0; y < height; ++y) {
+                for(uint32_t x = 0; x < width; ++x) {
+                    uint8_t* texel = pixels.data() + (static_cast<std::size_t>(y) * width + x) * 4;
+                    texel[0] = static_cast<uint8_t>(x * 255 / std::max(1u, width - 1));
+                    texel[1] = static_cast<uint8_t>(y * 255 / std::max(1u, height - 1));
+                    texel[2] = static_cast<uint8_t>((x + y) * 4 + ((x * 7 + y * 3) & 3));
+                    texel[3] = static_cast<uint8_t>(255 - x * 2);
+                }
+            }
+            return pixels;
+        }
+
+        double root_mean_square_error(const uint8_t* a, const uint8_t* b, const std::size_t texels,
+                                      const int channels) {
+            double sum = 0.0;
+            for(std::size_t texel = 0; texel < texels; ++texel) {
+                for(int channel = 0; channel < channels; ++channel) {
+                    const double delta = static_cast<double>(a[texel * 4 + channel]) - b[texel * 4 + channel];
+                    sum += delta * delta;
+                }
+            }
+            return std::sqrt(sum / static_cast<double>(texels * channels));
+        }
+    }
+
+    TEST(TextureCompressionTest, SolidBlocksRoundTripClosely) {
+        std::array<uint8_t, 64> block_texels{};
+        for(std::size_t texel = 0; texel < 16; ++texel) {
+            block_texels[texel * 4 + 0] = 200;
+            block_texels[texel * 4 + 1] = 100;
+            block_texels[texel * 4 + 2] = 50;
+            block_texels[texel * 4 + 3] = 128;
+        }
+
+        for(const auto compression : {TextureCompression::BC1, TextureCompression::BC3,
+                                      TextureCompression::BC5, TextureCompression::BC7}) {
+            std::array<uint8_t, 16> block{};
+            std::array<uint8_t, 64> decoded{};
+            encode_block(compression, block_texels.data(), block.data());
+            ASSERT_TRUE(decode_block(compression, block.data(), decoded.data()));
+            const int channels = compression == TextureCompression::BC5 ? 2 : 3;
+            EXPECT_LE(root_mean_square_error(block_texels.data(), decoded.data(), 16, channels), 4.0)
+                << "compression " << static_cast<int>(compression);
+        }
+    }
+
+    TEST(TextureCompressionTest, EncodesBC7Mode6WithAnchorInLowerHalf) {
+        const auto pixels = make_gradient(4, 4);
+        std::array<uint8_t, 16> block{};
+        encode_block(TextureCompression::BC7, pixels.data(), block.data());
+
+        EXPECT_EQ(block[0] & 0x7F, 0x40);
+        // The anchor index occupies bits 65..67.
+        const uint32_t anchor = (block[8] >> 1) & 0x7;
+        EXPECT_LT(anchor, 8u);
+    }
+
+    TEST(TextureCompressionTest, GradientErrorStaysWithinFormatBounds) {
+        constexpr uint32_t width = 64;
+        constexpr uint32_t height = 32;
+        const auto pixels = make_gradient(width, height);
+
+        struct Case {
+            TextureCompression compression;
+            int channels;
+            double max_error;
+        };
+        for(const auto& [compression, channels, max_error] : {
+                Case{TextureCompression::BC1, 3, 6.0},
+                Case{TextureCompression::BC3, 4, 6.0},
+                Case{TextureCompression::BC5, 2, 2.0},
+                Case{TextureCompression::BC7, 4, 5.0}}) {
+            const auto texture = compress_texture(pixels.data(), width, height, compression, false, false);
+            ASSERT_EQ(texture.mip_levels, 1u);
+            ASSERT_EQ(texture.data.size(), (width / 4) * (height / 4) * compressed_block_size(compression));
+
+            const auto decoded = decompress_texture(texture);
+            ASSERT_EQ(decoded.size(), pixels.size());
+            EXPECT_LE(root_mean_square_error(pixels.data(), decoded.data(), width * height, channels), max_error)
+                << "compression " << static_cast<int>(compression);
+        }
+    }
+
+    TEST(TextureCompressionTest, CompressesFullMipChainWithPartialBlocks) {
+        const auto pixels = make_gradient(10, 6);
+        const auto texture = compress_texture(pixels.data(), 10, 6, TextureCompression::BC7, true, true);
+
+        ASSERT_EQ(texture.mip_levels, 4u);
+        const auto levels = texture.describe_levels();
+        ASSERT_EQ(levels.size(), 4u);
+        // 10x6 -> 3x2 blocks, 5x3 -> 2x1, 2x1 and 1x1 -> one block each.
+        EXPECT_EQ(levels[0].size, 6u * 16);
+        EXPECT_EQ(levels[1].size, 2u * 16);
+        EXPECT_EQ(levels[2].size, 16u);
+        EXPECT_EQ(levels[3].size, 16u);
+        EXPECT_EQ(texture.data.size(), levels[3].offset + levels[3].size);
+
+        const auto decoded = decompress_texture(texture);
+        const auto rgba_levels = describe_mip_chain(10, 6, 4, 4);
+        EXPECT_EQ(decoded.size(), rgba_levels[3].offset + rgba_levels[3].size);
+    }
+
+    TEST(TextureCompressionTest, SavesAndLoadsCookedTextures) {
+        const auto pixels = make_gradient(16, 16);
+        const auto texture = compress_texture(pixels.data(), 16, 16, TextureCompression::BC3, true, true);
+        const std::string path =
+            (std::filesystem::temp_directory_path() / "comet_test_texture.ctex").string();
+
+        ASSERT_TRUE(save_compressed_texture(path, texture));
+        CompressedTexture loaded;
+        ASSERT_TRUE(load_compressed_texture(path, loaded));
+        std::remove(path.c_str());
+
+        EXPECT_EQ(loaded.compression, TextureCompression::BC3);
+        EXPECT_TRUE(loaded.srgb);
+        EXPECT_EQ(loaded.width, 16u);
+        EXPECT_EQ(loaded.height, 16u);
+        EXPECT_EQ(loaded.mip_levels, texture.mip_levels);
+        EXPECT_EQ(loaded.data, texture.data);
+    }
+}
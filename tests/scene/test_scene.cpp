@@ -3,6 +3,8 @@
 #include "scene/scene.h"
 #include "../test_utils.h"
 #include <algorithm>
+#include <cstring>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -105,6 +107,73 @@ TEST(SceneTest, DestroyEntityInvalidatesHandle) {
     EXPECT_EQ(scene.entity_count(), 0u);
 }
 
+TEST(SceneTest, CreateEntitiesAssignsContiguousIdsAndNames) {
+    Scene scene;
+    static_cast<void>(scene.create_entity("Existing"));
+    const std::vector<std::string> names = {"First", "", "Third"};
+
+    const std::vector<Entity> entities = scene.create_entities(4, names);
+
+    ASSERT_EQ(entities.size(), 4u);
+    EXPECT_EQ(scene.entity_count(), 5u);
+    for(std::size_t index = 0; index < entities.size(); ++index) {
+        const Entity& entity = entities[index];
+        ASSERT_TRUE(entity);
+        EXPECT_EQ(entity.get_id(), entities.front().get_id() + index);
+        EXPECT_TRUE(entity.has_component<TransformComponent>());
+        EXPECT_TRUE(entity.has_component<RelationshipComponent>());
+        EXPECT_TRUE(entity.has_component<WorldTransformComponent>());
+        EXPECT_EQ(scene.find_entity(entity.get_id()), entity);
+        EXPECT_EQ(scene.find_entity(entity.get_uuid()), entity);
+    }
+    EXPECT_EQ(entities[0].get_component<NameComponent>().name, "First");
+    EXPECT_EQ(entities[1].get_component<NameComponent>().name, "Entity");
+    EXPECT_EQ(entities[2].get_component<NameComponent>().name, "Third");
+    EXPECT_EQ(entities[3].get_component<NameComponent>().name, "Entity");
+    EXPECT_EQ(scene.get_root_entities().size(), 5u);
+}
+
+TEST(SceneTest, CreateEntitiesWithUuidsRejectsInvalidOrDuplicateUuids) {
+    Scene scene;
+    const EntityUuid existing = scene.create_entity().get_uuid();
+    const EntityUuid fresh = EntityUuid::generate();
+
+    std::size_t failed_index = 0;
+    EXPECT_TRUE(scene.create_entities_with_uuids(std::vector{existing, fresh}, {}, &failed_index).empty());
+    EXPECT_EQ(failed_index, 0u);
+    EXPECT_TRUE(scene.create_entities_with_uuids(std::vector{fresh, fresh}, {}, &failed_index).empty());
+    EXPECT_EQ(failed_index, 1u);
+    EXPECT_TRUE(scene.create_entities_with_uuids(std::vector{fresh, EntityUuid{}}, {}, &failed_index).empty());
+    EXPECT_EQ(failed_index, 1u);
+    EXPECT_EQ(scene.entity_count(), 1u);
+
+    const std::vector<std::string> names = {""};
+    const std::vector<Entity> created =
+        scene.create_entities_with_uuids(std::vector{fresh, EntityUuid::generate()}, names);
+    ASSERT_EQ(created.size(), 2u);
+    EXPECT_EQ(created.front().get_uuid(), fresh);
+    // Empty names are kept; only missing ones fall back to "Entity".
+    EXPECT_EQ(created[0].get_component<NameComponent>().name, "");
+    EXPECT_EQ(created[1].get_component<NameComponent>().name, "Entity");
+}
+
+TEST(SceneTest, DestroyEntitiesRemovesSubtreesAndIgnoresDuplicates) {
+    Scene scene;
+    std::vector<Entity> entities = scene.create_entities(5);
+    ASSERT_TRUE(scene.set_parent(entities[1], entities[0]));
+    ASSERT_TRUE(scene.set_parent(entities[2], entities[1]));
+    ASSERT_TRUE(scene.set_parent(entities[4], entities[3]));
+
+    const std::vector<Entity> doomed = {entities[2], entities[0], entities[2], entities[4], Entity{}};
+    scene.destroy_entities(doomed);
+
+    EXPECT_EQ(scene.entity_count(), 1u);
+    EXPECT_TRUE(scene.is_valid(entities[3]));
+    EXPECT_TRUE(scene.get_children(entities[3]).empty());
+    EXPECT_FALSE(scene.find_entity(entities[1].get_id()));
+    EXPECT_EQ(scene.get_root_entities(), std::vector<Entity>{entities[3]});
+}
+
 TEST(SceneTest, FindAndEnumerateEntitiesById) {
     Scene scene;
     Entity first = scene.create_entity("First");
@@ -130,6 +199,51 @@ TEST(SceneTest, FindAndEnumerateEntitiesById) {
     EXPECT_TRUE(scene.is_valid(second));
 }
 
+TEST(SceneTest, LookupIndicesFollowCreateAndDestroy) {
+    Scene scene;
+    Entity parent = scene.create_entity("Parent");
+    Entity child = scene.create_entity("Child");
+    Entity survivor = scene.create_entity("Survivor");
+    ASSERT_TRUE(scene.set_parent(child, parent));
+
+    const EntityId parent_id = parent.get_id();
+    const EntityId child_id = child.get_id();
+    const EntityUuid parent_uuid = parent.get_uuid();
+    const EntityUuid child_uuid = child.get_uuid();
+    EXPECT_EQ(scene.find_entity(child_id), child);
+    EXPECT_EQ(scene.find_entity(child_uuid), child);
+
+    scene.destroy_entity(parent);
+
+    EXPECT_FALSE(scene.find_entity(parent_id));
+    EXPECT_FALSE(scene.find_entity(child_id));
+    EXPECT_FALSE(scene.find_entity(parent_uuid));
+    EXPECT_FALSE(scene.find_entity(child_uuid));
+    EXPECT_EQ(scene.find_entity(survivor.get_id()), survivor);
+    EXPECT_EQ(scene.find_entity(survivor.get_uuid()), survivor);
+
+    // A destroyed UUID can be reused, and the recycled entt handle must not
+    // resurrect the old id.
+    Entity recreated = scene.create_entity_with_uuid(parent_uuid, "Recreated");
+    ASSERT_TRUE(recreated);
+    EXPECT_EQ(scene.find_entity(parent_uuid), recreated);
+    EXPECT_NE(recreated.get_id(), parent_id);
+    EXPECT_FALSE(scene.find_entity(parent_id));
+}
+
+TEST(SceneTest, RemovingIdentityComponentsDropsLookupEntries) {
+    Scene scene;
+    Entity entity = scene.create_entity("Entity");
+    const EntityId id = entity.get_id();
+    const EntityUuid uuid = entity.get_uuid();
+
+    entity.remove_component<IdComponent>();
+    entity.remove_component<UuidComponent>();
+
+    EXPECT_FALSE(scene.find_entity(id));
+    EXPECT_FALSE(scene.find_entity(uuid));
+}
+
 TEST(SceneTest, EstablishesAndClearsParentChildRelationships) {
     Scene scene;
     Entity root = scene.create_entity("Root");
@@ -173,18 +287,72 @@ TEST(SceneTest, RejectsInvalidAndCyclicParenting) {
     EXPECT_EQ(scene.get_parent(grandchild), child);
 }
 
+TEST(SceneTest, ReparentingKeepsStableSiblingOrder) {
+    Scene scene;
+    Entity first_parent = scene.create_entity("First Parent");
+    Entity second_parent = scene.create_entity("Second Parent");
+    Entity first = scene.create_entity("First");
+    Entity second = scene.create_entity("Second");
+    Entity third = scene.create_entity("Third");
+
+    ASSERT_TRUE(scene.set_parent(third, first_parent));
+    ASSERT_TRUE(scene.set_parent(first, first_parent));
+    ASSERT_TRUE(scene.set_parent(second, first_parent));
+    EXPECT_EQ(scene.get_children(first_parent),
+              (std::vector<Entity>{third, first, second}));
+
+    ASSERT_TRUE(scene.set_parent(first, second_parent));
+    EXPECT_EQ(scene.get_children(first_parent), (std::vector<Entity>{third, second}));
+    EXPECT_EQ(scene.get_children(second_parent), (std::vector<Entity>{first}));
+
+    ASSERT_TRUE(scene.set_parent(first, first_parent));
+    EXPECT_EQ(scene.get_children(first_parent),
+              (std::vector<Entity>{third, second, first}));
+    EXPECT_TRUE(scene.get_children(second_parent).empty());
+    EXPECT_EQ(scene.get_root_entities(),
+              (std::vector<Entity>{first_parent, second_parent}));
+
+    ASSERT_TRUE(scene.clear_parent(second));
+    EXPECT_EQ(scene.get_children(first_parent), (std::vector<Entity>{third, first}));
+    EXPECT_EQ(scene.get_root_entities(),
+              (std::vector<Entity>{first_parent, second_parent, second}));
+}
+
+TEST(SceneTest, DirectParentEditsAreReflectedInHierarchy) {
+    Scene scene;
+    Entity parent = scene.create_entity("Parent");
+    Entity child = scene.create_entity("Child");
+
+    child.patch_component<RelationshipComponent>([&](RelationshipComponent& relationship) {
+        relationship.parent = parent.get_id();
+    });
+    EXPECT_EQ(scene.get_parent(child), parent);
+    EXPECT_EQ(scene.get_children(parent), (std::vector<Entity>{child}));
+    EXPECT_EQ(scene.get_root_entities(), (std::vector<Entity>{parent}));
+
+    child.patch_component<RelationshipComponent>([](RelationshipComponent& relationship) {
+        relationship.parent = INVALID_ENTITY_ID;
+    });
+    EXPECT_FALSE(scene.get_parent(child));
+    EXPECT_TRUE(scene.get_children(parent).empty());
+}
+
 TEST(SceneTest, ReparentKeepsLocalTransformAndUpdatesWorldMatrix) {
     Scene scene;
     Entity first_parent = scene.create_entity("First Parent");
     Entity second_parent = scene.create_entity("Second Parent");
     Entity child = scene.create_entity("Child");
 
-    first_parent.get_component<TransformComponent>().translation =
-        Math::Vec3(1.0f, 0.0f, 0.0f);
-    second_parent.get_component<TransformComponent>().translation =
-        Math::Vec3(5.0f, 0.0f, 0.0f);
-    auto& child_transform = child.get_component<TransformComponent>();
-    child_transform.translation = Math::Vec3(0.0f, 2.0f, 0.0f);
+    first_parent.patch_component<TransformComponent>([](TransformComponent& transform) {
+        transform.translation = Math::Vec3(1.0f, 0.0f, 0.0f);
+    });
+    second_parent.patch_component<TransformComponent>([](TransformComponent& transform) {
+        transform.translation = Math::Vec3(5.0f, 0.0f, 0.0f);
+    });
+    const auto& child_transform = child.patch_component<TransformComponent>(
+        [](TransformComponent& transform) {
+            transform.translation = Math::Vec3(0.0f, 2.0f, 0.0f);
+        });
     const TransformComponent local_before_reparent = child_transform;
 
     ASSERT_TRUE(scene.set_parent(child, first_parent));
@@ -193,7 +361,9 @@ TEST(SceneTest, ReparentKeepsLocalTransformAndUpdatesWorldMatrix) {
         first_parent.get_component<TransformComponent>().to_matrix()
             * child_transform.to_matrix()));
 
-    first_parent.get_component<TransformComponent>().translation.x = 3.0f;
+    first_parent.patch_component<TransformComponent>([](TransformComponent& transform) {
+        transform.translation.x = 3.0f;
+    });
     EXPECT_TRUE(TestUtils::Mat4Equal(
         scene.get_world_matrix(child),
         first_parent.get_component<TransformComponent>().to_matrix()
@@ -212,6 +382,181 @@ TEST(SceneTest, ReparentKeepsLocalTransformAndUpdatesWorldMatrix) {
         scene.get_world_matrix(child), child_transform.to_matrix()));
 }
 
+TEST(SceneTest, UpdateWorldTransformsRecomposesOnlyChangedSubtrees) {
+    Scene scene;
+    Entity moving_parent = scene.create_entity("Moving Parent");
+    Entity moving_child = scene.create_entity("Moving Child");
+    Entity static_entity = scene.create_entity("Static");
+    ASSERT_TRUE(scene.set_parent(moving_child, moving_parent));
+    moving_child.patch_component<TransformComponent>([](TransformComponent& transform) {
+        transform.translation = Math::Vec3(0.0f, 1.0f, 0.0f);
+    });
+    scene.update_world_transforms();
+
+    // A sentinel written behind the scene's back survives as long as the
+    // entity is not marked dirty.
+    const Math::Mat4 sentinel(2.0f);
+    static_entity.get_component<WorldTransformComponent>().world_matrix = sentinel;
+    moving_parent.patch_component<TransformComponent>([](TransformComponent& transform) {
+        transform.translation = Math::Vec3(4.0f, 0.0f, 0.0f);
+    });
+    scene.update_world_transforms();
+
+    EXPECT_TRUE(TestUtils::Mat4Equal(
+        static_entity.get_component<WorldTransformComponent>().world_matrix, sentinel));
+    EXPECT_TRUE(TestUtils::Mat4Equal(
+        moving_child.get_component<WorldTransformComponent>().world_matrix,
+        Math::translate(Math::Mat4(1.0f), Math::Vec3(4.0f, 1.0f, 0.0f))));
+
+    static_entity.patch_component<TransformComponent>();
+    scene.update_world_transforms();
+    EXPECT_TRUE(TestUtils::IsIdentityMatrix(
+        static_entity.get_component<WorldTransformComponent>().world_matrix));
+}
+
+TEST(SceneTest, OnlyPatchedComponentsAreMarkedDirty) {
+    Scene scene;
+    Entity entity = scene.create_entity("Entity");
+    scene.update_world_transforms();
+
+    const Math::Mat4 sentinel(2.0f);
+    entity.get_component<WorldTransformComponent>().world_matrix = sentinel;
+    static_cast<void>(entity.get_component<TransformComponent>());
+    scene.update_world_transforms();
+    EXPECT_TRUE(TestUtils::Mat4Equal(
+        entity.get_component<WorldTransformComponent>().world_matrix, sentinel));
+
+    entity.patch_component<TransformComponent>([](TransformComponent& transform) {
+        transform.translation = Math::Vec3(0.0f, 0.0f, 2.0f);
+    });
+    EXPECT_TRUE(TestUtils::Mat4Equal(
+        scene.get_world_matrix(entity),
+        Math::translate(Math::Mat4(1.0f), Math::Vec3(0.0f, 0.0f, 2.0f))));
+}
+
+TEST(SceneTest, ParallelTransformUpdateMatchesSerialBitwise) {
+    // 16 roots with a fan-out of 8 give a deepest level large enough to be
+    // split across workers.
+    const auto build = [](Scene& scene) {
+        std::vector<Entity> entities;
+        std::vector<Entity> level;
+        for(int root = 0; root < 16; ++root) {
+            level.push_back(scene.create_entity());
+        }
+        for(int depth = 0; depth < 4; ++depth) {
+            std::vector<Entity> next_level;
+            for(const Entity parent: level) {
+                entities.push_back(parent);
+                if(depth == 3) {
+                    continue;
+                }
+                for(int branch = 0; branch < 8; ++branch) {
+                    Entity child = scene.create_entity();
+                    EXPECT_TRUE(scene.set_parent(child, parent));
+                    next_level.push_back(child);
+                }
+            }
+            level.swap(next_level);
+        }
+        for(std::size_t index = 0; index < entities.size(); ++index) {
+            const auto value = static_cast<float>(index);
+            entities[index].patch_component<TransformComponent>(
+                [&](TransformComponent& transform) {
+                    transform.translation = Math::Vec3(value * 0.01f, 1.0f, -value * 0.02f);
+                    transform.rotation = Math::Vec3(value * 0.3f, value * 0.7f, value * 1.1f);
+                    transform.scale = Math::Vec3(1.0f + value * 0.0001f);
+                });
+        }
+        return entities;
+    };
+
+    Scene serial_scene;
+    Scene parallel_scene;
+    parallel_scene.set_transform_thread_count(4);
+    ASSERT_EQ(serial_scene.get_transform_thread_count(), 1u);
+    ASSERT_EQ(parallel_scene.get_transform_thread_count(), 4u);
+    std::vector<Entity> serial_entities = build(serial_scene);
+    std::vector<Entity> parallel_entities = build(parallel_scene);
+    ASSERT_EQ(serial_entities.size(), parallel_entities.size());
+
+    const auto expect_identical = [&]() {
+        serial_scene.update_world_transforms();
+        parallel_scene.update_world_transforms();
+        for(std::size_t index = 0; index < serial_entities.size(); ++index) {
+            const auto& serial =
+                std::as_const(serial_entities[index]).get_component<WorldTransformComponent>();
+            const auto& parallel =
+                std::as_const(parallel_entities[index]).get_component<WorldTransformComponent>();
+            ASSERT_EQ(std::memcmp(&serial.world_matrix, &parallel.world_matrix,
+                                  sizeof(Math::Mat4)), 0) << "entity " << index;
+            ASSERT_EQ(std::memcmp(&serial.camera_world_matrix, &parallel.camera_world_matrix,
+                                  sizeof(Math::Mat4)), 0) << "entity " << index;
+        }
+    };
+
+    expect_identical();
+
+    // Moving a single root exercises the partially dirty path.
+    const Math::Mat4 moved_before =
+        std::as_const(serial_entities[3]).get_component<WorldTransformComponent>().world_matrix;
+    serial_entities[3].patch_component<TransformComponent>([](TransformComponent& transform) {
+        transform.translation.x += 2.5f;
+    });
+    parallel_entities[3].patch_component<TransformComponent>([](TransformComponent& transform) {
+        transform.translation.x += 2.5f;
+    });
+    expect_identical();
+    EXPECT_FALSE(TestUtils::Mat4Equal(
+        std::as_const(serial_entities[3]).get_component<WorldTransformComponent>().world_matrix,
+        moved_before));
+}
+
+TEST(SceneTest, RemovingTransformResetsWorldMatrixToParent) {
+    Scene scene;
+    Entity parent = scene.create_entity("Parent");
+    Entity child = scene.create_entity("Child");
+    ASSERT_TRUE(scene.set_parent(child, parent));
+    parent.patch_component<TransformComponent>([](TransformComponent& transform) {
+        transform.translation = Math::Vec3(1.0f, 2.0f, 3.0f);
+    });
+    child.patch_component<TransformComponent>([](TransformComponent& transform) {
+        transform.scale = Math::Vec3(5.0f);
+    });
+    scene.update_world_transforms();
+
+    child.remove_component<TransformComponent>();
+
+    EXPECT_TRUE(TestUtils::Mat4Equal(
+        scene.get_world_matrix(child),
+        parent.get_component<TransformComponent>().to_matrix()));
+}
+
+TEST(SceneTest, DirectlyEditedParentCycleFallsBackToRoot) {
+    Scene scene;
+    Entity first = scene.create_entity("First");
+    Entity second = scene.create_entity("Second");
+    first.patch_component<TransformComponent>([](TransformComponent& transform) {
+        transform.translation = Math::Vec3(1.0f, 0.0f, 0.0f);
+    });
+    second.patch_component<TransformComponent>([](TransformComponent& transform) {
+        transform.translation = Math::Vec3(0.0f, 1.0f, 0.0f);
+    });
+    ASSERT_TRUE(scene.set_parent(second, first));
+
+    first.patch_component<RelationshipComponent>([&](RelationshipComponent& relationship) {
+        relationship.parent = second.get_id();
+    });
+    scene.update_world_transforms();
+
+    const Math::Mat4& first_world = scene.get_world_matrix(first);
+    const Math::Mat4& second_world = scene.get_world_matrix(second);
+    const bool first_is_root = TestUtils::Mat4Equal(
+        first_world, first.get_component<TransformComponent>().to_matrix());
+    const bool second_is_root = TestUtils::Mat4Equal(
+        second_world, second.get_component<TransformComponent>().to_matrix());
+    EXPECT_NE(first_is_root, second_is_root);
+}
+
 TEST(SceneTest, DestroyingParentDestroysEntireSubtree) {
     Scene scene;
     Entity parent = scene.create_entity("Parent");
@@ -231,6 +576,39 @@ TEST(SceneTest, DestroyingParentDestroysEntireSubtree) {
     EXPECT_EQ(scene.entity_count(), 1u);
 }
 
+TEST(SceneTest, DestroyingChildUnlinksItFromSiblings) {
+    Scene scene;
+    Entity parent = scene.create_entity("Parent");
+    Entity first = scene.create_entity("First");
+    Entity middle = scene.create_entity("Middle");
+    Entity last = scene.create_entity("Last");
+    Entity nested = scene.create_entity("Nested");
+
+    ASSERT_TRUE(scene.set_parent(first, parent));
+    ASSERT_TRUE(scene.set_parent(middle, parent));
+    ASSERT_TRUE(scene.set_parent(last, parent));
+    ASSERT_TRUE(scene.set_parent(nested, middle));
+
+    scene.destroy_entity(middle);
+
+    EXPECT_FALSE(nested);
+    EXPECT_EQ(scene.get_children(parent), (std::vector<Entity>{first, last}));
+    EXPECT_EQ(scene.entity_count(), 3u);
+}
+
+TEST(SceneTest, RemovingRelationshipPromotesChildrenToRoots) {
+    Scene scene;
+    Entity parent = scene.create_entity("Parent");
+    Entity child = scene.create_entity("Child");
+    ASSERT_TRUE(scene.set_parent(child, parent));
+
+    parent.remove_component<RelationshipComponent>();
+
+    EXPECT_FALSE(scene.get_parent(child));
+    EXPECT_EQ(child.get_component<RelationshipComponent>().parent, INVALID_ENTITY_ID);
+    EXPECT_EQ(scene.get_root_entities(), (std::vector<Entity>{child}));
+}
+
 TEST(SceneTest, EntityManagesCustomComponents) {
     struct HealthComponent {
         explicit HealthComponent(const int initial_value) : value(initial_value) {}
@@ -115,14 +115,18 @@ namespace Comet::Tests {
         ASSERT_TRUE(root);
         ASSERT_TRUE(child);
 
-        auto& root_transform = root.get_component<TransformComponent>();
-        root_transform.translation = Math::Vec3(3.0f, 4.0f, 5.0f);
-        root_transform.rotation = Math::Vec3(10.0f, 20.0f, 30.0f);
-        root_transform.scale = Math::Vec3(2.0f);
-        auto& child_transform = child.get_component<TransformComponent>();
-        child_transform.translation = Math::Vec3(1.0f, 2.0f, 3.0f);
-        child_transform.rotation = Math::Vec3(-15.0f, 45.0f, 5.0f);
-        child_transform.scale = Math::Vec3(0.5f, 1.5f, 2.0f);
+        const auto& root_transform = root.patch_component<TransformComponent>(
+            [](TransformComponent& transform) {
+                transform.translation = Math::Vec3(3.0f, 4.0f, 5.0f);
+                transform.rotation = Math::Vec3(10.0f, 20.0f, 30.0f);
+                transform.scale = Math::Vec3(2.0f);
+            });
+        const auto& child_transform = child.patch_component<TransformComponent>(
+            [](TransformComponent& transform) {
+                transform.translation = Math::Vec3(1.0f, 2.0f, 3.0f);
+                transform.rotation = Math::Vec3(-15.0f, 45.0f, 5.0f);
+                transform.scale = Math::Vec3(0.5f, 1.5f, 2.0f);
+            });
         child.add_component<MeshRendererComponent>(
             AssetHandle(101), AssetHandle(202));
         auto& camera = root.add_component<CameraComponent>();
@@ -238,6 +242,23 @@ namespace Comet::Tests {
         EXPECT_EQ(entity.get_component<NameComponent>().name, "Saved");
     }
 
+    TEST(SceneSerializerTest, RoundTripsEmptyEntityName) {
+        const EntityUuid entity_uuid = uuid(
+            "00000000-0000-4000-8000-000000000041");
+        Scene scene;
+        ASSERT_TRUE(scene.create_entity_with_uuid(entity_uuid, ""));
+        const TemporarySceneFile file;
+        const SceneSerializer serializer = make_scene_serializer();
+
+        serializer.save(scene, file.path());
+        std::unique_ptr<Scene> loaded = serializer.load(file.path());
+
+        ASSERT_NE(loaded, nullptr);
+        Entity entity = loaded->find_entity(entity_uuid);
+        ASSERT_TRUE(entity);
+        EXPECT_EQ(entity.get_component<NameComponent>().name, "");
+    }
+
     TEST(SceneSerializerTest, CreatesMissingParentDirectoriesWhenSaving) {
         Scene scene;
         ASSERT_TRUE(scene.create_entity("Saved"));
@@ -332,8 +353,9 @@ entities:
 
         Scene scene;
         Entity entity = scene.create_entity("Invalid");
-        entity.get_component<TransformComponent>().translation.x =
-            std::numeric_limits<float>::infinity();
+        entity.patch_component<TransformComponent>([](TransformComponent& transform) {
+            transform.translation.x = std::numeric_limits<float>::infinity();
+        });
         EXPECT_THROW(
             static_cast<void>(make_scene_serializer().serialize(scene)),
             std::runtime_error);
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "scene/transform_hierarchy.h"
+#include "../test_utils.h"
+
+#include <vector>
+
+namespace Comet::Tests {
+
+namespace {
+    TransformComponent MakeTranslation(const float x, const float y, const float z) {
+        TransformComponent transform;
+        transform.translation = Math::Vec3(x, y, z);
+        return transform;
+    }
+}
+
+TEST(TransformHierarchyTest, TracksDepthLevelsInPushOrder) {
+    entt::registry registry;
+    TransformHierarchy hierarchy;
+
+    const std::uint32_t root_a = hierarchy.push(
+        registry.create(), TransformHierarchy::INVALID_INDEX, nullptr);
+    const std::uint32_t root_b = hierarchy.push(
+        registry.create(), TransformHierarchy::INVALID_INDEX, nullptr);
+    const std::uint32_t child = hierarchy.push(registry.create(), root_a, nullptr);
+    hierarchy.push(registry.create(), root_b, nullptr);
+    hierarchy.push(registry.create(), child, nullptr);
+
+    ASSERT_EQ(hierarchy.size(), 5u);
+    ASSERT_EQ(hierarchy.level_count(), 3u);
+    EXPECT_EQ(hierarchy.level_range(0), std::make_pair(0u, 2u));
+    EXPECT_EQ(hierarchy.level_range(1), std::make_pair(2u, 4u));
+    EXPECT_EQ(hierarchy.level_range(2), std::make_pair(4u, 5u));
+    EXPECT_EQ(hierarchy.parent(child), root_a);
+}
+
+TEST(TransformHierarchyTest, UpdateRecomposesDirtyEntriesAndDescendants) {
+    entt::registry registry;
+    TransformHierarchy hierarchy;
+    const entt::entity root_handle = registry.create();
+    const entt::entity child_handle = registry.create();
+    const entt::entity other_handle = registry.create();
+
+    const TransformComponent root_local = MakeTranslation(1.0f, 0.0f, 0.0f);
+    const TransformComponent child_local = MakeTranslation(0.0f, 2.0f, 0.0f);
+    const std::uint32_t root = hierarchy.push(
+        root_handle, TransformHierarchy::INVALID_INDEX, &root_local);
+    const std::uint32_t other = hierarchy.push(
+        other_handle, TransformHierarchy::INVALID_INDEX, nullptr);
+    const std::uint32_t child = hierarchy.push(child_handle, root, &child_local);
+
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.updated_indices().size(), 3u);
+    EXPECT_EQ(hierarchy.index_of(child_handle), child);
+    EXPECT_TRUE(TestUtils::IsIdentityMatrix(hierarchy.world_matrix(other)));
+    EXPECT_TRUE(TestUtils::Mat4Equal(
+        hierarchy.world_matrix(child),
+        Math::translate(Math::Mat4(1.0f), Math::Vec3(1.0f, 2.0f, 0.0f))));
+
+    const TransformComponent moved_root = MakeTranslation(5.0f, 0.0f, 0.0f);
+    hierarchy.set_local(root, &moved_root);
+    hierarchy.update();
+    EXPECT_EQ(hierarchy.updated_indices(), (std::vector<std::uint32_t>{root, child}));
+    EXPECT_TRUE(TestUtils::Mat4Equal(
+        hierarchy.world_matrix(child),
+        Math::translate(Math::Mat4(1.0f), Math::Vec3(5.0f, 2.0f, 0.0f))));
+
+    hierarchy.update();
+    EXPECT_TRUE(hierarchy.updated_indices().empty());
+}
+
+TEST(TransformHierarchyTest, ClearForgetsEntities) {
+    entt::registry registry;
+    TransformHierarchy hierarchy;
+    const entt::entity handle = registry.create();
+    hierarchy.push(handle, TransformHierarchy::INVALID_INDEX, nullptr);
+
+    hierarchy.clear();
+
+    EXPECT_EQ(hierarchy.size(), 0u);
+    EXPECT_EQ(hierarchy.level_count(), 0u);
+    EXPECT_EQ(hierarchy.index_of(handle), TransformHierarchy::INVALID_INDEX);
+}
+
+} // namespace Comet::Tests